@@ -21,9 +21,15 @@
 #include "Proton/Scene/EntityComponent.h"
 #include "Proton/Scene/SceneManager.h"
 #include "Proton/Scene/PrefabManager.h"
+#include "Proton/Scene/SpatialIndex.h"
+#include "Proton/Scene/SystemScheduler.h"
+#include "Proton/Scene/WorldStreamer.h"
 
 #include "Proton/Scripting/EntityScript.h"
 
+#include "Proton/UI/UICanvas.h"
+#include "Proton/UI/UIFont.h"
+
 #ifdef PT_EDITOR
 #include <imgui/imgui.h>
 #endif
@@ -1,5 +1,6 @@
 #include "ptpch.h"
 #include "Proton/Assets/AssetManager.h"
+#include "Proton/Core/Application.h"
 #include "Proton/Utils/Utils.h"
 
 namespace proton {
@@ -17,7 +18,19 @@ namespace proton {
 
 	Shared<Texture> AssetManager::LoadTexture(const std::string& filepath)
 	{
-		auto texture = MakeShared<Texture>("content/textures/" + filepath);
+		if (!Application::Get().GetJobSystem().IsMainThread())
+		{
+			PT_CORE_ERROR("Texture '{}' not loaded, OpenGL objects are created on the main thread only!", filepath);
+			return nullptr;
+		}
+
+		Unique<TextureImage> image = DecodeTexture(filepath);
+		return LoadTexture(filepath, std::move(*image));
+	}
+
+	Shared<Texture> AssetManager::LoadTexture(const std::string& filepath, TextureImage&& image)
+	{
+		auto texture = MakeShared<Texture>(std::move(image));
 		if (!texture->IsLoaded()) 
 		{
 			PT_CORE_ERROR("Couldn't load texture '{}'", filepath);
@@ -25,10 +38,16 @@ namespace proton {
 		}
 
 		PT_CORE_INFO("file='{}'", filepath);
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		s_Instance->m_Textures[filepath] = texture;
 		return texture;
 	}
 
+	Unique<TextureImage> AssetManager::DecodeTexture(const std::string& filepath)
+	{
+		return MakeUnique<TextureImage>("content/textures/" + filepath);
+	}
+
 	Shared<Spritesheet> AssetManager::LoadSpritesheet(const std::string& filepath)
 	{
 		auto texture = GetTexture(filepath);
@@ -49,16 +68,19 @@ namespace proton {
 
 	bool AssetManager::IsTextureLoaded(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		return s_Instance->m_Textures.find(filepath) != s_Instance->m_Textures.end();
 	}
 
 	bool AssetManager::IsSpritesheetLoaded(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		return s_Instance->m_Spritesheets.find(filepath) != s_Instance->m_Spritesheets.end();
 	}
 
 	Shared<Texture> AssetManager::GetTexture(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		if (!IsTextureLoaded(filepath))
 		{
 			if (LoadTexture(filepath))
@@ -73,6 +95,7 @@ namespace proton {
 
 	Shared<Spritesheet> AssetManager::GetSpritesheet(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		if (!IsSpritesheetLoaded(filepath))
 		{
 			auto spritesheet = LoadSpritesheet(filepath);
@@ -89,6 +112,7 @@ namespace proton {
 
 	bool AssetManager::UnloadTexture(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		if (!IsTextureLoaded(filepath))
 			return false;
 
@@ -98,6 +122,7 @@ namespace proton {
 
 	bool AssetManager::UnloadSpritesheet(const std::string& filepath)
 	{
+		std::lock_guard<std::recursive_mutex> lock(s_Instance->m_Mutex);
 		if (!IsSpritesheetLoaded(filepath))
 			return false;
 
@@ -1,5 +1,6 @@
 #include "Proton/Graphics/Sprite.h"
 
+#include <mutex>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
 
@@ -13,8 +14,15 @@ namespace proton {
 		static void Init();
 
 		// Load texture and store using filepath as key.
+		// Main thread only, other threads decode the image and leave the upload to the main thread.
 		static Shared<Texture> LoadTexture(const std::string& filepath);
 
+		// Upload an image decoded by DecodeTexture and store using filepath as key.
+		static Shared<Texture> LoadTexture(const std::string& filepath, TextureImage&& image);
+
+		// Read and decode a texture image file, safe to call from any thread.
+		static Unique<TextureImage> DecodeTexture(const std::string& filepath);
+
 		// Get OpenGL Texture object pointer.
 		static Shared<Texture> GetTexture(const std::string& filepath);
 
@@ -43,6 +51,8 @@ namespace proton {
 	private:
 		static AssetManager* s_Instance;
 
+		// Textures and spritesheets are looked up by scenes deserialized on worker threads (SceneManager::LoadAsync)
+		std::recursive_mutex m_Mutex;
 		std::unordered_map<std::string, Shared<Texture>> m_Textures;
 		std::unordered_map<std::string, Shared<Spritesheet>> m_Spritesheets;
 
@@ -2,6 +2,8 @@
 #include "Proton/Assets/SceneSerializer.h"
 #include "Proton/Scene/EntityComponent.h"
 #include "Proton/Scene/Scene.h"
+#include "Proton/Scene/TransformHierarchy.h"
+#include "Proton/Scene/WorldStreamer.h"
 #include "Proton/Assets/AssetManager.h"
 #include "Proton/Scripting/EntityScript.h"
 #include "Proton/Scripting/ScriptFactory.h"
@@ -9,6 +11,7 @@
 #include "Proton/Utils/Utils.h"
 
 #include <fstream>
+#include <filesystem>
 
 #define PROTON_SERIALIZER_INDENT_JSON 0
 
@@ -26,6 +29,33 @@ namespace proton {
 		return std::round((double)f * 100000) / 100000;
 	}
 
+	// Entities and their components in serialized hierarchies, stored with the scene to reserve storage on load
+	static void CountComponents(const json& entities, std::map<std::string, uint32_t>& counts)
+	{
+		for (const json& entity : entities)
+		{
+			counts["Entities"]++;
+			for (auto it = entity.begin(); it != entity.end(); it++)
+			{
+				if (it.key() != "UUID" && it.key() != "Tag" && it.key() != "Transform" && it.key() != "Entities")
+					counts[it.key()]++;
+			}
+
+			if (entity.contains("Entities"))
+				CountComponents(entity["Entities"], counts);
+		}
+	}
+
+	template<typename TComponent>
+	static void ReserveComponents(entt::registry& registry, const json& counts, const char* name)
+	{
+		if (!counts.contains(name))
+			return;
+
+		auto& storage = registry.storage<TComponent>();
+		storage.reserve(storage.size() + (size_t)counts[name]);
+	}
+
 	SceneSerializer::SceneSerializer(Scene* scene)
 		: m_Scene(scene)
 	{
@@ -48,6 +78,22 @@ namespace proton {
 			{ "ScreenClearColor", { c.r, c.g, c.b, c.a } }
 		};
 
+		if (m_Scene->m_EnableLighting)
+		{
+			const auto& a = m_Scene->m_AmbientLightColor;
+			jsonObj["EnableLighting"] = true;
+			jsonObj["AmbientLightColor"] = { a.r, a.g, a.b, a.a };
+		}
+
+		if (!m_Scene->m_EnableSpriteLOD || m_Scene->m_MinSpritePixelSize != 1.0f)
+		{
+			jsonObj["SpriteLOD"] = m_Scene->m_EnableSpriteLOD;
+			jsonObj["MinSpritePixelSize"] = m_Scene->m_MinSpritePixelSize;
+		}
+
+		if (m_Scene->m_EnableSpriteMeshes)
+			jsonObj["SpriteMeshes"] = true;
+
 		Entity primaryCameraEntity = m_Scene->GetPrimaryCameraEntity();
 		if (primaryCameraEntity.IsValid())
 		{
@@ -55,14 +101,66 @@ namespace proton {
 			jsonObj["PrimaryCameraEntity"] = id;
 		}
 
+		// Unloaded cells would be lost, streamed roots are written into the cell containing them
+		WorldStreamer* streamer = m_Scene->m_WorldStreamer.get();
+		std::map<std::pair<int, int>, json> cells;
+		if (streamer)
+			streamer->LoadAllCells();
+
 		m_Scene->m_Registry.view<IDComponent>().each([&](entt::entity id, auto& component)
 			{
 				Entity entity{ id, m_Scene };
 				auto& relationship = entity.GetComponent<RelationshipComponent>();
-				if (relationship.Parent == entt::null)
+				if (relationship.Parent != entt::null)
+					return;
+
+				if (streamer && WorldStreamer::IsStreamable(entity))
+				{
+					glm::ivec2 cell = streamer->GetCell(glm::vec2(entity.GetTransform().LocalPosition));
+					cells[{ cell.x, cell.y }]["Entities"].push_back(SerializeEntity(entity));
+					m_Scene->m_Registry.emplace_or_replace<StreamingCellComponent>(id, cell);
+				}
+				else
 					jsonObj["Entities"].push_back(SerializeEntity(entity));
 			});
 
+		if (jsonObj.contains("Entities"))
+		{
+			std::map<std::string, uint32_t> counts;
+			CountComponents(jsonObj["Entities"], counts);
+			jsonObj["ComponentCounts"] = counts;
+		}
+
+		if (streamer)
+		{
+			std::string cellsDirectory = WorldStreamer::GetCellsDirectory(filepath);
+			std::filesystem::remove_all(cellsDirectory);
+			std::filesystem::create_directories(cellsDirectory);
+
+			jsonObj["Streaming"] = {
+				{ "CellSize",     streamer->GetCellSize() },
+				{ "LoadRadius",   streamer->GetLoadRadius() },
+				{ "UnloadRadius", streamer->GetUnloadRadius() },
+				{ "FrameBudget",  streamer->GetFrameBudget() },
+				{ "Cells",        json::array() }
+			};
+
+			for (auto& [coord, cellObj] : cells)
+			{
+				jsonObj["Streaming"]["Cells"].push_back({ coord.first, coord.second });
+				streamer->AddCell({ coord.first, coord.second });
+
+				std::ofstream cellOut(cellsDirectory + WorldStreamer::GetCellFilename({ coord.first, coord.second }));
+			#if PROTON_SERIALIZER_INDENT_JSON
+				cellOut << cellObj.dump(4);
+			#else
+				cellOut << cellObj;
+			#endif
+			}
+			streamer->SetCellsDirectory(cellsDirectory);
+			streamer->ResetCells();
+		}
+
 		std::ofstream out(filepath);
 	#if PROTON_SERIALIZER_INDENT_JSON
 		out << jsonObj.dump(4);
@@ -80,30 +178,113 @@ namespace proton {
 	bool SceneSerializer::Deserialize(const std::string& filepath)
 	{
 		std::string jsonData = Utils::ReadFile(filepath);
-		if (jsonData.size())
+		if (!jsonData.size())
+			return false;
+
+		json jsonObj = json::parse(jsonData);
+		Deserialize(jsonObj, filepath);
+
+	#ifdef PT_EDITOR
+		// The whole world is edited, cells out of range are unloaded once playing
+		if (m_Scene->m_WorldStreamer)
+			m_Scene->m_WorldStreamer->LoadAllCells();
+	#endif
+		return true;
+	}
+
+	void SceneSerializer::Deserialize(json& jsonObj, const std::string& filepath)
+	{
+		m_Scene->m_SceneName = jsonObj["SceneName"];
+		m_Scene->m_EnablePhysics = jsonObj["EnablePhysics"];
+		m_Scene->m_PhysicsWorld->m_Gravity = jsonObj["GravityForce"];
+		m_Scene->m_PhysicsWorld->m_PhysicsVelocityIterations = jsonObj["VelocityIterations"];
+		m_Scene->m_PhysicsWorld->m_PhysicsPositionIterations = jsonObj["PositionIterations"];
+		json& c = jsonObj["ScreenClearColor"];
+		m_Scene->m_ClearColor = { c[0], c[1], c[2], c[3] };
+
+		if (jsonObj.contains("EnableLighting"))
 		{
-			json jsonObj = json::parse(jsonData);
-			m_Scene->m_SceneName = jsonObj["SceneName"];
-			m_Scene->m_EnablePhysics = jsonObj["EnablePhysics"];
-			m_Scene->m_PhysicsWorld->m_Gravity = jsonObj["GravityForce"];
-			m_Scene->m_PhysicsWorld->m_PhysicsVelocityIterations = jsonObj["VelocityIterations"];
-			m_Scene->m_PhysicsWorld->m_PhysicsPositionIterations = jsonObj["PositionIterations"];
-			json& c = jsonObj["ScreenClearColor"];
-			m_Scene->m_ClearColor = { c[0], c[1], c[2], c[3] };
+			json& a = jsonObj["AmbientLightColor"];
+			m_Scene->m_EnableLighting = jsonObj["EnableLighting"];
+			m_Scene->m_AmbientLightColor = { a[0], a[1], a[2], a[3] };
+		}
 
-			json& entities = jsonObj["Entities"];
-			for (auto it = entities.rbegin(); it != entities.rend(); it++)
-				DeserializeEntity(*it);
+		if (jsonObj.contains("SpriteLOD"))
+		{
+			m_Scene->m_EnableSpriteLOD = jsonObj["SpriteLOD"];
+			m_Scene->m_MinSpritePixelSize = jsonObj["MinSpritePixelSize"];
+		}
 
-			if (jsonObj.contains("PrimaryCameraEntity"))
-			{
-				UUID id{ jsonObj["PrimaryCameraEntity"] };
-				m_Scene->SetPrimaryCameraEntity(m_Scene->FindByID(id));
-			}
-			m_Scene->CalculateWorldPositions(false);
-			return true;
+		if (jsonObj.contains("SpriteMeshes"))
+			m_Scene->m_EnableSpriteMeshes = jsonObj["SpriteMeshes"];
+
+		if (jsonObj.contains("ComponentCounts"))
+			ReserveStorage(jsonObj["ComponentCounts"]);
+
+		// All entities of the scene are created at once, their components are deserialized in the same order
+		json& entities = jsonObj["Entities"];
+		m_CreatedNames.clear();
+		m_CreatedIDs.clear();
+		for (auto it = entities.rbegin(); it != entities.rend(); it++)
+			CollectEntities(*it, true);
+		CreateCollectedEntities();
+
+		const entt::entity* handle = m_CreatedHandles.data();
+		for (auto it = entities.rbegin(); it != entities.rend(); it++)
+			DeserializeEntityComponents(*it, handle);
+
+		if (jsonObj.contains("Streaming"))
+		{
+			json& streaming = jsonObj["Streaming"];
+			m_Scene->m_WorldStreamer = MakeUnique<WorldStreamer>(m_Scene, streaming["CellSize"]);
+			WorldStreamer& streamer = *m_Scene->m_WorldStreamer;
+			streamer.SetLoadRadius(streaming["LoadRadius"]);
+			streamer.SetUnloadRadius(streaming["UnloadRadius"]);
+			streamer.SetFrameBudget(streaming["FrameBudget"]);
+			streamer.SetCellsDirectory(WorldStreamer::GetCellsDirectory(filepath));
+			for (auto& cell : streaming["Cells"])
+				streamer.AddCell({ cell[0], cell[1] });
+		}
+
+		if (jsonObj.contains("PrimaryCameraEntity"))
+		{
+			UUID id{ jsonObj["PrimaryCameraEntity"] };
+			m_Scene->SetPrimaryCameraEntity(m_Scene->FindByID(id));
+		}
+		m_Scene->m_TransformHierarchy->Update(false);
+	}
+
+	void SceneSerializer::ReserveStorage(const json& counts)
+	{
+		PROFILE_FUNCTION();
+
+		// Identity components are inserted in bulk by Scene::CreateEntities, only optional components are reserved
+		entt::registry& registry = m_Scene->m_Registry;
+		ReserveComponents<SpriteComponent>(registry, counts, "Sprite");
+		ReserveComponents<ResizableSpriteComponent>(registry, counts, "ResizableSprite");
+		ReserveComponents<CircleRendererComponent>(registry, counts, "CircleRenderer");
+		ReserveComponents<PointLight2DComponent>(registry, counts, "PointLight2D");
+		ReserveComponents<CameraComponent>(registry, counts, "Camera");
+		ReserveComponents<BoxColliderComponent>(registry, counts, "BoxCollider");
+		ReserveComponents<CircleColliderComponent>(registry, counts, "CircleCollider");
+		ReserveComponents<RigidbodyComponent>(registry, counts, "Rigidbody");
+		ReserveComponents<ScriptComponent>(registry, counts, "Scripts");
+	}
+
+	void SceneSerializer::GetTextureDependencies(const json& jsonObj, std::unordered_set<std::string>& outTextures)
+	{
+		if (!jsonObj.contains("Entities"))
+			return;
+
+		// Child entities are nested in their parent
+		for (const json& entity : jsonObj["Entities"])
+		{
+			if (entity.contains("Sprite") && entity["Sprite"].contains("Texture"))
+				outTextures.insert(entity["Sprite"]["Texture"].get<std::string>());
+			if (entity.contains("ResizableSprite") && entity["ResizableSprite"].contains("Spritesheet"))
+				outTextures.insert(entity["ResizableSprite"]["Spritesheet"].get<std::string>());
+			GetTextureDependencies(entity, outTextures);
 		}
-		return false;
 	}
 
 	// *****************************************
@@ -193,6 +374,19 @@ namespace proton {
 			};
 		}
 
+		// Serialize PointLight2DComponent
+		if (entity.HasComponent<PointLight2DComponent>())
+		{
+			auto& component = entity.GetComponent<PointLight2DComponent>();
+			const auto& col = component.Color;
+
+			jsonObj["PointLight2D"] = {
+				{ "Intensity", component.Intensity },
+				{ "Radius",    component.Radius },
+				{ "Color", { col.r, col.g, col.b } }
+			};
+		}
+
 		// Serialize RigidbodyComponent
 		if (entity.HasComponent<RigidbodyComponent>())
 		{
@@ -335,9 +529,40 @@ namespace proton {
 
 	Entity SceneSerializer::DeserializeEntity(json jsonObj, bool deserializeUUID)
 	{
-		Entity entity = deserializeUUID ? 
-			m_Scene->CreateEntityWithUUID((uint64_t)jsonObj["UUID"], jsonObj["Tag"]) :
-			m_Scene->CreateEntity(jsonObj["Tag"]);
+		m_CreatedNames.clear();
+		m_CreatedIDs.clear();
+		CollectEntities(jsonObj, deserializeUUID);
+		CreateCollectedEntities();
+
+		const entt::entity* handle = m_CreatedHandles.data();
+		return DeserializeEntityComponents(jsonObj, handle);
+	}
+
+	void SceneSerializer::CollectEntities(json& jsonObj, bool deserializeUUID)
+	{
+		m_CreatedNames.push_back(jsonObj["Tag"].get<std::string>());
+		m_CreatedIDs.push_back(deserializeUUID ? UUID((uint64_t)jsonObj["UUID"]) : UUID());
+
+		if (jsonObj.contains("Entities"))
+		{
+			json& entities = jsonObj["Entities"];
+			for (auto it = entities.rbegin(); it != entities.rend(); it++)
+				CollectEntities(*it, deserializeUUID);
+		}
+	}
+
+	void SceneSerializer::CreateCollectedEntities()
+	{
+		uint32_t count = (uint32_t)m_CreatedNames.size();
+		m_CreatedHandles.resize(count);
+		if (count)
+			m_Scene->CreateEntities(count, m_CreatedNames.data(), m_CreatedHandles.data(), m_CreatedIDs.data());
+	}
+
+	Entity SceneSerializer::DeserializeEntityComponents(json& jsonObj, const entt::entity*& handle)
+	{
+		// Entities are visited in the order of CollectEntities
+		Entity entity{ *handle++, m_Scene };
 
 		// Deserialize TransformComponent
 		auto& transform = entity.GetComponent<TransformComponent>();
@@ -415,6 +640,17 @@ namespace proton {
 			component.Color = { c[0], c[1], c[2], c[3] };
 		}
 
+		// Deserialize PointLight2DComponent
+		if (jsonObj.contains("PointLight2D"))
+		{
+			json& jsonData = jsonObj["PointLight2D"];
+			auto& component = entity.AddComponent<PointLight2DComponent>();
+			component.Intensity = jsonData["Intensity"];
+			component.Radius = jsonData["Radius"];
+			auto& c = jsonData["Color"];
+			component.Color = { c[0], c[1], c[2] };
+		}
+
 		// Deserialize CameraComponent
 		if (jsonObj.contains("Camera"))
 		{
@@ -532,7 +768,7 @@ namespace proton {
 		{
 			json& entities = jsonObj["Entities"];
 			for (auto it = entities.rbegin(); it != entities.rend(); it++)
-				entity.AddChildEntity(DeserializeEntity(*it, deserializeUUID), false);
+				entity.AddChildEntity(DeserializeEntityComponents(*it, handle), false);
 		}
 
 		return entity;
@@ -1,5 +1,9 @@
 #pragma once
+#include "Proton/Core/UUID.h"
+
+#include <entt/entt.hpp>
 #include <nlohmann/json.hpp>
+#include <unordered_set>
 
 namespace proton {
 
@@ -18,10 +22,28 @@ namespace proton {
 		json SerializeEntity(Entity entity, bool serializeUUID = true);
 
 		bool Deserialize(const std::string& filepath);
+		// Parsed scene file, streaming cells are not loaded (see Deserialize above for the editor)
+		void Deserialize(json& jsonObj, const std::string& filepath);
 		Entity DeserializeEntity(json jsonObj, bool deserializeUUID = true);
+
+		// Texture filepaths used by the entities of a parsed scene or streaming cell
+		static void GetTextureDependencies(const json& jsonObj, std::unordered_set<std::string>& outTextures);
 	
+	private:
+		// Per-component counts saved with the scene (see Serialize)
+		void ReserveStorage(const json& counts);
+
+		// Hierarchies are created by one Scene::CreateEntities call, then their components are deserialized
+		void CollectEntities(json& jsonObj, bool deserializeUUID);
+		void CreateCollectedEntities();
+		Entity DeserializeEntityComponents(json& jsonObj, const entt::entity*& handle);
+
 	private:
 		Scene* m_Scene;
+
+		std::vector<std::string> m_CreatedNames;
+		std::vector<UUID> m_CreatedIDs;
+		std::vector<entt::entity> m_CreatedHandles;
 	};
 
 }
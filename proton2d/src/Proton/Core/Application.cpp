@@ -8,6 +8,7 @@
 #include "Proton/Events/MouseEvents.h"
 
 #include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 #include "Proton/Scene/SceneManager.h"
 #include "Proton/Scene/PrefabManager.h"
 #include "Proton/Assets/AssetManager.h"
@@ -41,6 +42,10 @@ namespace proton {
 			layer->OnDestroy();
 			delete layer;
 		}
+		// Pending jobs may still use the job system and the renderer
+		if (m_JobSystem)
+			m_JobSystem->Shutdown();
+		m_JobSystem.reset();
 		Renderer::Shutdown();
 	}
 
@@ -54,6 +59,8 @@ namespace proton {
 
 		AssetManager::Init();
 		Renderer::Init();
+		m_JobSystem = MakeUnique<JobSystem>();
+		PROFILE_THREAD("Main");
 
 	#ifdef PT_EDITOR
 		m_EditorLayer = new EditorLayer();
@@ -88,6 +95,15 @@ namespace proton {
 				PROFILE_SCOPE("app_game_loop");
 				Timer timer;
 
+				// State changed outside of the renderer (ImGui, window) is not tracked by the cache
+				GLState::NewFrame();
+
+				// GL work queued by jobs
+				m_JobSystem->ExecuteMainThreadJobs();
+
+				// Texture uploads and registering of scenes loaded in the background
+				SceneManager::Update();
+
 				if (!m_WindowMinimized) 
 				{
 				#ifndef PT_EDITOR
@@ -116,7 +132,10 @@ namespace proton {
 					// Update active scene
 					Scene* scene = SceneManager::GetActiveScene();
 					if (scene)
+					{
 						scene->OnUpdate(m_FrameTime * m_TimeScale);
+						scene->OnRender();
+					}
 				#endif
 				}
 
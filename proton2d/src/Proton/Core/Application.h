@@ -5,6 +5,7 @@
 #include "Proton/Core/Window.h"
 #include "Proton/Core/Config.h"
 #include "Proton/Core/Project.h"
+#include "Proton/Core/JobSystem.h"
 
 #ifdef PT_EDITOR
 #include "Proton/Editor/EditorLayer.h"
@@ -26,6 +27,7 @@ namespace proton {
 		inline float GetTimeScale() const { return m_TimeScale; };
 
 		Window& GetWindow() { return *m_Window; }
+		JobSystem& GetJobSystem() { return *m_JobSystem; }
 		static Application& Get() { return *s_Instance; }
 
 	protected:
@@ -39,6 +41,7 @@ namespace proton {
 		ApplicationConfig m_AppConfig;
 		std::vector<AppLayer*> m_AppLayers;
 		Unique<Window> m_Window;
+		Unique<JobSystem> m_JobSystem;
 		Project m_Project;
 
 		bool m_IsRunning = false;
@@ -0,0 +1,268 @@
+#include "ptpch.h"
+#include "Proton/Core/JobSystem.h"
+
+namespace proton {
+
+	// Queue of the calling thread in the job system it belongs to
+	static thread_local const JobSystem* t_JobSystem = nullptr;
+	static thread_local uint32_t t_QueueIndex = 0;
+
+	JobSystem::JobSystem(uint32_t workersCount)
+		: m_MainThread(std::this_thread::get_id())
+	{
+		if (!workersCount)
+			workersCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		for (uint32_t i = 0; i < workersCount + 1; i++)
+			m_Queues.push_back(MakeUnique<WorkerQueue>());
+
+		for (uint32_t i = 0; i < workersCount; i++)
+			m_Workers.emplace_back(&JobSystem::WorkerThread, this, i + 1);
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Shutdown();
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!m_Running)
+			return;
+
+		PT_CORE_ASSERT(IsMainThread(), "Job system shut down from another thread!");
+		PROFILE_FUNCTION();
+
+		// Scene destruction and GL deletions queued at exit are not dropped, running jobs can still queue more
+		while (m_PendingJobs > 0)
+		{
+			ExecuteMainThreadJobs();
+			if (!TryExecuteJob(0))
+				std::this_thread::yield();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+			m_Running = false;
+		}
+		m_WakeCondition.notify_all();
+		for (std::thread& worker : m_Workers)
+			worker.join();
+		m_Workers.clear();
+	}
+
+	uint32_t JobSystem::GetQueueIndex() const
+	{
+		return t_JobSystem == this ? t_QueueIndex : 0;
+	}
+
+	void JobSystem::WorkerThread(uint32_t index)
+	{
+		t_JobSystem = this;
+		t_QueueIndex = index;
+
+		std::string name = "Worker " + std::to_string(index);
+		PROFILE_THREAD(name.c_str());
+
+		while (m_Running)
+		{
+			if (TryExecuteJob(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_WakeCondition.wait(lock, [&]() { return !m_Running || m_QueuedJobs > 0; });
+		}
+	}
+
+	void JobSystem::Run(const char* name, JobFunction function, JobCounter* counter, JobCounter* dependency)
+	{
+		if (counter)
+			counter->Count.fetch_add(1, std::memory_order_relaxed);
+		m_PendingJobs++;
+
+		Job job{ std::move(function), name, counter, dependency };
+		if (dependency && !dependency->IsDone())
+		{
+			// Checked again under the lock, the dependency may have finished in the meantime
+			std::lock_guard<std::mutex> lock(m_WaitingMutex);
+			if (!dependency->IsDone())
+			{
+				m_WaitingJobs.push_back(std::move(job));
+				return;
+			}
+		}
+		Submit(std::move(job));
+	}
+
+	void JobSystem::RunOnMainThread(const char* name, JobFunction function, JobCounter* counter)
+	{
+		if (counter)
+			counter->Count.fetch_add(1, std::memory_order_relaxed);
+		m_PendingJobs++;
+
+		std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+		m_MainThreadJobs.push_back({ std::move(function), name, counter, nullptr });
+	}
+
+	void JobSystem::Submit(Job&& job)
+	{
+		WorkerQueue& queue = *m_Queues[GetQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+		m_QueuedJobs++;
+
+		// Taken so a worker cannot miss the wake up between its check and its wait
+		{
+			std::lock_guard<std::mutex> lock(m_WakeMutex);
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	bool JobSystem::PopJob(uint32_t queueIndex, Job& job)
+	{
+		// Newest job of the own queue, it is likely still in cache
+		{
+			WorkerQueue& queue = *m_Queues[queueIndex];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Jobs.size())
+			{
+				job = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+				return true;
+			}
+		}
+
+		// Steal the oldest job of another queue
+		uint32_t queuesCount = (uint32_t)m_Queues.size();
+		for (uint32_t i = 1; i < queuesCount; i++)
+		{
+			WorkerQueue& queue = *m_Queues[(queueIndex + i) % queuesCount];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+			if (queue.Jobs.size())
+			{
+				job = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool JobSystem::TryExecuteJob(uint32_t queueIndex)
+	{
+		if (m_QueuedJobs == 0)
+			return false;
+
+		Job job;
+		if (!PopJob(queueIndex, job))
+			return false;
+
+		m_QueuedJobs--;
+		Execute(job);
+		return true;
+	}
+
+	void JobSystem::Execute(Job& job)
+	{
+		{
+			PROFILE_SCOPE(job.Name);
+			job.Function();
+		}
+
+		if (job.Counter && job.Counter->Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			ReleaseWaitingJobs();
+
+		// Last, jobs queued by this one are already pending
+		m_PendingJobs--;
+	}
+
+	void JobSystem::ReleaseWaitingJobs()
+	{
+		std::lock_guard<std::mutex> lock(m_WaitingMutex);
+		for (size_t i = 0; i < m_WaitingJobs.size();)
+		{
+			if (!m_WaitingJobs[i].Dependency->IsDone())
+			{
+				i++;
+				continue;
+			}
+
+			Submit(std::move(m_WaitingJobs[i]));
+			m_WaitingJobs[i] = std::move(m_WaitingJobs.back());
+			m_WaitingJobs.pop_back();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		PROFILE_FUNCTION();
+
+		uint32_t queueIndex = GetQueueIndex();
+		bool mainThread = IsMainThread();
+		while (!counter.IsDone())
+		{
+			// Jobs of the counter will never run
+			if (!m_Running)
+			{
+				PT_CORE_ERROR("Job system stopped while waiting for a counter!");
+				return;
+			}
+
+			if (mainThread)
+				ExecuteMainThreadJobs();
+
+			if (!TryExecuteJob(queueIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(const char* name, uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function)
+	{
+		chunkSize = std::max(chunkSize, 1u);
+		uint32_t chunksCount = (count + chunkSize - 1) / chunkSize;
+		if (chunksCount == 0)
+			return;
+
+		// Not worth a job
+		if (chunksCount == 1 || m_Workers.empty())
+		{
+			PROFILE_SCOPE(name);
+			function(0, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t chunk = 0; chunk < chunksCount; chunk++)
+		{
+			uint32_t first = chunk * chunkSize;
+			uint32_t last = std::min(first + chunkSize, count);
+			Run(name, [&function, first, last]() { function(first, last); }, &counter);
+		}
+		Wait(counter);
+	}
+
+	void JobSystem::ExecuteMainThreadJobs()
+	{
+		PT_CORE_ASSERT(IsMainThread(), "Main thread jobs executed on another thread!");
+
+		// Main thread job waiting for a counter, jobs queued meanwhile run on the next call
+		if (m_ExecutingMainThreadJobs)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+			if (m_MainThreadJobs.empty())
+				return;
+			std::swap(m_MainThreadJobs, m_MainThreadJobsExecuted);
+		}
+
+		m_ExecutingMainThreadJobs = true;
+		for (Job& job : m_MainThreadJobsExecuted)
+			Execute(job);
+		m_MainThreadJobsExecuted.clear();
+		m_ExecutingMainThreadJobs = false;
+	}
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <entt/entt.hpp>
+
+namespace proton {
+
+	// Number of unfinished jobs, incremented when a job is submitted and decremented when it finishes
+	struct JobCounter
+	{
+		std::atomic<uint32_t> Count = 0;
+
+		bool IsDone() const { return Count.load(std::memory_order_acquire) == 0; }
+	};
+
+	//
+	// Work-stealing job system, owned by the Application (see Application::GetJobSystem).
+	// Every worker has its own deque: it pops its newest jobs, idle workers steal the oldest jobs of others.
+	// Jobs can wait for a counter before they start, waiting threads execute other jobs in the meantime.
+	// Main thread jobs (GL calls) are queued separately and run by the main thread once per frame or while it waits.
+	// Each job is profiled under its name on the track of the thread which executed it.
+	//
+	class JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+
+		JobSystem(uint32_t workersCount = 0); // 0: hardware threads - 1
+		virtual ~JobSystem();
+
+		// Run the function on any thread. The counter is incremented now and decremented once the job finished.
+		// The job does not start before the dependency counter is done.
+		void Run(const char* name, JobFunction function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+		void RunOnMainThread(const char* name, JobFunction function, JobCounter* counter = nullptr);
+
+		// Blocks until the counter is done, the calling thread executes jobs while waiting.
+		// Returns early if the job system stopped.
+		void Wait(JobCounter& counter);
+
+		// function(first, last) is called for [first, last) subranges of [0, count), returns when all are done
+		void ParallelFor(const char* name, uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function);
+
+		// function(entity) for every entity of an entt view
+		template<typename TView, typename TFunction>
+		void ParallelForEach(const char* name, TView& view, uint32_t chunkSize, TFunction function)
+		{
+			std::vector<entt::entity> entities(view.begin(), view.end());
+			ParallelFor(name, (uint32_t)entities.size(), chunkSize, [&](uint32_t first, uint32_t last)
+			{
+				for (uint32_t i = first; i < last; i++)
+					function(entities[i]);
+			});
+		}
+
+		// Called by the Application on the main thread every frame
+		void ExecuteMainThreadJobs();
+
+		// Finishes all pending jobs (main thread jobs and jobs queued by running ones included), then stops the workers.
+		// Called by the Application on the main thread while the job system is still reachable by jobs, the destructor
+		// only calls it if the Application did not.
+		void Shutdown();
+
+		uint32_t GetWorkersCount() const { return (uint32_t)m_Workers.size(); }
+		bool IsMainThread() const { return std::this_thread::get_id() == m_MainThread; }
+
+		// Queue of the calling thread: 0 main thread (and threads outside of the job system), i + 1 worker i
+		uint32_t GetQueueIndex() const;
+		uint32_t GetQueuesCount() const { return (uint32_t)m_Queues.size(); }
+
+	private:
+		struct Job
+		{
+			JobFunction Function;
+			const char* Name = nullptr;
+			JobCounter* Counter = nullptr;
+			JobCounter* Dependency = nullptr;
+		};
+
+		struct WorkerQueue
+		{
+			std::deque<Job> Jobs;
+			std::mutex Mutex;
+		};
+
+		void WorkerThread(uint32_t index);
+		void Submit(Job&& job);
+		bool TryExecuteJob(uint32_t queueIndex);
+		bool PopJob(uint32_t queueIndex, Job& job);
+		void Execute(Job& job);
+		void ReleaseWaitingJobs();
+
+	private:
+		std::thread::id m_MainThread;
+		std::vector<std::thread> m_Workers;
+		std::vector<Unique<WorkerQueue>> m_Queues; // [0] main thread and external threads, [i + 1] worker i
+		std::atomic<bool> m_Running = true;
+		std::atomic<uint32_t> m_PendingJobs = 0; // submitted and not finished yet, of all kinds
+
+		// Sleeping workers
+		std::mutex m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+		std::atomic<uint32_t> m_QueuedJobs = 0;
+
+		// Jobs with an unfinished dependency
+		std::mutex m_WaitingMutex;
+		std::vector<Job> m_WaitingJobs;
+
+		std::mutex m_MainThreadMutex;
+		std::vector<Job> m_MainThreadJobs;
+		std::vector<Job> m_MainThreadJobsExecuted; // swapped with m_MainThreadJobs, keeps storage
+		bool m_ExecutingMainThreadJobs = false;
+	};
+
+}
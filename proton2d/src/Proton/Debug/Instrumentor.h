@@ -9,6 +9,8 @@
 #include <chrono>
 #include <algorithm>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 #include <thread>
 
@@ -32,6 +34,8 @@ namespace proton {
         InstrumentationSession* m_CurrentSession;
         std::ofstream m_OutputStream;
         int m_ProfileCount;
+        std::mutex m_Mutex; // profiles are written by job system workers too
+        std::unordered_map<uint32_t, std::string> m_ThreadNames;
     public:
         Instrumentor()
             : m_CurrentSession(nullptr), m_ProfileCount(0)
@@ -40,13 +44,18 @@ namespace proton {
 
         void BeginSession(const std::string& name, const std::string& filepath = "results.json")
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             m_OutputStream.open(filepath);
             WriteHeader();
             m_CurrentSession = new InstrumentationSession{ name };
+
+            for (auto& [threadID, threadName] : m_ThreadNames)
+                WriteThreadName(threadID, threadName);
         }
 
         void EndSession()
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             WriteFooter();
             m_OutputStream.close();
             delete m_CurrentSession;
@@ -54,8 +63,33 @@ namespace proton {
             m_ProfileCount = 0;
         }
 
+        // Name of the track of the calling thread in the trace viewer
+        void SetThreadName(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            uint32_t threadID = GetThreadID();
+            m_ThreadNames[threadID] = name;
+            if (m_CurrentSession)
+                WriteThreadName(threadID, name);
+        }
+
+        void WriteThreadName(uint32_t threadID, const std::string& name)
+        {
+            if (m_ProfileCount++ > 0)
+                m_OutputStream << ",";
+
+            m_OutputStream << "{";
+            m_OutputStream << "\"name\":\"thread_name\",";
+            m_OutputStream << "\"ph\":\"M\",";
+            m_OutputStream << "\"pid\":0,";
+            m_OutputStream << "\"tid\":" << threadID << ",";
+            m_OutputStream << "\"args\":{\"name\":\"" << name << "\"}";
+            m_OutputStream << "}";
+        }
+
         void WriteProfile(const ProfileResult& result)
         {
+            std::lock_guard<std::mutex> lock(m_Mutex);
             if (m_ProfileCount++ > 0)
                 m_OutputStream << ",";
 
@@ -87,6 +121,11 @@ namespace proton {
             m_OutputStream.flush();
         }
 
+        static uint32_t GetThreadID()
+        {
+            return (uint32_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
+        }
+
         static Instrumentor& Get()
         {
             static Instrumentor instance;
@@ -116,8 +155,7 @@ namespace proton {
             long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
             long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
 
-            uint32_t threadID = (uint32_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
-            Instrumentor::Get().WriteProfile({ m_Name, start, end, threadID });
+            Instrumentor::Get().WriteProfile({ m_Name, start, end, Instrumentor::GetThreadID() });
 
             m_Stopped = true;
         }
@@ -134,9 +172,11 @@ namespace proton {
     #define PROFILE_END_SESSION() ::proton::Instrumentor::Get().EndSession()
     #define PROFILE_SCOPE(name) ::proton::InstrumentationTimer timer##__LINE(name)
     #define PROFILE_FUNCTION() PROFILE_SCOPE(___)
+    #define PROFILE_THREAD(name) ::proton::Instrumentor::Get().SetThreadName(name)
 #else
     #define PROFILE_BEGIN_SESSION(name) 
     #define PROFILE_END_SESSION() 
     #define PROFILE_SCOPE(name) 
     #define PROFILE_FUNCTION() 
+    #define PROFILE_THREAD(name) 
 #endif
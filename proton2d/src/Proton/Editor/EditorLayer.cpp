@@ -10,6 +10,7 @@
 #include "Proton/Editor/Panels/InfoPanel.h"
 
 #include "Proton/Core/Application.h"
+#include "Proton/Core/Timer.h"
 #include "Proton/Core/Window.h"
 #include "Proton/Graphics/Renderer/Renderer.h"
 #include "Proton/Graphics/Renderer/Framebuffer.h"
@@ -184,17 +185,22 @@ namespace proton {
 
 	void EditorLayer::OnBeginSceneSimulation(Scene* scene)
 	{
-		m_SceneBackup[scene->m_SceneFilepath] = scene->CreateSceneCopy();
+		// Play and stop latency is dominated by the snapshot, logged so it can be compared across scenes
+		Timer timer;
+		m_SceneSnapshots[scene->m_SceneFilepath] = MakeUnique<SceneSnapshot>(scene);
+		PT_CORE_INFO("scene='{}' entities={} snapshot={:.2f}ms", scene->m_SceneFilepath, scene->GetEntitiesCount(), timer.ElapsedMillis());
 	}
 
 	void EditorLayer::OnStopSceneSimulation(Scene* scene)
 	{
 		bool isActiveScene = scene == m_ActiveScene;
 		std::string sceneFilepath = scene->m_SceneFilepath;
-		SceneManager::s_Instance->m_Scenes[sceneFilepath] = m_SceneBackup.at(sceneFilepath);
+		Timer timer;
+		m_SceneSnapshots.at(sceneFilepath)->Restore();
+		m_SceneSnapshots.erase(sceneFilepath);
+		PT_CORE_INFO("scene='{}' entities={} restore={:.2f}ms", sceneFilepath, scene->GetEntitiesCount(), timer.ElapsedMillis());
 		if (isActiveScene)
 			SceneManager::SetActiveScene(sceneFilepath);
-		m_SceneBackup.erase(sceneFilepath);
 	}
 
 	EditorCamera* EditorLayer::GetCamera()
@@ -5,6 +5,7 @@
 #include "Proton/Core/AppLayer.h"
 #include "Proton/Core/Config.h"
 #include "Proton/Scene/Entity.h"
+#include "Proton/Scene/SceneSnapshot.h"
 #include "Proton/Graphics/Renderer/Framebuffer.h"
 
 struct ImFont;
@@ -55,7 +56,7 @@ namespace proton {
 		Scene* m_ActiveScene = nullptr;
 		Entity m_SelectedEntity;
 
-		std::unordered_map<std::string, Shared<Scene>> m_SceneBackup;
+		std::unordered_map<std::string, Unique<SceneSnapshot>> m_SceneSnapshots;
 
 		EditorConfig m_Config;
 		EditorMenuBar m_MenuBar;
@@ -2,9 +2,12 @@
 #ifdef PT_EDITOR
 #include "Proton/Editor/Panels/InfoPanel.h"
 #include "Proton/Editor/EditorLayer.h"
+#include "Proton/Editor/Panels/SceneViewportPanel.h"
 #include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 #include "Proton/Assets/AssetManager.h"
 #include "Proton/Core/Application.h"
+#include "Proton/UI/UICanvas.h"
 
 #include "imgui.h"
 
@@ -51,6 +54,18 @@ namespace proton {
 		uint32_t scriptedEntitiesCount = m_ActiveScene ? m_ActiveScene->GetScriptedEntitiesCount() : 0;
 		ImGui::Text("Entities: %i (%i scripted)", entitiesCount, scriptedEntitiesCount);
 		ImGui::Text("OpenGL Draw Calls: %i", m_ActiveScene ? Renderer::GetDrawCallsCount() : 0);
+		ImGui::Text("OpenGL State Calls: %i (%i redundant skipped)", GLState::GetIssuedCallsCount(), GLState::GetSkippedCallsCount());
+		ImGui::Text("Visible Point Lights: %i", m_ActiveScene ? Renderer::GetVisibleLightsCount() : 0);
+		ImGui::Text("Sprite Mesh Area: %.1f%% of quads", m_ActiveScene ? Renderer::GetSpriteMeshCoverage() * 100.0f : 100.0f);
+		ImGui::Text("UI Canvas: %i quads (%i draw calls)", m_ActiveScene ? m_ActiveScene->GetCanvas().GetQuadsCount() : 0,
+			m_ActiveScene ? m_ActiveScene->GetCanvas().GetDrawCallsCount() : 0);
+		const RenderGraph& renderGraph = *EditorLayer::GetSceneViewportPanel()->m_RenderGraph;
+		ImGui::Text("Render Graph: %i passes (%i culled), %i transient textures in %i allocations", renderGraph.GetPassesCount(),
+			renderGraph.GetCulledPassesCount(), renderGraph.GetTransientTexturesCount(), renderGraph.GetPooledTexturesCount());
+		ImGui::Text("Transient VRAM: %.2f MB (%.2f MB saved by aliasing)", renderGraph.GetTransientMemory() / (1024.0f * 1024.0f),
+			renderGraph.GetAliasedMemorySaved() / (1024.0f * 1024.0f));
+		ImGui::Text("Sprite Impostors: %i (%i sprites culled)", m_ActiveScene ? m_ActiveScene->GetDrawnImpostorsCount() : 0,
+			m_ActiveScene ? m_ActiveScene->GetCulledSpritesCount() : 0);
 
 		ImGui::Dummy({ 0, 10 });
 		ImGui::Text("Frame time: %f sec. (%.2f FPS)", m_FrameTimeDisplay, m_FPS);
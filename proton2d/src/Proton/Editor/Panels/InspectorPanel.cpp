@@ -10,6 +10,7 @@
 #include "Proton/Scripting/EntityScript.h"
 #include "Proton/Scene/PrefabManager.h"
 #include "Proton/Physics/PhysicsWorld.h"
+#include "Proton/Scene/WorldStreamer.h"
 
 #include <imgui.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -44,7 +45,7 @@ namespace proton {
 		strcpy_s(buffer, sizeof(buffer), m_SelectedEntity.GetTag().c_str());
 		ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, { 8, 5 });
 		if (ImGui::InputText("##tag", buffer, sizeof(buffer)))
-			m_SelectedEntity.GetComponent<TagComponent>().Tag = std::string(buffer);
+			m_SelectedEntity.SetTag(buffer);
 		ImGui::PopStyleVar();
 		ImGui::SameLine();
 
@@ -65,6 +66,7 @@ namespace proton {
 			ADD_COMPONENT_POPUP_MENU_ITEM(SpriteComponent);
 			ADD_COMPONENT_POPUP_MENU_ITEM(ResizableSpriteComponent);
 			ADD_COMPONENT_POPUP_MENU_ITEM(CircleRendererComponent);
+			ADD_COMPONENT_POPUP_MENU_ITEM(PointLight2DComponent);
 			ADD_COMPONENT_POPUP_MENU_ITEM(CameraComponent);
 			ADD_COMPONENT_POPUP_MENU_ITEM(RigidbodyComponent);
 			ADD_COMPONENT_POPUP_MENU_ITEM(BoxColliderComponent);
@@ -123,6 +125,8 @@ namespace proton {
 		// ******************************************************
 		if (m_SelectedEntity.HasComponent<TransformComponent>())
 		{
+			// Fields are edited in place by the widgets below (and the sprite size buttons)
+			m_SelectedEntity.MarkTransformDirty();
 			DrawComponentUI<TransformComponent>("Transform", [&](auto& component)
 			{
 				// Posittion
@@ -184,6 +188,8 @@ namespace proton {
 		{
 			DrawComponentUI<SpriteComponent>("Sprite", [&](auto& component)
 			{
+				// Fields are edited in place, the chunk impostor of a static sprite is refreshed once at the end
+				bool edited = false;
 				Sprite& sprite = component.Sprite;
 				std::string textureFilename = sprite 
 					? GetFilepathRelative(s_TexturesPath, sprite.GetTexture()->GetPath())
@@ -193,7 +199,10 @@ namespace proton {
 				if (ImGui::BeginCombo("Texture", textureFilename.c_str()))
 				{
 					if (ImGui::Selectable("Fill Color"))
+					{
 						sprite.SetTexture(nullptr);
+						edited = true;
+					}
 
 					// Spritesheets
 					for (auto& kv : AssetManager::s_Instance->m_SpritesheetList)
@@ -206,6 +215,7 @@ namespace proton {
 							if (spritesheet)
 							{
 								sprite = Sprite(spritesheet);
+								edited = true;
 								auto& scale = m_SelectedEntity.GetTransform().Scale;
 								float ratio = sprite.GetAspectRatio();
 								if (scale.x / scale.y != ratio)
@@ -227,6 +237,7 @@ namespace proton {
 							if (texture)
 							{
 								sprite = Sprite(texture);
+								edited = true;
 								auto& scale = m_SelectedEntity.GetTransform().Scale;
 								float ratio = sprite.GetAspectRatio();
 								if (scale.x / scale.y != ratio)
@@ -244,7 +255,7 @@ namespace proton {
 
 				// Tint color control
 				ImGui::Dummy({ 0, 2 });
-				ImGui::ColorEdit4("Color", glm::value_ptr(component.Color), ImGuiColorEditFlags_AlphaBar);
+				edited |= ImGui::ColorEdit4("Color", glm::value_ptr(component.Color), ImGuiColorEditFlags_AlphaBar);
 				ImGui::Dummy({ 0, 2 });
 
 				if (sprite)
@@ -252,9 +263,9 @@ namespace proton {
 					// Mirror flip
 					ImGui::Text("Mirror Flip");
 					ImGui::SameLine();
-					ImGui::Checkbox("X##Flip", &sprite.m_MirrorFlipX);
+					edited |= ImGui::Checkbox("X##Flip", &sprite.m_MirrorFlipX);
 					ImGui::SameLine();
-					ImGui::Checkbox("Y##Flip", &sprite.m_MirrorFlipY);
+					edited |= ImGui::Checkbox("Y##Flip", &sprite.m_MirrorFlipY);
 					ImGui::Dummy({ 0, 1 });
 
 					// Texture filter mode
@@ -270,6 +281,7 @@ namespace proton {
 							{
 								sprite.GetTexture()->SetFilterMode((TextureFilterMode)i);
 								filterMode = i;
+								edited = true;
 							}
 
 							if (isSelected)
@@ -279,7 +291,7 @@ namespace proton {
 					}
 
 					// Tiling factor
-					ImGui::DragFloat("Tiling Factor", &component.TilingFactor, 0.1f);
+					edited |= ImGui::DragFloat("Tiling Factor", &component.TilingFactor, 0.1f);
 				}
 
 				// Check if texture is spritesheet
@@ -295,6 +307,7 @@ namespace proton {
 					{
 						if (tilePos.x >= 0 && tilePos.y >= 0)
 							sprite.SetTile(tilePos.x, tilePos.y);
+						edited = true;
 					}
 
 					glm::ivec2 tileSize = (glm::ivec2)sprite.m_TileSize;
@@ -302,8 +315,12 @@ namespace proton {
 					{
 						if (tileSize.x > 0 && tileSize.y > 0)
 							sprite.SetTileSize((uint32_t)tileSize.x, (uint32_t)tileSize.y);
+						edited = true;
 					}
 				}
+
+				if (edited)
+					m_SelectedEntity.MarkSpriteDirty();
 			});
 		}
 
@@ -391,6 +408,21 @@ namespace proton {
 				});
 		}
 
+		// ******************************************************
+		// PointLight2D Component UI
+		// ******************************************************
+		if (m_SelectedEntity.HasComponent<PointLight2DComponent>())
+		{
+			DrawComponentUI<PointLight2DComponent>("PointLight2D", [&](auto& component)
+				{
+					ImGui::ColorEdit3("Color", glm::value_ptr(component.Color));
+					ImGui::DragFloat("Intensity", &component.Intensity, 0.01f, 0.0f);
+					ImGui::DragFloat("Radius", &component.Radius, 0.05f, 0.0f);
+					if (!m_ActiveScene->m_EnableLighting)
+						ImGui::TextDisabled("Scene lighting is disabled");
+				});
+		}
+
 		// ******************************************************
 		// CameraComponent UI
 		// ******************************************************
@@ -570,6 +602,30 @@ namespace proton {
 			Renderer::SetClearColor(m_ActiveScene->m_ClearColor);
 		ImGui::Dummy({ 0.0f, 5.0f });
 
+		// Lighting configuration
+		ImGui::Text("Lighting Settings");
+		ImGui::Dummy({ 0.0f, 3.0f });
+		ImGui::Separator();
+		ImGui::Checkbox("Enable Lighting", &m_ActiveScene->m_EnableLighting);
+		if (m_ActiveScene->m_EnableLighting)
+			ImGui::ColorEdit4("Ambient Light", glm::value_ptr(m_ActiveScene->m_AmbientLightColor));
+		ImGui::Dummy({ 0.0f, 5.0f });
+
+		// Rendering configuration
+		ImGui::Text("Rendering Settings");
+		ImGui::Dummy({ 0.0f, 3.0f });
+		ImGui::Separator();
+		ImGui::Checkbox("Sprite LOD", &m_ActiveScene->m_EnableSpriteLOD);
+		if (m_ActiveScene->m_EnableSpriteLOD)
+		{
+			ImGui::PushItemWidth(100.0f);
+			if (ImGui::DragFloat("Min Sprite Size (px)", &m_ActiveScene->m_MinSpritePixelSize, 0.05f))
+				m_ActiveScene->m_MinSpritePixelSize = glm::max(m_ActiveScene->m_MinSpritePixelSize, 0.0f);
+			ImGui::PopItemWidth();
+		}
+		ImGui::Checkbox("Sprite Meshes", &m_ActiveScene->m_EnableSpriteMeshes);
+		ImGui::Dummy({ 0.0f, 5.0f });
+
 		// Physics configuration
 		ImGui::Text("Physics Settings");
 		ImGui::Dummy({ 0.0f, 3.0f });
@@ -592,6 +648,45 @@ namespace proton {
 
 			ImGui::PopItemWidth();
 		}
+		ImGui::Dummy({ 0.0f, 5.0f });
+
+		// World streaming configuration, cells are written when the scene is saved
+		ImGui::Text("Streaming Settings");
+		ImGui::Dummy({ 0.0f, 3.0f });
+		ImGui::Separator();
+		static float cellSize = 64.0f;
+		WorldStreamer* streamer = m_ActiveScene->GetWorldStreamer();
+		bool enableStreaming = streamer != nullptr;
+		if (ImGui::Checkbox("World Streaming", &enableStreaming) && m_ActiveScene->m_SceneState == SceneState::Stop)
+		{
+			if (enableStreaming)
+				m_ActiveScene->EnableWorldStreaming(cellSize);
+			else
+				m_ActiveScene->DisableWorldStreaming();
+			streamer = m_ActiveScene->GetWorldStreamer();
+		}
+
+		ImGui::PushItemWidth(100.0f);
+		if (streamer)
+		{
+			float loadRadius = streamer->GetLoadRadius();
+			float unloadRadius = streamer->GetUnloadRadius();
+			float frameBudget = streamer->GetFrameBudget();
+			ImGui::Text("Cell Size: %.1f", streamer->GetCellSize());
+			if (ImGui::DragFloat("Load Radius", &loadRadius, 0.5f))
+				streamer->SetLoadRadius(glm::max(loadRadius, 0.0f));
+			if (ImGui::DragFloat("Unload Radius", &unloadRadius, 0.5f))
+				streamer->SetUnloadRadius(glm::max(unloadRadius, streamer->GetLoadRadius()));
+			if (ImGui::DragFloat("Frame Budget (ms)", &frameBudget, 0.05f))
+				streamer->SetFrameBudget(glm::max(frameBudget, 0.1f));
+			ImGui::Text("Active Cells: %u", streamer->GetActiveCellsCount());
+		}
+		else
+		{
+			if (ImGui::DragFloat("Cell Size", &cellSize, 0.5f))
+				cellSize = glm::max(cellSize, 1.0f);
+		}
+		ImGui::PopItemWidth();
 	}
 
 
@@ -31,8 +31,11 @@ namespace proton {
 		ImGui::Dummy({ 0, 2 });
 
 
-		for (Entity entity : m_ActiveScene->m_Root)
+		entt::entity root = m_ActiveScene->m_RootFirst;
+		while (root != entt::null)
 		{
+			Entity entity{ root, m_ActiveScene };
+			root = entity.GetComponent<RelationshipComponent>().Next;
 			DrawEntityTreeNode(entity);
 		}
 
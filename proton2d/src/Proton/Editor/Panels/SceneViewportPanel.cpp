@@ -20,10 +20,14 @@ namespace proton {
 	void SceneViewportPanel::OnCreate()
 	{
 		FramebufferSpecification fbSpec;
-		fbSpec.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::RED_INTEGER, FramebufferTextureFormat::Depth };
+		// Only the presented color is persistent, intermediate targets are render graph transients
+		fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
 		fbSpec.Width = 1280;
 		fbSpec.Height = 720;
 		m_Framebuffer = MakeShared<Framebuffer>(fbSpec);
+		m_RenderScale = MakeUnique<RenderScaleController>();
+		m_RenderGraph = MakeUnique<RenderGraph>();
+		m_FrameCapture = MakeUnique<FrameCapture>();
 		m_Camera = MakeUnique<EditorCamera>();
 	}
 
@@ -48,8 +52,11 @@ namespace proton {
 
 		if (m_ActiveScene)
 		{
+			// Only the rendered region of the (over-allocated) framebuffer is shown, upscaled to the panel size
+			const FramebufferSpecification& spec = m_Framebuffer->GetSpecification();
+			ImVec2 uvMax = { (float)spec.Width / m_Framebuffer->GetAllocatedWidth(), (float)spec.Height / m_Framebuffer->GetAllocatedHeight() };
 			uint64_t textureID = m_Framebuffer->GetColorAttachmentRendererID();
-			ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+			ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y }, ImVec2{ 0, uvMax.y }, ImVec2{ uvMax.x, 0 });
 		}
 		else
 		{
@@ -68,30 +75,32 @@ namespace proton {
 			return;
 
 		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
-		// On viewport resize
+		// On viewport resize or render scale change (dynamic resolution)
+		glm::uvec2 renderSize = glm::max(glm::uvec2(m_ViewportSize * m_RenderScale->GetRenderScale() + 0.5f), glm::uvec2(1));
 		FramebufferSpecification spec = m_Framebuffer->GetSpecification();
 		if (m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f && // zero sized framebuffer is invalid
-			(spec.Width != m_ViewportSize.x || spec.Height != m_ViewportSize.y))
+			(spec.Width != renderSize.x || spec.Height != renderSize.y))
 		{
-			m_Framebuffer->Resize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+			m_Framebuffer->Resize(renderSize.x, renderSize.y);
 			m_Camera->OnViewportResize(m_ViewportSize.x, m_ViewportSize.y);
-			Renderer::SetViewport(0, 0, (uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		}
 
-		m_Framebuffer->Bind();
-		Renderer::SetClearColor(m_ActiveScene->m_ClearColor);
-		Renderer::Clear();
-
-		m_ActiveScene->OnUpdate(ts * Application::Get().GetTimeScale());
-
 		auto [mx, my] = ImGui::GetMousePos();
 		mx -= m_ViewportBounds[0].x;
 		my -= m_ViewportBounds[0].y;
-		glm::vec2 viewportSize = m_ViewportBounds[1] - m_ViewportBounds[0];
 		m_MousePos = { (int)mx, (int)my };
 
-		DrawCollidersAndSelectionOutline();
-		m_Framebuffer->Unbind();
+		// Passes of the render graph only draw the updated scene
+		m_ActiveScene->OnUpdate(ts * Application::Get().GetTimeScale());
+
+		m_RenderScale->BeginFrame();
+		BuildRenderGraph();
+		m_RenderGraph->Compile();
+		m_RenderGraph->Execute();
+		m_RenderScale->EndFrame();
+
+		const FramebufferSpecification& captureSpec = m_Framebuffer->GetSpecification();
+		m_FrameCapture->Capture(m_Framebuffer->GetColorAttachmentRendererID(), captureSpec.Width, captureSpec.Height);
 
 		const glm::vec2& cursor = m_ActiveScene->GetCursorWorldPosition();
 
@@ -105,6 +114,7 @@ namespace proton {
 			auto& transform = m_SelectedEntity.GetComponent<TransformComponent>();
 			transform.LocalPosition.y += targetPos.y - transform.WorldPosition.y;
 			transform.LocalPosition.x += targetPos.x - transform.WorldPosition.x;
+			m_SelectedEntity.MarkTransformDirty();
 			ImGui::SetMouseCursor(7);
 		}
 
@@ -219,6 +229,61 @@ namespace proton {
 		});
 	}
 
+	void SceneViewportPanel::BuildRenderGraph()
+	{
+		const FramebufferSpecification& spec = m_Framebuffer->GetSpecification();
+		m_RenderGraph->Reset();
+
+		RenderGraphTextureDesc colorDesc;
+		colorDesc.Format = FramebufferTextureFormat::RGBA8;
+		colorDesc.Width = spec.Width;
+		colorDesc.Height = spec.Height;
+		colorDesc.ClearValue = m_ActiveScene->m_ClearColor;
+		RenderGraphResource color = m_RenderGraph->ImportTexture("SceneColor", m_Framebuffer->GetColorAttachmentRendererID(), colorDesc);
+
+		RenderGraphTextureDesc entityDesc = colorDesc;
+		entityDesc.Format = FramebufferTextureFormat::RED_INTEGER;
+		entityDesc.ClearValue = glm::vec4(-1.0f);
+		RenderGraphResource entityID = m_RenderGraph->CreateTexture("EntityID", entityDesc);
+
+		RenderGraphTextureDesc depthDesc = colorDesc;
+		depthDesc.Format = FramebufferTextureFormat::Depth;
+		depthDesc.ClearValue = glm::vec4(1.0f);
+		RenderGraphResource depth = m_RenderGraph->CreateTexture("SceneDepth", depthDesc);
+
+		// Overdraw view: the scene accumulates fragment counts, resolved to a color ramp into the scene color.
+		// Editor overlays are left out, they would only add to the counts.
+		if (Renderer::GetDebugMode() == RendererDebugMode::Overdraw)
+		{
+			RenderGraphTextureDesc overdrawDesc = colorDesc;
+			overdrawDesc.Format = FramebufferTextureFormat::RGBA16F;
+			overdrawDesc.ClearValue = glm::vec4(0.0f);
+			RenderGraphResource overdraw = m_RenderGraph->CreateTexture("Overdraw", overdrawDesc);
+
+			m_RenderGraph->AddPass("Scene", {}, { overdraw, entityID, depth }, [this]()
+			{
+				m_ActiveScene->OnRender();
+			});
+
+			m_RenderGraph->AddPass("OverdrawResolve", { overdraw }, { color }, [this, overdraw]()
+			{
+				Renderer::ResolveOverdraw(m_RenderGraph->GetTextureID(overdraw));
+			});
+			return;
+		}
+
+		// The scene pass is never culled as it writes the presented color
+		m_RenderGraph->AddPass("Scene", {}, { color, entityID, depth }, [this]()
+		{
+			m_ActiveScene->OnRender();
+		});
+
+		m_RenderGraph->AddPass("EditorOverlay", { color, depth }, { color, depth }, [this]()
+		{
+			DrawCollidersAndSelectionOutline();
+		});
+	}
+
 	void SceneViewportPanel::DrawCollidersAndSelectionOutline()
 	{
 		Renderer::BeginScene(m_ActiveScene->GetPrimaryCamera(), m_ActiveScene->GetPrimaryCameraPosition());
@@ -239,7 +304,7 @@ namespace proton {
 					? glm::vec4{ 0.9f, 0.3f, 0.3f, 0.5f } : glm::vec4{ 0.9f, 0.6f, 0.3f, 0.5f };
 				glm::vec3 position = { transform.WorldPosition.x + bc.Offset.x, transform.WorldPosition.y + bc.Offset.y, zPos };
 				glm::vec3 scale = { bc.Size.x * transform.Scale.x, bc.Size.y * transform.Scale.y, 1.0f };
-				glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.Rotation);
+				glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.WorldRotation);
 
 				Renderer::DrawQuad(transformMatrix, color);
 			}
@@ -261,7 +326,7 @@ namespace proton {
 					? glm::vec4{ 0.9f, 0.3f, 0.3f, 0.5f } : glm::vec4{ 0.9f, 0.6f, 0.3f, 0.5f };
 				glm::vec3 position = { transform.WorldPosition.x + cc.Offset.x, transform.WorldPosition.y + cc.Offset.y, zPos };
 				glm::vec3 scale = { cc.Radius * transform.Scale.x, cc.Radius * transform.Scale.y, 1.0f };
-				glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.Rotation);
+				glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.WorldRotation);
 
 				Renderer::DrawCircle(transformMatrix, color);
 			}
@@ -274,7 +339,7 @@ namespace proton {
 			float padding = glm::sqrt(m_ActiveScene->GetPrimaryCamera().GetZoomLevel()) * 0.05f;
 			glm::vec3 position = { transform.WorldPosition.x, transform.WorldPosition.y, 0.21f };
 			glm::vec3 scale = { transform.Scale.x + padding, transform.Scale.y + padding, 1.0f };
-			glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.Rotation);
+			glm::mat4 transformMatrix = Math::GetTransform(position, scale, transform.WorldRotation);
 
 			glm::vec4 color = m_ShowSelectionOutline && m_MoveSelectedEntity
 				? glm::vec4{ 0.8f, 0.8f, 0.2f, 1.0f } : glm::vec4{ 1.0f };
@@ -2,6 +2,9 @@
 #ifdef PT_EDITOR
 #include "Proton/Editor/Panels/EditorPanel.h"
 #include "Proton/Graphics/Renderer/Framebuffer.h"
+#include "Proton/Graphics/Renderer/RenderScaleController.h"
+#include "Proton/Graphics/Renderer/RenderGraph.h"
+#include "Proton/Graphics/Renderer/FrameCapture.h"
 
 namespace proton {
 
@@ -14,6 +17,7 @@ namespace proton {
 		virtual void OnEvent(Event& event) override;
 
 	private:
+		void BuildRenderGraph();
 		void DrawCollidersAndSelectionOutline();
 		void HandleImGuiDragAndDrop();
 
@@ -21,6 +25,9 @@ namespace proton {
 		Unique<EditorCamera> m_Camera;
 
 		Shared<Framebuffer> m_Framebuffer;
+		Unique<RenderScaleController> m_RenderScale;
+		Unique<RenderGraph> m_RenderGraph;
+		Unique<FrameCapture> m_FrameCapture;
 		glm::vec2 m_ViewportSize = { 0.0f, 0.0f };
 		glm::vec2 m_ViewportBounds[2] = { { 0.0f, 0.0f }, {0.0f, 0.0f} };
 		
@@ -41,6 +48,7 @@ namespace proton {
 		friend class Scene;
 		friend class EditorLayer;
 		friend class SettingsPanel;
+		friend class InfoPanel;
 		friend class EditorMenuBar;
 	};
 
@@ -8,6 +8,7 @@
 #include "Proton/Core/Application.h"
 
 #include "imgui.h"
+#include <ctime>
 
 namespace proton {
 
@@ -46,6 +47,53 @@ namespace proton {
 			ImGui::Checkbox("Selection collider", &viewportPanel->m_ShowSelectionCollider);
 			ImGui::Checkbox("Show colliders", &viewportPanel->m_ShowAllColliders);
 			ImGui::Checkbox("Runtime camera", &EditorLayer::GetCamera()->m_UseInRuntime);
+
+			// Renderer debug visualization (Quad2D shader variants)
+			const char* debugModes[] = { "None", "Overdraw", "Batches", "Texture slots" };
+			int debugMode = (int)Renderer::GetDebugMode();
+			ImGui::PushItemWidth(120.0f);
+			if (ImGui::Combo("Debug view", &debugMode, debugModes, IM_ARRAYSIZE(debugModes)))
+				Renderer::SetDebugMode((RendererDebugMode)debugMode);
+			ImGui::PopItemWidth();
+
+			RenderScaleController& renderScale = *viewportPanel->m_RenderScale;
+			bool dynamicResolution = renderScale.IsEnabled();
+			if (ImGui::Checkbox("Dynamic resolution", &dynamicResolution))
+				renderScale.SetEnabled(dynamicResolution);
+			if (dynamicResolution)
+			{
+				ImGui::PushItemWidth(100.0f);
+				float targetFrameTime = renderScale.GetTargetFrameTime();
+				if (ImGui::DragFloat("GPU budget (ms)", &targetFrameTime, 0.1f, 1.0f, 100.0f))
+					renderScale.SetTargetFrameTime(targetFrameTime);
+				float minScale = renderScale.GetMinScale();
+				if (ImGui::DragFloat("Min render scale", &minScale, 0.01f, 0.1f, 1.0f))
+					renderScale.SetScaleRange(minScale, renderScale.GetMaxScale());
+				ImGui::PopItemWidth();
+			}
+			ImGui::Text("Render scale: %.2f (GPU %.2f ms)", renderScale.GetRenderScale(), renderScale.GetGPUFrameTime());
+
+			// Frame capture of the scene viewport, named after the capture start time
+			FrameCapture& capture = *viewportPanel->m_FrameCapture;
+			ImGui::Dummy({ 0, 2 });
+			if (!capture.IsRecording())
+			{
+				char name[32];
+				std::time_t time = std::time(nullptr);
+				std::strftime(name, sizeof(name), "capture_%Y%m%d_%H%M%S", std::localtime(&time));
+
+				if (ImGui::Button("Record PNG frames"))
+					capture.Start(std::string("captures/") + name, FrameCaptureFormat::PNGSequence);
+				ImGui::SameLine();
+				if (ImGui::Button("Record video"))
+					capture.Start(std::string("captures/") + name + ".mp4", FrameCaptureFormat::Video);
+			}
+			else if (ImGui::Button("Stop recording"))
+			{
+				capture.Stop();
+			}
+			ImGui::Text("Captured: %i frames (%i dropped, %.2f ms/frame)", capture.GetCapturedFramesCount(),
+				capture.GetDroppedFramesCount(), capture.GetCaptureTime());
 			ImGui::TreePop();
 		}
 		ImGui::Dummy({ 0, 5 });
@@ -6,6 +6,7 @@
 //
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/Buffer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 
 #include <glad/glad.h>
 
@@ -14,35 +15,43 @@ namespace proton {
 	VertexBuffer::VertexBuffer(uint32_t size)
 	{
 		glCreateBuffers(1, &m_Object_ID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_Object_ID);
+		GLState::BindArrayBuffer(m_Object_ID);
 		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
 	}
 
 	VertexBuffer::VertexBuffer(float* vertices, uint32_t size)
 	{
 		glCreateBuffers(1, &m_Object_ID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_Object_ID);
+		GLState::BindArrayBuffer(m_Object_ID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_DYNAMIC_DRAW);
 	}
 
 	VertexBuffer::~VertexBuffer()
 	{
-		glDeleteBuffers(1, &m_Object_ID);
+		uint32_t objectID = m_Object_ID;
+		auto deletion = [objectID]()
+		{
+			GLState::OnBufferDeleted(objectID);
+			glDeleteBuffers(1, &objectID);
+		};
+
+		if (!GLState::DeferDeletion("VertexBuffer::Delete", deletion))
+			deletion();
 	}
 
 	void VertexBuffer::Bind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_Object_ID);
+		GLState::BindArrayBuffer(m_Object_ID);
 	}
 
 	void VertexBuffer::Unbind() const
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::BindArrayBuffer(0);
 	}
 
 	void VertexBuffer::SetData(const void* data, uint32_t size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_Object_ID);
+		GLState::BindArrayBuffer(m_Object_ID);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 	}
 
@@ -50,13 +59,21 @@ namespace proton {
 		: m_Count(count)
 	{
 		glCreateBuffers(1, &m_Object_ID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_Object_ID);
+		GLState::BindArrayBuffer(m_Object_ID);
 		glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
 	}
 
 	IndexBuffer::~IndexBuffer()
 	{
-		glDeleteBuffers(1, &m_Object_ID);
+		uint32_t objectID = m_Object_ID;
+		auto deletion = [objectID]()
+		{
+			GLState::OnBufferDeleted(objectID);
+			glDeleteBuffers(1, &objectID);
+		};
+
+		if (!GLState::DeferDeletion("IndexBuffer::Delete", deletion))
+			deletion();
 	}
 
 	void IndexBuffer::Bind() const
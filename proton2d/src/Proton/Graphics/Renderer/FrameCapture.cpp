@@ -0,0 +1,379 @@
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/FrameCapture.h"
+#include "Proton/Core/Timer.h"
+
+#include <glad/glad.h>
+#include <filesystem>
+
+#if PROTON_PLATFORM_WINDOWS
+	#define PT_POPEN _popen
+	#define PT_PCLOSE _pclose
+#else
+	#define PT_POPEN popen
+	#define PT_PCLOSE pclose
+#endif
+
+namespace proton {
+
+	namespace Utils {
+
+		static uint32_t UpdateCRC32(uint32_t crc, const uint8_t* data, size_t size)
+		{
+			static const auto table = []()
+			{
+				std::array<uint32_t, 256> table;
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t c = i;
+					for (int k = 0; k < 8; k++)
+						c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+					table[i] = c;
+				}
+				return table;
+			}();
+
+			for (size_t i = 0; i < size; i++)
+				crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+			return crc;
+		}
+
+		static uint32_t Adler32(const uint8_t* data, size_t size)
+		{
+			uint32_t a = 1, b = 0;
+			while (size > 0)
+			{
+				// Largest block before the sums can overflow
+				size_t block = size < 5552 ? size : 5552;
+				for (size_t i = 0; i < block; i++)
+				{
+					a += data[i];
+					b += a;
+				}
+				a %= 65521;
+				b %= 65521;
+				data += block;
+				size -= block;
+			}
+			return (b << 16) | a;
+		}
+
+		static void PushBigEndian(std::vector<uint8_t>& buffer, uint32_t value)
+		{
+			buffer.push_back((uint8_t)(value >> 24));
+			buffer.push_back((uint8_t)(value >> 16));
+			buffer.push_back((uint8_t)(value >> 8));
+			buffer.push_back((uint8_t)value);
+		}
+
+		static void WritePNGChunk(FILE* file, const char* type, const uint8_t* data, uint32_t size)
+		{
+			uint8_t header[8] = { (uint8_t)(size >> 24), (uint8_t)(size >> 16), (uint8_t)(size >> 8), (uint8_t)size,
+				(uint8_t)type[0], (uint8_t)type[1], (uint8_t)type[2], (uint8_t)type[3] };
+			uint32_t crc = UpdateCRC32(0xffffffffu, header + 4, 4);
+			crc = UpdateCRC32(crc, data, size) ^ 0xffffffffu;
+			uint8_t footer[4] = { (uint8_t)(crc >> 24), (uint8_t)(crc >> 16), (uint8_t)(crc >> 8), (uint8_t)crc };
+
+			fwrite(header, 1, 8, file);
+			fwrite(data, 1, size, file);
+			fwrite(footer, 1, 4, file);
+		}
+
+		// RGBA8 PNG with bottom-up rows (OpenGL) flipped. The zlib stream uses stored (uncompressed)
+		// deflate blocks: encoding is a copy, so the writer keeps up with full resolution capture.
+		static void WritePNG(FILE* file, const uint8_t* pixels, uint32_t width, uint32_t height, std::vector<uint8_t>& buffer)
+		{
+			static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+			fwrite(signature, 1, 8, file);
+
+			buffer.clear();
+			PushBigEndian(buffer, width);
+			PushBigEndian(buffer, height);
+			uint8_t header[5] = { 8, 6, 0, 0, 0 }; // 8 bit depth, RGBA, deflate, no filter, no interlace
+			buffer.insert(buffer.end(), header, header + 5);
+			WritePNGChunk(file, "IHDR", buffer.data(), (uint32_t)buffer.size());
+
+			// Scanlines with filter type 0
+			size_t rowSize = (size_t)width * 4;
+			size_t rawSize = (rowSize + 1) * height;
+			size_t blockCount = (rawSize + 0xffff - 1) / 0xffff;
+			buffer.resize(2 + blockCount * 5 + rawSize + 4);
+
+			uint8_t* raw = buffer.data() + 2 + blockCount * 5;
+			for (uint32_t y = 0; y < height; y++)
+			{
+				uint8_t* row = raw + (rowSize + 1) * y;
+				row[0] = 0;
+				memcpy(row + 1, pixels + rowSize * (height - 1 - y), rowSize);
+			}
+			uint32_t adler = Adler32(raw, rawSize);
+
+			// Stored block headers are interleaved by moving the data towards the front, block by block
+			buffer[0] = 0x78;
+			buffer[1] = 0x01;
+			for (size_t block = 0; block < blockCount; block++)
+			{
+				size_t offset = block * 0xffff;
+				uint16_t length = (uint16_t)(rawSize - offset < 0xffff ? rawSize - offset : 0xffff);
+				uint8_t* destination = buffer.data() + 2 + block * 5 + offset;
+				memmove(destination + 5, raw + offset, length);
+				destination[0] = block == blockCount - 1 ? 1 : 0;
+				destination[1] = (uint8_t)length;
+				destination[2] = (uint8_t)(length >> 8);
+				destination[3] = (uint8_t)~length;
+				destination[4] = (uint8_t)(~length >> 8);
+			}
+
+			size_t end = buffer.size() - 4;
+			buffer[end + 0] = (uint8_t)(adler >> 24);
+			buffer[end + 1] = (uint8_t)(adler >> 16);
+			buffer[end + 2] = (uint8_t)(adler >> 8);
+			buffer[end + 3] = (uint8_t)adler;
+			WritePNGChunk(file, "IDAT", buffer.data(), (uint32_t)buffer.size());
+			WritePNGChunk(file, "IEND", nullptr, 0);
+		}
+
+	}
+
+	FrameCapture::~FrameCapture()
+	{
+		Stop();
+	}
+
+	bool FrameCapture::Start(const std::string& outputPath, FrameCaptureFormat format, uint32_t frameRate)
+	{
+		if (m_Recording)
+			return false;
+
+		std::filesystem::path directory = format == FrameCaptureFormat::PNGSequence
+			? std::filesystem::path(outputPath) : std::filesystem::path(outputPath).parent_path();
+		std::error_code error;
+		if (!directory.empty())
+			std::filesystem::create_directories(directory, error);
+		if (error)
+		{
+			PT_CORE_ERROR("[FrameCapture] Could not create directory '{0}': {1}", directory.string(), error.message());
+			return false;
+		}
+
+		m_Format = format;
+		m_OutputPath = outputPath;
+		m_FrameRate = frameRate;
+		m_CapturedFrames = 0;
+		m_DroppedFrames = 0;
+		m_StopWorker = false;
+		m_Recording = true;
+		m_Worker = std::thread(&FrameCapture::WorkerThread, this);
+
+		PT_CORE_INFO("[FrameCapture] Recording to '{0}'", outputPath);
+		return true;
+	}
+
+	void FrameCapture::Stop()
+	{
+		if (!m_Recording)
+			return;
+
+		// Pending copies are still written, PollFences waits until every fence signaled
+		PollFences(true);
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_StopWorker = true;
+		}
+		m_QueueCondition.notify_one();
+		m_Worker.join();
+
+		DestroyBuffers();
+		m_Recording = false;
+		if (m_DroppedFrames > 0)
+			PT_CORE_WARN("[FrameCapture] Captured {0} frames, {1} dropped", m_CapturedFrames, m_DroppedFrames.load());
+		else
+			PT_CORE_INFO("[FrameCapture] Captured {0} frames", m_CapturedFrames);
+	}
+
+	void FrameCapture::Capture(uint32_t textureID, uint32_t width, uint32_t height)
+	{
+		if (!m_Recording)
+			return;
+
+		PROFILE_FUNCTION();
+		Timer timer;
+		PollFences(false);
+
+		// Buffers are reallocated for larger frames. Frames in flight are finished first, a resize stalls
+		// once instead of dropping frames until the ring is idle.
+		uint32_t size = width * height * 4;
+		if (size > m_BufferSize)
+		{
+			PollFences(true);
+			for (PixelBuffer& buffer : m_Buffers)
+			{
+				while (buffer.Encoding)
+					std::this_thread::yield();
+			}
+			DestroyBuffers();
+			CreateBuffers(width, height);
+		}
+
+		// Ring is full (GPU or worker thread behind), the frame is dropped instead of waiting
+		PixelBuffer& buffer = m_Buffers[m_NextBuffer];
+		if (buffer.Fence || buffer.Encoding)
+		{
+			m_DroppedFrames++;
+			m_CaptureTime = timer.ElapsedMillis();
+			return;
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.RendererID);
+		glGetTextureSubImage(textureID, 0, 0, 0, 0, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, m_BufferSize, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		buffer.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		buffer.Width = width;
+		buffer.Height = height;
+		buffer.FrameIndex = m_CapturedFrames++;
+		m_NextBuffer = (m_NextBuffer + 1) % BufferCount;
+
+		m_CaptureTime = timer.ElapsedMillis();
+	}
+
+	void FrameCapture::PollFences(bool wait)
+	{
+		// Copies complete in submission order, starting from the oldest buffer
+		for (uint32_t i = 0; i < BufferCount; i++)
+		{
+			uint32_t index = (m_NextBuffer + i) % BufferCount;
+			PixelBuffer& buffer = m_Buffers[index];
+			if (!buffer.Fence)
+				continue;
+
+			// Waiting is repeated until the copy completes, the timeout only bounds a single call
+			GLsync fence = (GLsync)buffer.Fence;
+			GLenum result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000 : 0);
+			while (wait && result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(fence, 0, 1000000000);
+			if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+				break;
+
+			glDeleteSync(fence);
+			buffer.Fence = nullptr;
+			buffer.Encoding = true;
+			{
+				std::lock_guard<std::mutex> lock(m_QueueMutex);
+				m_Queue.push_back(index);
+			}
+			m_QueueCondition.notify_one();
+		}
+	}
+
+	void FrameCapture::CreateBuffers(uint32_t width, uint32_t height)
+	{
+		// Persistent coherent mapping lets the worker thread read frames without OpenGL calls
+		m_BufferSize = width * height * 4;
+		GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		for (PixelBuffer& buffer : m_Buffers)
+		{
+			glCreateBuffers(1, &buffer.RendererID);
+			glNamedBufferStorage(buffer.RendererID, m_BufferSize, nullptr, flags | GL_CLIENT_STORAGE_BIT);
+			buffer.MappedData = (uint8_t*)glMapNamedBufferRange(buffer.RendererID, 0, m_BufferSize, flags);
+		}
+		m_NextBuffer = 0;
+	}
+
+	void FrameCapture::DestroyBuffers()
+	{
+		for (PixelBuffer& buffer : m_Buffers)
+		{
+			if (!buffer.RendererID)
+				continue;
+
+			// Only after a failed wait, the copy never reaches the output
+			if (buffer.Fence)
+			{
+				PT_CORE_WARN("[FrameCapture] Frame {0} dropped, its copy did not complete", buffer.FrameIndex);
+				m_DroppedFrames++;
+				glDeleteSync((GLsync)buffer.Fence);
+				buffer.Fence = nullptr;
+			}
+			glUnmapNamedBuffer(buffer.RendererID);
+			glDeleteBuffers(1, &buffer.RendererID);
+			buffer.RendererID = 0;
+			buffer.MappedData = nullptr;
+		}
+		m_BufferSize = 0;
+	}
+
+	void FrameCapture::WorkerThread()
+	{
+		while (true)
+		{
+			uint32_t index;
+			{
+				std::unique_lock<std::mutex> lock(m_QueueMutex);
+				m_QueueCondition.wait(lock, [this]() { return m_StopWorker || !m_Queue.empty(); });
+				if (m_Queue.empty())
+					break;
+
+				index = m_Queue.front();
+				m_Queue.pop_front();
+			}
+
+			PixelBuffer& buffer = m_Buffers[index];
+			WriteFrame(buffer);
+			buffer.Encoding = false;
+		}
+
+		if (m_Pipe)
+		{
+			PT_PCLOSE(m_Pipe);
+			m_Pipe = nullptr;
+		}
+	}
+
+	void FrameCapture::WriteFrame(const PixelBuffer& buffer)
+	{
+		PROFILE_FUNCTION();
+
+		if (m_Format == FrameCaptureFormat::PNGSequence)
+		{
+			char filename[32];
+			snprintf(filename, sizeof(filename), "frame_%06u.png", buffer.FrameIndex);
+			std::string filepath = (std::filesystem::path(m_OutputPath) / filename).string();
+
+			FILE* file = fopen(filepath.c_str(), "wb");
+			if (!file)
+			{
+				PT_CORE_ERROR("[FrameCapture] Could not write '{0}'", filepath);
+				m_DroppedFrames++;
+				return;
+			}
+			Utils::WritePNG(file, buffer.MappedData, buffer.Width, buffer.Height, m_EncodeBuffer);
+			fclose(file);
+			return;
+		}
+
+		// Video resolution is fixed by the first frame
+		if (!m_Pipe)
+		{
+			char command[512];
+			snprintf(command, sizeof(command), "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgba -s %ux%u -r %u -i - "
+				"-vf vflip -c:v libx264 -pix_fmt yuv420p \"%s\"", buffer.Width, buffer.Height, m_FrameRate, m_OutputPath.c_str());
+			m_Pipe = PT_POPEN(command, "wb");
+			if (!m_Pipe)
+			{
+				PT_CORE_ERROR("[FrameCapture] Could not start encoder: {0}", command);
+				m_DroppedFrames++;
+				return;
+			}
+			m_PipeWidth = buffer.Width;
+			m_PipeHeight = buffer.Height;
+		}
+
+		if (buffer.Width != m_PipeWidth || buffer.Height != m_PipeHeight)
+		{
+			m_DroppedFrames++;
+			return;
+		}
+		fwrite(buffer.MappedData, 1, (size_t)buffer.Width * buffer.Height * 4, m_Pipe);
+	}
+
+}
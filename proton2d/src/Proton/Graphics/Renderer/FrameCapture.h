@@ -0,0 +1,91 @@
+//
+// Non-stalling frame capture.
+// Frames are copied into a ring of persistently mapped pixel pack buffers. A fence is inserted after
+// each copy and polled in the following frames, so the CPU never waits for the GPU. Signaled frames
+// are encoded and written by a worker thread directly from the mapped memory, either as a PNG sequence
+// or as raw frames piped to a local ffmpeg encoder. Frames are dropped when the ring is full, frames in
+// flight are waited for when the capture stops or the frame size grows.
+//
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+
+namespace proton {
+
+	enum class FrameCaptureFormat
+	{
+		PNGSequence = 0,
+		Video // raw RGBA frames piped to ffmpeg (must be in PATH)
+	};
+
+	class FrameCapture
+	{
+	public:
+		static constexpr uint32_t BufferCount = 4; // frames in flight
+
+		FrameCapture() = default;
+		virtual ~FrameCapture();
+
+		// Output is a directory for PNG sequences and a video file path (e.g. "capture.mp4") for video
+		bool Start(const std::string& outputPath, FrameCaptureFormat format, uint32_t frameRate = 60);
+		void Stop();
+		bool IsRecording() const { return m_Recording; }
+
+		// Queue a copy of the used region of a RGBA8 texture, call once per frame after rendering.
+		// Also hands the completed copies of previous frames to the worker thread.
+		void Capture(uint32_t textureID, uint32_t width, uint32_t height);
+
+		uint32_t GetCapturedFramesCount() const { return m_CapturedFrames; }
+		uint32_t GetDroppedFramesCount() const { return m_DroppedFrames.load(); }
+		float GetCaptureTime() const { return m_CaptureTime; } // ms of CPU time spent in the last Capture()
+
+	private:
+		struct PixelBuffer
+		{
+			uint32_t RendererID = 0;
+			uint8_t* MappedData = nullptr;
+			void* Fence = nullptr;
+			uint32_t Width = 0, Height = 0;
+			uint32_t FrameIndex = 0;
+
+			// Owned by the worker thread while encoding
+			std::atomic<bool> Encoding = false;
+		};
+
+		void CreateBuffers(uint32_t width, uint32_t height);
+		void DestroyBuffers();
+		void PollFences(bool wait);
+		void WorkerThread();
+		void WriteFrame(const PixelBuffer& buffer);
+
+	private:
+		PixelBuffer m_Buffers[BufferCount];
+		uint32_t m_BufferSize = 0;
+		uint32_t m_NextBuffer = 0;
+
+		FrameCaptureFormat m_Format = FrameCaptureFormat::PNGSequence;
+		std::string m_OutputPath;
+		uint32_t m_FrameRate = 60;
+		bool m_Recording = false;
+
+		// Worker thread state
+		FILE* m_Pipe = nullptr;
+		uint32_t m_PipeWidth = 0, m_PipeHeight = 0;
+		std::vector<uint8_t> m_EncodeBuffer;
+
+		std::thread m_Worker;
+		std::mutex m_QueueMutex;
+		std::condition_variable m_QueueCondition;
+		std::deque<uint32_t> m_Queue;
+		bool m_StopWorker = false;
+
+		uint32_t m_CapturedFrames = 0;
+		std::atomic<uint32_t> m_DroppedFrames = 0;
+		float m_CaptureTime = 0.0f;
+	};
+
+}
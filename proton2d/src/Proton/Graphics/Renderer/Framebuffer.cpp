@@ -5,6 +5,7 @@
 //
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/Framebuffer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 
 #include <glad/glad.h>
 
@@ -12,6 +13,12 @@ namespace proton {
 
 	static const uint32_t s_MaxFramebufferSize = 8192;
 
+	// Resize hysteresis: grow with 25% headroom rounded up to the granularity, shrink only when
+	// less than half of the allocated size is used
+	static const uint32_t s_FramebufferSizeGranularity = 64;
+	static const float s_FramebufferGrowFactor = 1.25f;
+	static const float s_FramebufferShrinkThreshold = 0.5f;
+
 	namespace Utils {
 
 		static GLenum TextureTarget(bool multisampled)
@@ -86,6 +93,7 @@ namespace proton {
 			switch (format)
 			{
 			case FramebufferTextureFormat::RGBA8:       return GL_RGBA8;
+			case FramebufferTextureFormat::RGBA16F:     return GL_RGBA16F;
 			case FramebufferTextureFormat::RED_INTEGER: return GL_RED_INTEGER;
 			}
 
@@ -96,7 +104,7 @@ namespace proton {
 	}
 
 	Framebuffer::Framebuffer(const FramebufferSpecification& spec)
-		: m_Specification(spec)
+		: m_Specification(spec), m_AllocatedWidth(spec.Width), m_AllocatedHeight(spec.Height)
 	{
 		for (auto spec : m_Specification.Attachments.Attachments)
 		{
@@ -111,6 +119,11 @@ namespace proton {
 
 	Framebuffer::~Framebuffer()
 	{
+		GLState::OnFramebufferDeleted(m_RendererID);
+		for (uint32_t attachment : m_ColorAttachments)
+			GLState::OnTextureDeleted(attachment);
+		GLState::OnTextureDeleted(m_DepthAttachment);
+
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
@@ -145,10 +158,13 @@ namespace proton {
 				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
 				{
 				case FramebufferTextureFormat::RGBA8:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_Specification.Width, m_Specification.Height, (int)i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_AllocatedWidth, m_AllocatedHeight, (int)i);
+					break;
+				case FramebufferTextureFormat::RGBA16F:
+					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA16F, GL_RGBA, m_AllocatedWidth, m_AllocatedHeight, (int)i);
 					break;
 				case FramebufferTextureFormat::RED_INTEGER:
-					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_Specification.Width, m_Specification.Height, (int)i);
+					Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_AllocatedWidth, m_AllocatedHeight, (int)i);
 					break;
 				}
 			}
@@ -161,7 +177,7 @@ namespace proton {
 			switch (m_DepthAttachmentSpecification.TextureFormat)
 			{
 			case FramebufferTextureFormat::DEPTH24STENCIL8:
-				Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Specification.Width, m_Specification.Height);
+				Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_AllocatedWidth, m_AllocatedHeight);
 				break;
 			}
 		}
@@ -181,17 +197,20 @@ namespace proton {
 		PT_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// Attachments were created with non-DSA binds and old names may be reused
+		GLState::Invalidate();
 	}
 
 	void Framebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		GLState::BindFramebuffer(m_RendererID);
+		GLState::SetViewport(0, 0, m_Specification.Width, m_Specification.Height);
 	}
 
 	void Framebuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::BindFramebuffer(0);
 	}
 
 	void Framebuffer::Resize(uint32_t width, uint32_t height)
@@ -204,6 +223,20 @@ namespace proton {
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
+		bool fits = width <= m_AllocatedWidth && height <= m_AllocatedHeight;
+		bool wasteful = width < m_AllocatedWidth * s_FramebufferShrinkThreshold || height < m_AllocatedHeight * s_FramebufferShrinkThreshold;
+		if (fits && !wasteful)
+			return;
+
+		auto allocationSize = [](uint32_t size)
+		{
+			uint32_t grown = (uint32_t)(size * s_FramebufferGrowFactor);
+			grown = (grown + s_FramebufferSizeGranularity - 1) / s_FramebufferSizeGranularity * s_FramebufferSizeGranularity;
+			return grown < s_MaxFramebufferSize ? grown : s_MaxFramebufferSize;
+		};
+		m_AllocatedWidth = allocationSize(width);
+		m_AllocatedHeight = allocationSize(height);
+
 		Invalidate();
 	}
 
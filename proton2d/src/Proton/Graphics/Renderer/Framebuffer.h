@@ -13,6 +13,7 @@ namespace proton {
 
 		// Color
 		RGBA8,
+		RGBA16F,
 		RED_INTEGER,
 
 		// Depth/stencil
@@ -61,6 +62,8 @@ namespace proton {
 		void Bind();
 		void Unbind();
 
+		// Attachments are over-allocated with hysteresis, so most resizes only change the used
+		// region (Width/Height of the specification) and Bind() restricts the viewport to it
 		void Resize(uint32_t width, uint32_t height);
 		int ReadPixel(uint32_t attachmentIndex, int x, int y);
 
@@ -69,9 +72,12 @@ namespace proton {
 		uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const { PT_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
 
 		const FramebufferSpecification& GetSpecification() const { return m_Specification; }
+		uint32_t GetAllocatedWidth() const { return m_AllocatedWidth; }
+		uint32_t GetAllocatedHeight() const { return m_AllocatedHeight; }
 	private:
 		uint32_t m_RendererID = 0;
 		FramebufferSpecification m_Specification;
+		uint32_t m_AllocatedWidth = 0, m_AllocatedHeight = 0;
 
 		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
 		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
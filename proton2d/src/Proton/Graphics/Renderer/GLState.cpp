@@ -0,0 +1,280 @@
+//
+// Redundant OpenGL state elimination.
+// Thin cache in front of the state changing OpenGL calls made by the renderer objects
+// (Texture, Shader, VertexArray, Framebuffer, UniformBuffer...). Calls that would not change
+// the current state are skipped and counted. Code changing GL state behind the cache
+// (e.g. ImGui backend) must be followed by GLState::Invalidate().
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/GLState.h"
+#include "Proton/Core/Application.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <thread>
+
+namespace proton {
+
+	// Statics are initialized on the main thread, which owns the GL context
+	static const std::thread::id s_ContextThreadID = std::this_thread::get_id();
+
+	static constexpr uint32_t s_Unknown = 0xffffffff;
+	static constexpr uint32_t s_MaxCachedTextureUnits = 32;
+	static constexpr uint32_t s_MaxCachedBufferBindings = 8;
+
+	enum class TriState : uint8_t
+	{
+		Unknown, Disabled, Enabled
+	};
+
+	static struct GLStateCache
+	{
+		uint32_t Program = s_Unknown;
+		uint32_t VertexArray = s_Unknown;
+		uint32_t ArrayBuffer = s_Unknown;
+		uint32_t UniformBuffers[s_MaxCachedBufferBindings];
+		uint32_t StorageBuffers[s_MaxCachedBufferBindings];
+		uint32_t TextureUnits[s_MaxCachedTextureUnits];
+		uint32_t Framebuffer = s_Unknown;
+
+		bool ViewportKnown = false;
+		int Viewport[4] = { 0, 0, 0, 0 };
+		TriState Blending = TriState::Unknown;
+		TriState DepthTest = TriState::Unknown;
+		uint32_t BlendFunc[4] = { s_Unknown, s_Unknown, s_Unknown, s_Unknown };
+		float LineWidth = -1.0f;
+
+		// Stats
+		uint32_t IssuedCalls = 0;
+		uint32_t SkippedCalls = 0;
+		uint32_t LastIssuedCalls = 0;
+		uint32_t LastSkippedCalls = 0;
+	} s_Cache;
+
+	// Returns true if the call has to be issued
+	template<typename T>
+	static bool Update(T& cached, const T& value)
+	{
+		if (cached == value)
+		{
+			s_Cache.SkippedCalls++;
+			return false;
+		}
+
+		cached = value;
+		s_Cache.IssuedCalls++;
+		return true;
+	}
+
+	static void Forget(uint32_t* names, uint32_t count, uint32_t name)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (names[i] == name)
+				names[i] = s_Unknown;
+		}
+	}
+
+	void GLState::NewFrame()
+	{
+		s_Cache.LastIssuedCalls = s_Cache.IssuedCalls;
+		s_Cache.LastSkippedCalls = s_Cache.SkippedCalls;
+		s_Cache.IssuedCalls = 0;
+		s_Cache.SkippedCalls = 0;
+		Invalidate();
+	}
+
+	void GLState::Invalidate()
+	{
+		s_Cache.Program = s_Unknown;
+		s_Cache.VertexArray = s_Unknown;
+		s_Cache.ArrayBuffer = s_Unknown;
+		s_Cache.Framebuffer = s_Unknown;
+		std::fill_n(s_Cache.UniformBuffers, s_MaxCachedBufferBindings, s_Unknown);
+		std::fill_n(s_Cache.StorageBuffers, s_MaxCachedBufferBindings, s_Unknown);
+		std::fill_n(s_Cache.TextureUnits, s_MaxCachedTextureUnits, s_Unknown);
+		std::fill_n(s_Cache.BlendFunc, 4, s_Unknown);
+
+		s_Cache.ViewportKnown = false;
+		s_Cache.Blending = TriState::Unknown;
+		s_Cache.DepthTest = TriState::Unknown;
+		s_Cache.LineWidth = -1.0f;
+	}
+
+	void GLState::UseProgram(uint32_t program)
+	{
+		if (Update(s_Cache.Program, program))
+			glUseProgram(program);
+	}
+
+	void GLState::BindVertexArray(uint32_t vertexArray)
+	{
+		if (Update(s_Cache.VertexArray, vertexArray))
+			glBindVertexArray(vertexArray);
+	}
+
+	void GLState::BindArrayBuffer(uint32_t buffer)
+	{
+		if (Update(s_Cache.ArrayBuffer, buffer))
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+	}
+
+	void GLState::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+	{
+		uint32_t* bindings = nullptr;
+		if (target == GL_UNIFORM_BUFFER)
+			bindings = s_Cache.UniformBuffers;
+		else if (target == GL_SHADER_STORAGE_BUFFER)
+			bindings = s_Cache.StorageBuffers;
+
+		if (!bindings || index >= s_MaxCachedBufferBindings)
+		{
+			s_Cache.IssuedCalls++;
+			glBindBufferBase(target, index, buffer);
+			return;
+		}
+
+		if (Update(bindings[index], buffer))
+			glBindBufferBase(target, index, buffer);
+	}
+
+	void GLState::BindTextureUnit(uint32_t unit, uint32_t texture)
+	{
+		if (unit >= s_MaxCachedTextureUnits)
+		{
+			s_Cache.IssuedCalls++;
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (Update(s_Cache.TextureUnits[unit], texture))
+			glBindTextureUnit(unit, texture);
+	}
+
+	void GLState::BindFramebuffer(uint32_t framebuffer)
+	{
+		if (Update(s_Cache.Framebuffer, framebuffer))
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	}
+
+	uint32_t GLState::GetBoundFramebuffer()
+	{
+		if (s_Cache.Framebuffer == s_Unknown)
+		{
+			GLint framebuffer = 0;
+			glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+			s_Cache.Framebuffer = (uint32_t)framebuffer;
+		}
+		return s_Cache.Framebuffer;
+	}
+
+	void GLState::SetViewport(int x, int y, int width, int height)
+	{
+		int* viewport = s_Cache.Viewport;
+		if (s_Cache.ViewportKnown && viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height)
+		{
+			s_Cache.SkippedCalls++;
+			return;
+		}
+
+		s_Cache.ViewportKnown = true;
+		viewport[0] = x;
+		viewport[1] = y;
+		viewport[2] = width;
+		viewport[3] = height;
+		s_Cache.IssuedCalls++;
+		glViewport(x, y, width, height);
+	}
+
+	void GLState::SetBlending(bool enabled)
+	{
+		if (!Update(s_Cache.Blending, enabled ? TriState::Enabled : TriState::Disabled))
+			return;
+
+		if (enabled)
+			glEnable(GL_BLEND);
+		else
+			glDisable(GL_BLEND);
+	}
+
+	void GLState::SetBlendFunc(uint32_t srcRGB, uint32_t dstRGB, uint32_t srcAlpha, uint32_t dstAlpha)
+	{
+		uint32_t* func = s_Cache.BlendFunc;
+		if (func[0] == srcRGB && func[1] == dstRGB && func[2] == srcAlpha && func[3] == dstAlpha)
+		{
+			s_Cache.SkippedCalls++;
+			return;
+		}
+
+		func[0] = srcRGB;
+		func[1] = dstRGB;
+		func[2] = srcAlpha;
+		func[3] = dstAlpha;
+		s_Cache.IssuedCalls++;
+		glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+	}
+
+	void GLState::SetDepthTest(bool enabled)
+	{
+		if (!Update(s_Cache.DepthTest, enabled ? TriState::Enabled : TriState::Disabled))
+			return;
+
+		if (enabled)
+			glEnable(GL_DEPTH_TEST);
+		else
+			glDisable(GL_DEPTH_TEST);
+	}
+
+	void GLState::SetLineWidth(float width)
+	{
+		if (Update(s_Cache.LineWidth, width))
+			glLineWidth(width);
+	}
+
+	void GLState::OnProgramDeleted(uint32_t program)
+	{
+		Forget(&s_Cache.Program, 1, program);
+	}
+
+	void GLState::OnVertexArrayDeleted(uint32_t vertexArray)
+	{
+		Forget(&s_Cache.VertexArray, 1, vertexArray);
+	}
+
+	void GLState::OnBufferDeleted(uint32_t buffer)
+	{
+		Forget(&s_Cache.ArrayBuffer, 1, buffer);
+		Forget(s_Cache.UniformBuffers, s_MaxCachedBufferBindings, buffer);
+		Forget(s_Cache.StorageBuffers, s_MaxCachedBufferBindings, buffer);
+	}
+
+	void GLState::OnTextureDeleted(uint32_t texture)
+	{
+		Forget(s_Cache.TextureUnits, s_MaxCachedTextureUnits, texture);
+	}
+
+	void GLState::OnFramebufferDeleted(uint32_t framebuffer)
+	{
+		Forget(&s_Cache.Framebuffer, 1, framebuffer);
+	}
+
+	uint32_t GLState::GetIssuedCallsCount()
+	{
+		return s_Cache.LastIssuedCalls;
+	}
+
+	uint32_t GLState::GetSkippedCallsCount()
+	{
+		return s_Cache.LastSkippedCalls;
+	}
+
+	bool GLState::DeferDeletion(const char* name, std::function<void()> deletion)
+	{
+		if (std::this_thread::get_id() == s_ContextThreadID)
+			return false;
+
+		Application::Get().GetJobSystem().RunOnMainThread(name, std::move(deletion));
+		return true;
+	}
+
+}
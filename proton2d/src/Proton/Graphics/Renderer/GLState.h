@@ -0,0 +1,51 @@
+//
+// Redundant OpenGL state elimination.
+// Thin cache in front of the state changing OpenGL calls made by the renderer objects
+// (Texture, Shader, VertexArray, Framebuffer, UniformBuffer...). Calls that would not change
+// the current state are skipped and counted. Code changing GL state behind the cache
+// (e.g. ImGui backend) must be followed by GLState::Invalidate().
+//
+#pragma once
+
+#include <functional>
+
+namespace proton {
+
+	class GLState
+	{
+	public:
+		// Forget all tracked state and start counting calls of a new frame
+		static void NewFrame();
+		static void Invalidate();
+
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertexArray);
+		static void BindArrayBuffer(uint32_t buffer);
+		static void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+		static void BindTextureUnit(uint32_t unit, uint32_t texture);
+		static void BindFramebuffer(uint32_t framebuffer);
+		static uint32_t GetBoundFramebuffer();
+
+		static void SetViewport(int x, int y, int width, int height);
+		static void SetBlending(bool enabled);
+		static void SetBlendFunc(uint32_t srcRGB, uint32_t dstRGB, uint32_t srcAlpha, uint32_t dstAlpha);
+		static void SetDepthTest(bool enabled);
+		static void SetLineWidth(float width);
+
+		// Deleted object names can be reused by OpenGL, so they must not stay cached
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertexArray);
+		static void OnBufferDeleted(uint32_t buffer);
+		static void OnTextureDeleted(uint32_t texture);
+		static void OnFramebufferDeleted(uint32_t framebuffer);
+
+		// Objects released by other threads (scene destroyed on a worker, see SceneManager::Unload) have no context.
+		// Returns true if the deletion was queued to the main thread, the caller must not call OpenGL then.
+		static bool DeferDeletion(const char* name, std::function<void()> deletion);
+
+		// Stats of the last frame
+		static uint32_t GetIssuedCallsCount();
+		static uint32_t GetSkippedCallsCount();
+	};
+
+}
@@ -0,0 +1,65 @@
+//
+// This file provides GPU time measurement using OpenGL timer queries.
+// Queries are kept in a small ring and their results are read back a few frames later,
+// so measuring never stalls the CPU waiting for the GPU.
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/GPUTimer.h"
+
+#include <glad/glad.h>
+
+namespace proton {
+
+	GPUTimer::GPUTimer()
+	{
+		glCreateQueries(GL_TIME_ELAPSED, QueryCount, m_Queries);
+	}
+
+	GPUTimer::~GPUTimer()
+	{
+		glDeleteQueries(QueryCount, m_Queries);
+	}
+
+	void GPUTimer::Begin()
+	{
+		// Skip measurement if the oldest query is still in flight
+		if (m_QueryPending[m_QueryIndex])
+			return;
+
+		glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_QueryIndex]);
+		m_Measuring = true;
+	}
+
+	void GPUTimer::End()
+	{
+		if (!m_Measuring)
+			return;
+
+		glEndQuery(GL_TIME_ELAPSED);
+		m_QueryPending[m_QueryIndex] = true;
+		m_QueryIndex = (m_QueryIndex + 1) % QueryCount;
+		m_Measuring = false;
+	}
+
+	bool GPUTimer::PollResult(float& outMilliseconds)
+	{
+		bool hasResult = false;
+		while (m_QueryPending[m_ResultIndex])
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(m_Queries[m_ResultIndex], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				break;
+
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(m_Queries[m_ResultIndex], GL_QUERY_RESULT, &nanoseconds);
+			outMilliseconds = (float)(nanoseconds / 1.0e6);
+			hasResult = true;
+
+			m_QueryPending[m_ResultIndex] = false;
+			m_ResultIndex = (m_ResultIndex + 1) % QueryCount;
+		}
+		return hasResult;
+	}
+
+}
@@ -0,0 +1,32 @@
+//
+// This file provides GPU time measurement using OpenGL timer queries.
+// Queries are kept in a small ring and their results are read back a few frames later,
+// so measuring never stalls the CPU waiting for the GPU.
+//
+#pragma once
+
+namespace proton {
+
+	class GPUTimer
+	{
+	public:
+		static constexpr uint32_t QueryCount = 4; // frames in flight
+
+		GPUTimer();
+		virtual ~GPUTimer();
+
+		// Timer queries cannot be nested, only one GPUTimer can be measuring at a time
+		void Begin();
+		void End();
+
+		// Returns true and writes the elapsed time (ms) if a new result became available since the last call
+		bool PollResult(float& outMilliseconds);
+
+	private:
+		uint32_t m_Queries[QueryCount] = {};
+		bool m_QueryPending[QueryCount] = {};
+		uint32_t m_QueryIndex = 0;
+		uint32_t m_ResultIndex = 0;
+		bool m_Measuring = false;
+	};
+}
@@ -0,0 +1,144 @@
+//
+// Tiled light culling for 2D point lights.
+// Lights are culled against the view and binned into screen space tiles on the CPU,
+// Quad2D fragment shader then iterates only the lights affecting its tile.
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/LightGrid.h"
+#include "Proton/Graphics/Renderer/RendererBackend.h"
+
+namespace proton {
+
+	void LightGrid::Begin(const glm::mat4& viewProjection, const glm::uvec4& viewport)
+	{
+		SetView(viewProjection, viewport);
+		m_Enabled = false;
+		m_SubmittedLights.clear();
+	}
+
+	void LightGrid::SetView(const glm::mat4& viewProjection, const glm::uvec4& viewport)
+	{
+		m_ViewProjection = viewProjection;
+		m_Viewport = viewport;
+		m_TileCount = (glm::uvec2(viewport.z, viewport.w) + TileSize - 1u) / TileSize;
+		m_Dirty = true;
+	}
+
+	void LightGrid::SetAmbientLight(bool enabled, const glm::vec4& ambientColor)
+	{
+		m_Enabled = enabled;
+		m_AmbientColor = ambientColor;
+		m_Dirty = true;
+	}
+
+	void LightGrid::Submit(const glm::vec2& position, float radius, const glm::vec3& color, float intensity)
+	{
+		Submit({ { position, radius, 0.0f }, { color, intensity } });
+	}
+
+	void LightGrid::Submit(const PointLightData& light)
+	{
+		if (!m_Enabled || light.PositionRadius.z <= 0.0f || light.ColorIntensity.a <= 0.0f)
+			return;
+
+		m_SubmittedLights.push_back(light);
+		m_Dirty = true;
+	}
+
+	void LightGrid::CullLights()
+	{
+		m_Lights.clear();
+		m_LightTileRects.clear();
+		if (!m_TileCount.x || !m_TileCount.y)
+			return;
+
+		glm::vec2 viewport = { (float)m_Viewport.z, (float)m_Viewport.w };
+		for (const PointLightData& light : m_SubmittedLights)
+		{
+			glm::vec2 position = glm::vec2(light.PositionRadius);
+			float radius = light.PositionRadius.z;
+
+			// Project light bounding box to viewport coordinates
+			glm::vec4 min = m_ViewProjection * glm::vec4(position.x - radius, position.y - radius, 0.0f, 1.0f);
+			glm::vec4 max = m_ViewProjection * glm::vec4(position.x + radius, position.y + radius, 0.0f, 1.0f);
+			glm::vec2 screenMin = (glm::vec2(min) * 0.5f + 0.5f) * viewport;
+			glm::vec2 screenMax = (glm::vec2(max) * 0.5f + 0.5f) * viewport;
+
+			// Cull against the view
+			if (screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x >= viewport.x || screenMin.y >= viewport.y)
+				continue;
+
+			glm::uvec2 tileMin = glm::uvec2(glm::max(screenMin, glm::vec2(0.0f))) / TileSize;
+			glm::uvec2 tileMax = glm::min(glm::uvec2(screenMax) / TileSize, m_TileCount - 1u);
+
+			m_Lights.push_back(light);
+			m_LightTileRects.push_back({ tileMin, tileMax });
+		}
+	}
+
+	void LightGrid::Upload(RendererBackend& backend)
+	{
+		if (!m_Dirty)
+			return;
+
+		PROFILE_FUNCTION();
+		if (!m_Enabled)
+		{
+			// Shader skips lighting, only the header has to be uploaded
+			m_Lights.clear();
+			m_LightTileRects.clear();
+			m_TileLightRanges.clear();
+			m_TileLightIndices.clear();
+
+			LightGridHeader header;
+			header.Info = { m_TileCount.x, m_TileCount.y, TileSize, 0 };
+			header.Viewport = glm::ivec4(m_Viewport);
+			header.AmbientColor = m_AmbientColor;
+			backend.UploadLightGrid(header, m_Lights, m_TileLightRanges, m_TileLightIndices);
+			m_Dirty = false;
+			return;
+		}
+
+		CullLights();
+
+		uint32_t tileCount = GetTileCount();
+		m_TileLightRanges.assign(tileCount, { 0, 0 });
+
+		// Count lights per tile
+		for (const glm::uvec4& rect : m_LightTileRects)
+			for (uint32_t y = rect.y; y <= rect.w; y++)
+				for (uint32_t x = rect.x; x <= rect.z; x++)
+					m_TileLightRanges[y * m_TileCount.x + x].y++;
+
+		// Prefix sum to get per-tile offsets into indices list
+		uint32_t offset = 0;
+		for (glm::uvec2& range : m_TileLightRanges)
+		{
+			range.x = offset;
+			offset += range.y;
+			range.y = 0;
+		}
+
+		// Fill tile light lists
+		m_TileLightIndices.resize(offset);
+		for (uint32_t i = 0; i < (uint32_t)m_LightTileRects.size(); i++)
+		{
+			const glm::uvec4& rect = m_LightTileRects[i];
+			for (uint32_t y = rect.y; y <= rect.w; y++)
+				for (uint32_t x = rect.x; x <= rect.z; x++)
+				{
+					glm::uvec2& range = m_TileLightRanges[y * m_TileCount.x + x];
+					m_TileLightIndices[range.x + range.y++] = i;
+				}
+		}
+
+		LightGridHeader header;
+		header.Info = { m_TileCount.x, m_TileCount.y, TileSize, m_Enabled && tileCount ? 1 : 0 };
+		header.Viewport = glm::ivec4(m_Viewport);
+		header.AmbientColor = m_AmbientColor;
+		backend.UploadLightGrid(header, m_Lights, m_TileLightRanges, m_TileLightIndices);
+
+		m_Dirty = false;
+	}
+
+}
@@ -0,0 +1,84 @@
+//
+// Tiled light culling for 2D point lights.
+// Lights are culled against the view and binned into screen space tiles on the CPU,
+// Quad2D fragment shader then iterates only the lights affecting its tile.
+//
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	class RendererBackend;
+
+	// Shader storage buffer data (std430)
+	struct PointLightData
+	{
+		glm::vec4 PositionRadius; // xy: world position, z: radius
+		glm::vec4 ColorIntensity; // rgb: color, a: intensity
+	};
+
+	// Light grid buffer header (std430), followed by per-tile uvec2 ranges
+	struct LightGridHeader
+	{
+		glm::ivec4 Info; // x: tile count x, y: tile count y, z: tile size, w: lighting enabled
+		glm::ivec4 Viewport;
+		glm::vec4 AmbientColor;
+	};
+
+	class LightGrid
+	{
+	public:
+		static constexpr uint32_t TileSize = 32; // pixels
+
+		LightGrid() = default;
+		~LightGrid() = default;
+
+		// Reset submitted lights and set the view used for culling.
+		// Viewport is (x, y, width, height) in window coordinates.
+		void Begin(const glm::mat4& viewProjection, const glm::uvec4& viewport);
+		void SetAmbientLight(bool enabled, const glm::vec4& ambientColor);
+
+		// Change the view but keep submitted lights (multi-view rendering)
+		void SetView(const glm::mat4& viewProjection, const glm::uvec4& viewport);
+
+		void Submit(const glm::vec2& position, float radius, const glm::vec3& color, float intensity);
+		void Submit(const PointLightData& light);
+
+		// Cull submitted lights against the view, bin visible lights into tiles and upload
+		// light lists through the backend. Does nothing if neither the view nor lights changed since the last upload.
+		void Upload(RendererBackend& backend);
+
+		const std::vector<PointLightData>& GetSubmittedLights() const { return m_SubmittedLights; }
+		bool IsEnabled() const { return m_Enabled; }
+		const glm::vec4& GetAmbientColor() const { return m_AmbientColor; }
+
+		uint32_t GetSubmittedLightsCount() const { return (uint32_t)m_SubmittedLights.size(); }
+		uint32_t GetVisibleLightsCount() const { return (uint32_t)m_Lights.size(); }
+		uint32_t GetTileCount() const { return m_TileCount.x * m_TileCount.y; }
+
+	private:
+		void CullLights();
+
+	private:
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		glm::uvec4 m_Viewport = { 0, 0, 0, 0 };
+		glm::uvec2 m_TileCount = { 0, 0 };
+
+		bool m_Enabled = false;
+		glm::vec4 m_AmbientColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		// All lights submitted this frame, visible lights and their tile rect (min xy, max xy)
+		std::vector<PointLightData> m_SubmittedLights;
+		std::vector<PointLightData> m_Lights;
+		std::vector<glm::uvec4> m_LightTileRects;
+
+		// Per-tile (offset, count) into m_TileLightIndices
+		std::vector<glm::uvec2> m_TileLightRanges;
+		std::vector<uint32_t> m_TileLightIndices;
+		bool m_Dirty = true;
+	};
+
+}
@@ -0,0 +1,51 @@
+//
+// Renderer backend that discards everything.
+// Renderer still batches and culls on the CPU, so the CPU cost of submission can be
+// measured without a GPU context.
+//
+#pragma once
+
+#include "Proton/Graphics/Renderer/RendererBackend.h"
+
+namespace proton {
+
+	class NullRendererBackend : public RendererBackend
+	{
+	public:
+		virtual RendererBackendType GetType() const override { return RendererBackendType::Null; }
+
+		virtual void Init(uint32_t maxQuads) override {}
+		virtual void Shutdown() override {}
+		virtual uint32_t GetMaxTextureSlots() const override { return 32; }
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override { m_Viewport = { x, y, width, height }; }
+		virtual glm::uvec4 GetViewport() const override { return m_Viewport; }
+		virtual void SetClearColor(const glm::vec4& color) override {}
+		virtual void Clear() override {}
+		virtual void SetDepthTest(bool enabled) override {}
+		virtual void SetBlendMode(RendererBlendMode mode) override {}
+		virtual void SetCamera(const glm::mat4& viewProjection) override {}
+		virtual void UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+			const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices) override {}
+
+		virtual void DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount) override {}
+		virtual void DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth) override {}
+		virtual void DrawCircles(const CircleVertex* vertices, uint32_t circleCount) override {}
+
+		virtual void UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles) override {}
+		virtual void DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+			const Shared<Texture>* textures, uint32_t textureCount, float lineWidth) override {}
+
+		virtual void DrawQuadMesh(QuadMesh& mesh) override {}
+
+		virtual void BeginRenderTarget(const Shared<Texture>& target) override {}
+		virtual void EndRenderTarget() override {}
+
+		virtual void SetDebugMode(RendererDebugMode mode) override {}
+		virtual void ResolveOverdraw(uint32_t countTextureID) override {}
+
+	private:
+		glm::uvec4 m_Viewport = { 0, 0, 0, 0 };
+	};
+
+}
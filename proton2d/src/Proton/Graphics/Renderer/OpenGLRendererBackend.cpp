@@ -0,0 +1,447 @@
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/OpenGLRendererBackend.h"
+
+#include "Proton/Graphics/Renderer/Shader.h"
+#include "Proton/Graphics/Renderer/UniformBuffer.h"
+#include "Proton/Graphics/Renderer/StorageBuffer.h"
+#include "Proton/Graphics/Renderer/VertexArray.h"
+#include "Proton/Graphics/Renderer/Texture.h"
+#include "Proton/Graphics/Renderer/GLState.h"
+
+#include <glad/glad.h>
+
+namespace proton {
+
+	// Shader storage buffer bindings (see Quad2D.glsl.frag)
+	static constexpr uint32_t s_LightsBinding = 1;
+	static constexpr uint32_t s_LightGridBinding = 2;
+	static constexpr uint32_t s_LightIndicesBinding = 3;
+
+	static void OpenGLMessageCallback(unsigned source, unsigned type, unsigned id, unsigned severity, int length, const char* message, const void* userParam)
+	{
+		switch (severity)
+		{
+		case GL_DEBUG_SEVERITY_HIGH:          PT_CORE_CRITICAL("[OpenGL] {}", message); return;
+		case GL_DEBUG_SEVERITY_MEDIUM:        PT_CORE_WARN("[OpenGL] {}", message); return;
+		case GL_DEBUG_SEVERITY_LOW:           PT_CORE_WARN("[OpenGL] {}", message); return;
+		case GL_DEBUG_SEVERITY_NOTIFICATION:  PT_CORE_INFO("[OpenGL] {}", message); return;
+		}
+	}
+
+	OpenGLRendererBackend::~OpenGLRendererBackend() = default;
+
+	void OpenGLRendererBackend::Init(uint32_t maxQuads)
+	{
+#	ifdef PROTON_DEBUG
+		glEnable(GL_DEBUG_OUTPUT);
+		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+		glDebugMessageCallback(OpenGLMessageCallback, nullptr);
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+#	endif
+
+		GLState::Invalidate();
+		GLState::SetBlending(true);
+		GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		GLState::SetDepthTest(true);
+		glEnable(GL_LINE_SMOOTH);
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (int*)&m_MaxTextureSlots);
+
+		uint32_t maxVertices = maxQuads * 4;
+		uint32_t maxIndices = maxQuads * 6;
+
+		// Create quad vertex buffer
+		m_QuadVertexBuffer = MakeShared<VertexBuffer>((uint32_t)(maxVertices * sizeof(QuadVertex)));
+		m_QuadVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "Position"      },
+			{ ShaderDataType::Float4, "Color"         },
+			{ ShaderDataType::Float2, "TextureCoords" },
+			{ ShaderDataType::Float,  "TextureIndex"  },
+			{ ShaderDataType::Float,  "TilingFactor"  }
+		});
+
+		// Create quad index buffer data
+		uint32_t* indicies = new uint32_t[maxIndices];
+
+		for (uint32_t i = 0; i < maxIndices; i++)
+		{
+			uint32_t offset = 4 * (i / 6);
+			constexpr uint32_t quadIndices[] = { 0, 1, 2, 2, 3, 0 };
+			indicies[i] = offset + quadIndices[i % 6];
+		}
+
+		// Create quad vertex array
+		m_QuadVertexArray = MakeShared<VertexArray>();
+		m_QuadVertexArray->AddVertexBuffer(m_QuadVertexBuffer);
+		m_QuadIndexBuffer = MakeShared<IndexBuffer>(indicies, maxIndices);
+		m_QuadVertexArray->SetIndexBuffer(m_QuadIndexBuffer);
+		delete[] indicies;
+
+		// Create line vertex buffer and vertex array
+		m_LineVertexBuffer = MakeShared<VertexBuffer>(maxVertices * (uint32_t)sizeof(LineVertex));
+		m_LineVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "Position" },
+			{ ShaderDataType::Float4, "Color"    }
+		});
+		m_LineVertexArray = MakeShared<VertexArray>();
+		m_LineVertexArray->AddVertexBuffer(m_LineVertexBuffer);
+
+		// Circles
+		m_CircleVertexArray = MakeShared<VertexArray>();
+		m_CircleVertexBuffer = MakeShared<VertexBuffer>(maxVertices * (uint32_t)sizeof(CircleVertex));
+		m_CircleVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "WorldPosition" },
+			{ ShaderDataType::Float3, "LocalPosition" },
+			{ ShaderDataType::Float4, "Color"         },
+			{ ShaderDataType::Float,  "Thickness"     },
+			{ ShaderDataType::Float,  "Fade"          }
+		});
+		m_CircleVertexArray->AddVertexBuffer(m_CircleVertexBuffer);
+		m_CircleVertexArray->SetIndexBuffer(m_QuadIndexBuffer); // Use quad IB
+
+		m_WhiteTexture = MakeShared<Texture>(1, 1, true);
+
+		// Shaders
+		m_QuadShader = MakeShared<Shader>("content/shaders/Quad2D.glsl");
+		m_LineShader = MakeShared<Shader>("content/shaders/Line2D.glsl");
+		m_CircleShader = MakeShared<Shader>("content/shaders/Circle2D.glsl");
+
+		// Camera shader uniform buffer
+		m_CameraUniformBuffer = MakeShared<UniformBuffer>((uint32_t)sizeof(glm::mat4), 0);
+
+		// Point lights tile grid
+		m_LightsBuffer = MakeUnique<StorageBuffer>((uint32_t)sizeof(PointLightData) * 64, s_LightsBinding);
+		m_LightGridBuffer = MakeUnique<StorageBuffer>((uint32_t)sizeof(LightGridHeader) + 4096 * (uint32_t)sizeof(glm::uvec2), s_LightGridBinding);
+		m_LightIndicesBuffer = MakeUnique<StorageBuffer>((uint32_t)sizeof(uint32_t) * 4096, s_LightIndicesBinding);
+	}
+
+	void OpenGLRendererBackend::Shutdown()
+	{
+		m_FrameQuads = FrameVertexBuffer();
+		m_FrameLines = FrameVertexBuffer();
+		m_FrameCircles = FrameVertexBuffer();
+		m_LightsBuffer.reset();
+		m_LightGridBuffer.reset();
+		m_LightIndicesBuffer.reset();
+
+		for (Shared<Shader>& shader : m_QuadDebugShaders)
+			shader.reset();
+		m_OverdrawResolveShader.reset();
+		GLState::OnVertexArrayDeleted(m_EmptyVertexArray);
+		glDeleteVertexArrays(1, &m_EmptyVertexArray);
+		m_EmptyVertexArray = 0;
+
+		GLState::OnFramebufferDeleted(m_RenderTargetFramebuffer);
+		glDeleteFramebuffers(1, &m_RenderTargetFramebuffer);
+		glDeleteRenderbuffers(1, &m_RenderTargetDepthBuffer);
+		m_RenderTargetFramebuffer = 0;
+		m_RenderTargetDepthBuffer = 0;
+	}
+
+	void OpenGLRendererBackend::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		GLState::SetViewport(x, y, width, height);
+	}
+
+	glm::uvec4 OpenGLRendererBackend::GetViewport() const
+	{
+		int viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		return { (uint32_t)viewport[0], (uint32_t)viewport[1], (uint32_t)viewport[2], (uint32_t)viewport[3] };
+	}
+
+	void OpenGLRendererBackend::SetClearColor(const glm::vec4& color)
+	{
+		glClearColor(color.r, color.g, color.b, color.a);
+	}
+
+	void OpenGLRendererBackend::Clear()
+	{
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	void OpenGLRendererBackend::SetDepthTest(bool enabled)
+	{
+		// Overdraw counts every layer, also the ones hidden by depth
+		m_DepthTest = enabled;
+		GLState::SetDepthTest(enabled && GetActiveDebugMode() != RendererDebugMode::Overdraw);
+	}
+
+	void OpenGLRendererBackend::SetCamera(const glm::mat4& viewProjection)
+	{
+		m_CameraUniformBuffer->SetData(&viewProjection, sizeof(glm::mat4));
+		m_DebugBatchIndex = 0;
+	}
+
+	void OpenGLRendererBackend::UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+		const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices)
+	{
+		if (lights.size())
+			m_LightsBuffer->SetData(lights.data(), (uint32_t)(lights.size() * sizeof(PointLightData)));
+		if (tileLightIndices.size())
+			m_LightIndicesBuffer->SetData(tileLightIndices.data(), (uint32_t)(tileLightIndices.size() * sizeof(uint32_t)));
+
+		// Ranges are written before the header, so if the buffer has to grow the header is not lost
+		if (tileRanges.size())
+			m_LightGridBuffer->SetData(tileRanges.data(), (uint32_t)(tileRanges.size() * sizeof(glm::uvec2)), (uint32_t)sizeof(LightGridHeader));
+
+		m_LightGridBuffer->SetData(&header, (uint32_t)sizeof(LightGridHeader));
+	}
+
+	void OpenGLRendererBackend::BindTextures(const Shared<Texture>* textures, uint32_t textureCount)
+	{
+		for (uint32_t i = 0; i < textureCount; i++)
+			(textures[i] ? textures[i] : m_WhiteTexture)->Bind(i);
+	}
+
+	void OpenGLRendererBackend::BindQuadShader()
+	{
+		RendererDebugMode debugMode = GetActiveDebugMode();
+		if (debugMode == RendererDebugMode::None)
+		{
+			m_QuadShader->Bind();
+			return;
+		}
+
+		Shared<Shader>& shader = m_QuadDebugShaders[(int)debugMode];
+		if (!shader)
+		{
+			static const char* defines[] = { "", "DEBUG_OVERDRAW", "DEBUG_BATCH_ID", "DEBUG_TEXTURE_SLOT" };
+			shader = MakeShared<Shader>("content/shaders/Quad2D.glsl", std::vector<std::string>{ defines[(int)debugMode] });
+		}
+
+		shader->Bind();
+		if (debugMode == RendererDebugMode::BatchID)
+			shader->SetInt("u_BatchIndex", m_DebugBatchIndex++);
+	}
+
+	void OpenGLRendererBackend::DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount)
+	{
+		m_QuadVertexBuffer->SetData(vertices, quadCount * 4 * (uint32_t)sizeof(QuadVertex));
+		BindTextures(textures, textureCount);
+
+		BindQuadShader();
+		m_QuadVertexArray->Bind();
+		glDrawElements(GL_TRIANGLES, quadCount * 6, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void OpenGLRendererBackend::DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth)
+	{
+		// Only Quad2D outputs a layer count, lines would add their color to the overdraw counts
+		if (GetActiveDebugMode() == RendererDebugMode::Overdraw)
+			return;
+
+		m_LineVertexBuffer->SetData(vertices, vertexCount * (uint32_t)sizeof(LineVertex));
+
+		m_LineShader->Bind();
+		m_LineVertexArray->Bind();
+		GLState::SetLineWidth(lineWidth);
+		glDrawArrays(GL_LINES, 0, vertexCount);
+	}
+
+	void OpenGLRendererBackend::DrawCircles(const CircleVertex* vertices, uint32_t circleCount)
+	{
+		// Only Quad2D outputs a layer count, circles would add their color to the overdraw counts
+		if (GetActiveDebugMode() == RendererDebugMode::Overdraw)
+			return;
+
+		m_CircleVertexBuffer->SetData(vertices, circleCount * 4 * (uint32_t)sizeof(CircleVertex));
+
+		m_CircleShader->Bind();
+		m_CircleVertexArray->Bind();
+		glDrawElements(GL_TRIANGLES, circleCount * 6, GL_UNSIGNED_INT, nullptr);
+	}
+
+	// Upload recorded vertices, the GPU buffer only grows (with some headroom) and is reused between frames
+	template<typename TVertex>
+	void OpenGLRendererBackend::UploadFrameBuffer(FrameVertexBuffer& buffer, const std::vector<TVertex>& vertices, const Shared<VertexBuffer>& layoutSource, bool indexed)
+	{
+		uint32_t vertexCount = (uint32_t)vertices.size();
+		if (!vertexCount)
+			return;
+
+		if (vertexCount > buffer.Capacity)
+		{
+			buffer.Capacity = vertexCount + vertexCount / 2;
+			buffer.GpuVertexBuffer = MakeShared<VertexBuffer>(buffer.Capacity * (uint32_t)sizeof(TVertex));
+			buffer.GpuVertexBuffer->SetLayout(layoutSource->GetLayout());
+			buffer.GpuVertexArray = MakeShared<VertexArray>();
+			buffer.GpuVertexArray->AddVertexBuffer(buffer.GpuVertexBuffer);
+			if (indexed)
+				buffer.GpuVertexArray->SetIndexBuffer(m_QuadIndexBuffer);
+		}
+
+		buffer.GpuVertexBuffer->SetData(vertices.data(), vertexCount * (uint32_t)sizeof(TVertex));
+	}
+
+	void OpenGLRendererBackend::UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles)
+	{
+		UploadFrameBuffer(m_FrameQuads, quads, m_QuadVertexBuffer, true);
+		UploadFrameBuffer(m_FrameLines, lines, m_LineVertexBuffer, false);
+		UploadFrameBuffer(m_FrameCircles, circles, m_CircleVertexBuffer, true);
+	}
+
+	void OpenGLRendererBackend::DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+		const Shared<Texture>* textures, uint32_t textureCount, float lineWidth)
+	{
+		// Lines and circles are skipped in overdraw mode (see DrawLines, DrawCircles)
+		if (primitive != RendererPrimitive::Quad && GetActiveDebugMode() == RendererDebugMode::Overdraw)
+			return;
+
+		GLsizei drawCount = (GLsizei)ranges.size();
+		m_DrawFirsts.resize(drawCount);
+		m_DrawCounts.resize(drawCount);
+
+		if (primitive == RendererPrimitive::Line)
+		{
+			for (GLsizei i = 0; i < drawCount; i++)
+			{
+				m_DrawFirsts[i] = baseVertex + ranges[i].x * 2;
+				m_DrawCounts[i] = ranges[i].y * 2;
+			}
+
+			m_LineShader->Bind();
+			m_FrameLines.GpuVertexArray->Bind();
+			GLState::SetLineWidth(lineWidth);
+			glMultiDrawArrays(GL_LINES, m_DrawFirsts.data(), m_DrawCounts.data(), drawCount);
+			return;
+		}
+
+		// Quads and circles share the quad index buffer, every batch starts at its base vertex
+		m_DrawOffsets.resize(drawCount);
+		m_DrawBaseVertices.assign(drawCount, (GLint)baseVertex);
+		for (GLsizei i = 0; i < drawCount; i++)
+		{
+			m_DrawOffsets[i] = (const void*)(ranges[i].x * 6 * sizeof(uint32_t));
+			m_DrawCounts[i] = ranges[i].y * 6;
+		}
+
+		if (primitive == RendererPrimitive::Quad)
+		{
+			BindTextures(textures, textureCount);
+			BindQuadShader();
+			m_FrameQuads.GpuVertexArray->Bind();
+		}
+		else
+		{
+			m_CircleShader->Bind();
+			m_FrameCircles.GpuVertexArray->Bind();
+		}
+
+		glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_DrawCounts.data(), GL_UNSIGNED_INT,
+			m_DrawOffsets.data(), drawCount, m_DrawBaseVertices.data());
+	}
+
+	void OpenGLRendererBackend::DrawQuadMesh(QuadMesh& mesh)
+	{
+		if (mesh.m_Dirty)
+		{
+			uint32_t vertexCount = (uint32_t)mesh.m_Vertices.size();
+			if (vertexCount > mesh.m_Capacity)
+			{
+				mesh.m_Capacity = vertexCount + vertexCount / 2;
+				mesh.m_VertexBuffer = MakeShared<VertexBuffer>(mesh.m_Capacity * (uint32_t)sizeof(QuadVertex));
+				mesh.m_VertexBuffer->SetLayout(m_QuadVertexBuffer->GetLayout());
+				mesh.m_VertexArray = MakeShared<VertexArray>();
+				mesh.m_VertexArray->AddVertexBuffer(mesh.m_VertexBuffer);
+				mesh.m_VertexArray->SetIndexBuffer(m_QuadIndexBuffer);
+			}
+			mesh.m_VertexBuffer->SetData(mesh.m_Vertices.data(), vertexCount * (uint32_t)sizeof(QuadVertex));
+			mesh.m_Dirty = false;
+		}
+
+		mesh.m_VertexArray->Bind();
+		for (const QuadMesh::Batch& batch : mesh.m_Batches)
+		{
+			BindQuadShader();
+			BindTextures(mesh.m_Textures.data() + batch.FirstTexture, batch.TextureCount);
+			glDrawElementsBaseVertex(GL_TRIANGLES, batch.QuadCount * 6, GL_UNSIGNED_INT, nullptr, batch.FirstQuad * 4);
+		}
+	}
+
+	void OpenGLRendererBackend::BeginRenderTarget(const Shared<Texture>& target)
+	{
+		uint32_t width = target->GetWidth();
+		uint32_t height = target->GetHeight();
+
+		if (!m_RenderTargetFramebuffer)
+			glCreateFramebuffers(1, &m_RenderTargetFramebuffer);
+
+		// Depth buffer is shared by all render targets and grows to fit the biggest one
+		if (width > m_RenderTargetDepthSize.x || height > m_RenderTargetDepthSize.y)
+		{
+			m_RenderTargetDepthSize = glm::max(m_RenderTargetDepthSize, glm::uvec2(width, height));
+			glDeleteRenderbuffers(1, &m_RenderTargetDepthBuffer);
+			glCreateRenderbuffers(1, &m_RenderTargetDepthBuffer);
+			glNamedRenderbufferStorage(m_RenderTargetDepthBuffer, GL_DEPTH24_STENCIL8, m_RenderTargetDepthSize.x, m_RenderTargetDepthSize.y);
+			glNamedFramebufferRenderbuffer(m_RenderTargetFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_RenderTargetDepthBuffer);
+		}
+		glNamedFramebufferTexture(m_RenderTargetFramebuffer, GL_COLOR_ATTACHMENT0, target->GetOpenGL_ID(), 0);
+
+		m_PreviousFramebuffer = GLState::GetBoundFramebuffer();
+		GLState::BindFramebuffer(m_RenderTargetFramebuffer);
+		GLState::SetViewport(0, 0, width, height);
+		constexpr float clearColor[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		glClearNamedFramebufferfv(m_RenderTargetFramebuffer, GL_COLOR, 0, clearColor);
+		glClearNamedFramebufferfi(m_RenderTargetFramebuffer, GL_DEPTH_STENCIL, 0, 1.0f, 0);
+
+		m_RenderingToTarget = true;
+		ApplyBlendFunc();
+		SetDepthTest(m_DepthTest);
+	}
+
+	void OpenGLRendererBackend::EndRenderTarget()
+	{
+		m_RenderingToTarget = false;
+		ApplyBlendFunc();
+		SetDepthTest(m_DepthTest);
+		GLState::BindFramebuffer(m_PreviousFramebuffer);
+	}
+
+	void OpenGLRendererBackend::ApplyBlendFunc()
+	{
+		if (GetActiveDebugMode() == RendererDebugMode::Overdraw)
+			GLState::SetBlendFunc(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+		// Accumulate alpha so the target can be blended over the scene later
+		else if (m_RenderingToTarget)
+			GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		// Render target contents, their color was already multiplied by alpha when they were drawn
+		else if (m_BlendMode == RendererBlendMode::Premultiplied)
+			GLState::SetBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		else
+			GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	void OpenGLRendererBackend::SetBlendMode(RendererBlendMode mode)
+	{
+		m_BlendMode = mode;
+		ApplyBlendFunc();
+	}
+
+	void OpenGLRendererBackend::SetDebugMode(RendererDebugMode mode)
+	{
+		m_DebugMode = mode;
+		ApplyBlendFunc();
+		SetDepthTest(m_DepthTest);
+	}
+
+	void OpenGLRendererBackend::ResolveOverdraw(uint32_t countTextureID)
+	{
+		if (!m_OverdrawResolveShader)
+		{
+			m_OverdrawResolveShader = MakeShared<Shader>("content/shaders/OverdrawResolve.glsl");
+			glCreateVertexArrays(1, &m_EmptyVertexArray);
+		}
+
+		GLState::SetBlending(false);
+		GLState::SetDepthTest(false);
+
+		m_OverdrawResolveShader->Bind();
+		GLState::BindTextureUnit(0, countTextureID);
+		GLState::BindVertexArray(m_EmptyVertexArray);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+
+		GLState::SetBlending(true);
+		SetDepthTest(m_DepthTest);
+	}
+
+}
@@ -0,0 +1,124 @@
+//
+// OpenGL renderer backend.
+// Owns the GPU objects of the batch renderer (vertex arrays, shaders, camera and light buffers,
+// render target framebuffer) and issues the draw calls for batches submitted by Renderer.
+//
+#pragma once
+
+#include "Proton/Graphics/Renderer/RendererBackend.h"
+
+namespace proton {
+
+	class VertexArray;
+	class VertexBuffer;
+	class IndexBuffer;
+	class Shader;
+	class UniformBuffer;
+	class StorageBuffer;
+
+	class OpenGLRendererBackend : public RendererBackend
+	{
+	public:
+		OpenGLRendererBackend() = default;
+		virtual ~OpenGLRendererBackend();
+
+		virtual RendererBackendType GetType() const override { return RendererBackendType::OpenGL; }
+
+		virtual void Init(uint32_t maxQuads) override;
+		virtual void Shutdown() override;
+		virtual uint32_t GetMaxTextureSlots() const override { return m_MaxTextureSlots; }
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		virtual glm::uvec4 GetViewport() const override;
+		virtual void SetClearColor(const glm::vec4& color) override;
+		virtual void Clear() override;
+		virtual void SetDepthTest(bool enabled) override;
+		virtual void SetCamera(const glm::mat4& viewProjection) override;
+		virtual void UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+			const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices) override;
+
+		virtual void DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount) override;
+		virtual void DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth) override;
+		virtual void DrawCircles(const CircleVertex* vertices, uint32_t circleCount) override;
+
+		virtual void UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles) override;
+		virtual void DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+			const Shared<Texture>* textures, uint32_t textureCount, float lineWidth) override;
+
+		virtual void DrawQuadMesh(QuadMesh& mesh) override;
+
+		virtual void BeginRenderTarget(const Shared<Texture>& target) override;
+		virtual void EndRenderTarget() override;
+
+		virtual void SetBlendMode(RendererBlendMode mode) override;
+		virtual void SetDebugMode(RendererDebugMode mode) override;
+		virtual void ResolveOverdraw(uint32_t countTextureID) override;
+
+	private:
+		struct FrameVertexBuffer
+		{
+			Shared<VertexArray> GpuVertexArray;
+			Shared<VertexBuffer> GpuVertexBuffer;
+			uint32_t Capacity = 0; // vertices
+		};
+
+		template<typename TVertex>
+		void UploadFrameBuffer(FrameVertexBuffer& buffer, const std::vector<TVertex>& vertices, const Shared<VertexBuffer>& layoutSource, bool indexed);
+		void BindTextures(const Shared<Texture>* textures, uint32_t textureCount);
+		void BindQuadShader();
+		void ApplyBlendFunc();
+
+		// Render targets (impostors) are cached across frames and always drawn without debug visualization
+		RendererDebugMode GetActiveDebugMode() const { return m_RenderingToTarget ? RendererDebugMode::None : m_DebugMode; }
+
+	private:
+		uint32_t m_MaxTextureSlots = 32;
+
+		Shared<VertexArray> m_QuadVertexArray;
+		Shared<VertexBuffer> m_QuadVertexBuffer;
+		Shared<IndexBuffer> m_QuadIndexBuffer;
+		Shared<Shader> m_QuadShader;
+		Shared<Shader> m_QuadDebugShaders[4]; // by RendererDebugMode, compiled on first use
+
+		Shared<VertexArray> m_LineVertexArray;
+		Shared<VertexBuffer> m_LineVertexBuffer;
+		Shared<Shader> m_LineShader;
+
+		Shared<VertexArray> m_CircleVertexArray;
+		Shared<VertexBuffer> m_CircleVertexBuffer;
+		Shared<Shader> m_CircleShader;
+
+		Shared<Texture> m_WhiteTexture;
+		Shared<UniformBuffer> m_CameraUniformBuffer;
+
+		// Light grid storage buffers (see Quad2D.glsl)
+		Unique<StorageBuffer> m_LightsBuffer;
+		Unique<StorageBuffer> m_LightGridBuffer;
+		Unique<StorageBuffer> m_LightIndicesBuffer;
+
+		// Frame batch vertices and per-view multi draw arguments
+		FrameVertexBuffer m_FrameQuads;
+		FrameVertexBuffer m_FrameLines;
+		FrameVertexBuffer m_FrameCircles;
+		std::vector<int> m_DrawFirsts;
+		std::vector<int> m_DrawCounts;
+		std::vector<const void*> m_DrawOffsets;
+		std::vector<int> m_DrawBaseVertices;
+
+		// Render to texture
+		uint32_t m_RenderTargetFramebuffer = 0;
+		uint32_t m_RenderTargetDepthBuffer = 0;
+		glm::uvec2 m_RenderTargetDepthSize = { 0, 0 };
+		uint32_t m_PreviousFramebuffer = 0;
+		bool m_RenderingToTarget = false;
+		RendererBlendMode m_BlendMode = RendererBlendMode::Alpha;
+
+		// Debug visualization
+		RendererDebugMode m_DebugMode = RendererDebugMode::None;
+		int m_DebugBatchIndex = 0;
+		bool m_DepthTest = true;
+		Shared<Shader> m_OverdrawResolveShader;
+		uint32_t m_EmptyVertexArray = 0;
+	};
+
+}
@@ -0,0 +1,93 @@
+//
+// Retained quad geometry.
+// Quads are built once on the CPU and kept in a GPU vertex buffer until the mesh changes.
+// Drawing the mesh (Renderer::DrawQuadMesh) generates no vertices, it costs one vertex array
+// bind and one draw call per texture batch.
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/QuadMesh.h"
+#include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Graphics/Renderer/VertexArray.h"
+
+namespace proton {
+
+	static constexpr glm::vec4 s_QuadVertexPositions[] = {
+		{ -0.5f, -0.5f, 0.0f, 1.0f },
+		{  0.5f, -0.5f, 0.0f, 1.0f },
+		{  0.5f,  0.5f, 0.0f, 1.0f },
+		{ -0.5f,  0.5f, 0.0f, 1.0f }
+	};
+
+	static const TextureCoords s_DefaultTextureCoords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+
+	QuadMesh::~QuadMesh() = default;
+
+	void QuadMesh::Clear()
+	{
+		m_Vertices.clear();
+		m_Batches.clear();
+		m_Textures.clear();
+		m_Dirty = true;
+	}
+
+	void QuadMesh::AddQuad(const glm::mat4& transform, const glm::vec4& color)
+	{
+		float textureIndex = GetTextureIndex(nullptr);
+		WriteQuad(transform, s_DefaultTextureCoords, color, textureIndex, 1.0f);
+	}
+
+	void QuadMesh::AddQuad(const glm::mat4& transform, const Shared<Texture>& texture, const TextureCoords& textureCoords, const glm::vec4& tintColor, float tilingFactor)
+	{
+		float textureIndex = GetTextureIndex(texture);
+		WriteQuad(transform, textureCoords, tintColor, textureIndex, tilingFactor);
+	}
+
+	float QuadMesh::GetTextureIndex(const Shared<Texture>& texture)
+	{
+		if (m_Batches.empty() || m_Batches.back().QuadCount >= Renderer::GetMaxQuadsCount())
+		{
+			Batch& batch = m_Batches.emplace_back();
+			batch.FirstQuad = GetQuadsCount();
+			batch.FirstTexture = (uint32_t)m_Textures.size();
+			m_Textures.push_back(nullptr);
+		}
+
+		if (!texture)
+			return 0.0f;
+
+		Batch* batch = &m_Batches.back();
+		for (uint32_t i = 1; i < batch->TextureCount; i++)
+		{
+			if (*m_Textures[batch->FirstTexture + i] == *texture)
+				return (float)i;
+		}
+
+		if (batch->TextureCount >= Renderer::GetMaxTextureSlots())
+		{
+			batch = &m_Batches.emplace_back();
+			batch->FirstQuad = GetQuadsCount();
+			batch->FirstTexture = (uint32_t)m_Textures.size();
+			m_Textures.push_back(nullptr);
+		}
+
+		m_Textures.push_back(texture);
+		return (float)(batch->TextureCount++);
+	}
+
+	void QuadMesh::WriteQuad(const glm::mat4& transform, const TextureCoords& textureCoords, const glm::vec4& color, float textureIndex, float tilingFactor)
+	{
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			QuadVertex& vertex = m_Vertices.emplace_back();
+			vertex.Position = transform * s_QuadVertexPositions[i];
+			vertex.Color = color;
+			vertex.TextureCoords = textureCoords[i];
+			vertex.TextureIndex = textureIndex;
+			vertex.TilingFactor = tilingFactor;
+		}
+
+		m_Batches.back().QuadCount++;
+		m_Dirty = true;
+	}
+
+}
@@ -0,0 +1,68 @@
+//
+// Retained quad geometry.
+// Quads are built once on the CPU and kept in a GPU vertex buffer until the mesh changes.
+// Drawing the mesh (Renderer::DrawQuadMesh) generates no vertices, it costs one vertex array
+// bind and one draw call per texture batch.
+//
+#pragma once
+
+#include "Proton/Graphics/Spritesheet.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	class VertexArray;
+	class VertexBuffer;
+
+	struct QuadVertex // vertex buffer data
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TextureCoords;
+		float TextureIndex;
+		float TilingFactor;
+	};
+
+	class QuadMesh
+	{
+	public:
+		QuadMesh() = default;
+		~QuadMesh();
+
+		void Clear();
+		void AddQuad(const glm::mat4& transform, const glm::vec4& color);
+		void AddQuad(const glm::mat4& transform, const Shared<Texture>& texture, const TextureCoords& textureCoords, const glm::vec4& tintColor, float tilingFactor = 1.0f);
+
+		uint32_t GetQuadsCount() const { return (uint32_t)m_Vertices.size() / 4; }
+		uint32_t GetBatchesCount() const { return (uint32_t)m_Batches.size(); }
+		bool IsEmpty() const { return m_Vertices.empty(); }
+
+	private:
+		// Texture slot in the current batch, starts a new batch when slots or quad indices run out
+		float GetTextureIndex(const Shared<Texture>& texture);
+		void WriteQuad(const glm::mat4& transform, const TextureCoords& textureCoords, const glm::vec4& color, float textureIndex, float tilingFactor);
+
+	private:
+		struct Batch
+		{
+			uint32_t FirstQuad = 0, QuadCount = 0;
+			uint32_t FirstTexture = 0, TextureCount = 1; // slot 0 is the white texture
+		};
+
+		std::vector<QuadVertex> m_Vertices;
+		std::vector<Batch> m_Batches;
+		std::vector<Shared<Texture>> m_Textures; // nullptr is the white texture
+
+		// GPU buffer, only grows and is reuploaded when the mesh changed
+		Shared<VertexArray> m_VertexArray;
+		Shared<VertexBuffer> m_VertexBuffer;
+		uint32_t m_Capacity = 0; // vertices
+		bool m_Dirty = true;
+
+		friend class Renderer;
+		friend class OpenGLRendererBackend;
+		friend class RecordingRendererBackend;
+	};
+
+}
@@ -0,0 +1,108 @@
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/RecordingRendererBackend.h"
+
+namespace proton {
+
+	void RecordingRendererBackend::Reset()
+	{
+		m_Draws.clear();
+		m_QuadVertices.clear();
+		m_LineVertices.clear();
+		m_CircleVertices.clear();
+		m_ClearsCount = 0;
+	}
+
+	RecordedDraw& RecordingRendererBackend::RecordDraw(RendererPrimitive primitive, uint32_t firstVertex, uint32_t vertexCount)
+	{
+		RecordedDraw& draw = m_Draws.emplace_back();
+		draw.Primitive = primitive;
+		draw.FirstVertex = firstVertex;
+		draw.VertexCount = vertexCount;
+		draw.ViewProjection = m_ViewProjection;
+		draw.RenderTarget = m_RenderTarget;
+		draw.DepthTest = m_DepthTest;
+		draw.BlendMode = m_BlendMode;
+		return draw;
+	}
+
+	void RecordingRendererBackend::UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+		const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices)
+	{
+		m_VisibleLights = header.Info.w ? (uint32_t)lights.size() : 0;
+	}
+
+	void RecordingRendererBackend::DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount)
+	{
+		RecordedDraw& draw = RecordDraw(RendererPrimitive::Quad, (uint32_t)m_QuadVertices.size(), quadCount * 4);
+		draw.Textures.assign(textures, textures + textureCount);
+		m_QuadVertices.insert(m_QuadVertices.end(), vertices, vertices + quadCount * 4);
+	}
+
+	void RecordingRendererBackend::DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth)
+	{
+		RecordedDraw& draw = RecordDraw(RendererPrimitive::Line, (uint32_t)m_LineVertices.size(), vertexCount);
+		draw.LineWidth = lineWidth;
+		m_LineVertices.insert(m_LineVertices.end(), vertices, vertices + vertexCount);
+	}
+
+	void RecordingRendererBackend::DrawCircles(const CircleVertex* vertices, uint32_t circleCount)
+	{
+		RecordDraw(RendererPrimitive::Circle, (uint32_t)m_CircleVertices.size(), circleCount * 4);
+		m_CircleVertices.insert(m_CircleVertices.end(), vertices, vertices + circleCount * 4);
+	}
+
+	void RecordingRendererBackend::UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles)
+	{
+		m_FrameQuads = quads;
+		m_FrameLines = lines;
+		m_FrameCircles = circles;
+	}
+
+	void RecordingRendererBackend::DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+		const Shared<Texture>* textures, uint32_t textureCount, float lineWidth)
+	{
+		// Ranges are recorded as the single draw they are issued as, with their vertices concatenated
+		auto expand = [&](auto& recorded, const auto& frame, uint32_t primitiveVertexCount) -> RecordedDraw&
+		{
+			RecordedDraw& draw = RecordDraw(primitive, (uint32_t)recorded.size(), 0);
+			for (const glm::uvec2& range : ranges)
+			{
+				auto first = frame.begin() + baseVertex + range.x * primitiveVertexCount;
+				recorded.insert(recorded.end(), first, first + range.y * primitiveVertexCount);
+				draw.VertexCount += range.y * primitiveVertexCount;
+			}
+			return draw;
+		};
+
+		switch (primitive)
+		{
+		case RendererPrimitive::Quad:
+		{
+			RecordedDraw& draw = expand(m_QuadVertices, m_FrameQuads, 4);
+			draw.Textures.assign(textures, textures + textureCount);
+			break;
+		}
+		case RendererPrimitive::Line:
+		{
+			RecordedDraw& draw = expand(m_LineVertices, m_FrameLines, 2);
+			draw.LineWidth = lineWidth;
+			break;
+		}
+		case RendererPrimitive::Circle:
+			expand(m_CircleVertices, m_FrameCircles, 4);
+			break;
+		}
+	}
+
+	void RecordingRendererBackend::DrawQuadMesh(QuadMesh& mesh)
+	{
+		for (const QuadMesh::Batch& batch : mesh.m_Batches)
+		{
+			RecordedDraw& draw = RecordDraw(RendererPrimitive::Quad, (uint32_t)m_QuadVertices.size(), batch.QuadCount * 4);
+			draw.Textures.assign(mesh.m_Textures.begin() + batch.FirstTexture, mesh.m_Textures.begin() + batch.FirstTexture + batch.TextureCount);
+			auto first = mesh.m_Vertices.begin() + batch.FirstQuad * 4;
+			m_QuadVertices.insert(m_QuadVertices.end(), first, first + batch.QuadCount * 4);
+		}
+	}
+
+}
@@ -0,0 +1,96 @@
+//
+// Renderer backend that records submitted draws into memory.
+// Every draw keeps its primitive type, vertex payload, bound textures, camera and render target,
+// frame batch ranges are expanded into the vertices they would draw. Used to inspect the output
+// of the render path (batch counts, texture slots, vertices) without a GPU context.
+//
+#pragma once
+
+#include "Proton/Graphics/Renderer/RendererBackend.h"
+
+namespace proton {
+
+	struct RecordedDraw
+	{
+		RendererPrimitive Primitive = RendererPrimitive::Quad;
+		uint32_t FirstVertex = 0; // into the recorded vertices of the primitive type
+		uint32_t VertexCount = 0;
+		std::vector<Shared<Texture>> Textures; // bound texture slots (nullptr is the white texture)
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		Shared<Texture> RenderTarget;          // nullptr is the current framebuffer
+		float LineWidth = 1.0f;
+		bool DepthTest = true;
+		RendererBlendMode BlendMode = RendererBlendMode::Alpha;
+	};
+
+	class RecordingRendererBackend : public RendererBackend
+	{
+	public:
+		virtual RendererBackendType GetType() const override { return RendererBackendType::Recording; }
+
+		virtual void Init(uint32_t maxQuads) override {}
+		virtual void Shutdown() override { Reset(); }
+		virtual uint32_t GetMaxTextureSlots() const override { return 32; }
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override { m_Viewport = { x, y, width, height }; }
+		virtual glm::uvec4 GetViewport() const override { return m_Viewport; }
+		virtual void SetClearColor(const glm::vec4& color) override {}
+		virtual void Clear() override { m_ClearsCount++; }
+		virtual void SetDepthTest(bool enabled) override { m_DepthTest = enabled; }
+		virtual void SetBlendMode(RendererBlendMode mode) override { m_BlendMode = mode; }
+		virtual void SetCamera(const glm::mat4& viewProjection) override { m_ViewProjection = viewProjection; }
+		virtual void UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+			const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices) override;
+
+		virtual void DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount) override;
+		virtual void DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth) override;
+		virtual void DrawCircles(const CircleVertex* vertices, uint32_t circleCount) override;
+
+		virtual void UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles) override;
+		virtual void DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+			const Shared<Texture>* textures, uint32_t textureCount, float lineWidth) override;
+
+		virtual void DrawQuadMesh(QuadMesh& mesh) override;
+
+		virtual void BeginRenderTarget(const Shared<Texture>& target) override { m_RenderTarget = target; }
+		virtual void EndRenderTarget() override { m_RenderTarget = nullptr; }
+
+		virtual void SetDebugMode(RendererDebugMode mode) override {}
+		virtual void ResolveOverdraw(uint32_t countTextureID) override {}
+
+		// Recordings grow until reset, call between measured frames
+		void Reset();
+
+		const std::vector<RecordedDraw>& GetDraws() const { return m_Draws; }
+		const std::vector<QuadVertex>& GetQuadVertices() const { return m_QuadVertices; }
+		const std::vector<LineVertex>& GetLineVertices() const { return m_LineVertices; }
+		const std::vector<CircleVertex>& GetCircleVertices() const { return m_CircleVertices; }
+
+		uint32_t GetQuadsCount() const { return (uint32_t)m_QuadVertices.size() / 4; }
+		uint32_t GetClearsCount() const { return m_ClearsCount; }
+		uint32_t GetVisibleLightsCount() const { return m_VisibleLights; }
+
+	private:
+		RecordedDraw& RecordDraw(RendererPrimitive primitive, uint32_t firstVertex, uint32_t vertexCount);
+
+	private:
+		std::vector<RecordedDraw> m_Draws;
+		std::vector<QuadVertex> m_QuadVertices;
+		std::vector<LineVertex> m_LineVertices;
+		std::vector<CircleVertex> m_CircleVertices;
+
+		// Vertices of the current frame batch
+		std::vector<QuadVertex> m_FrameQuads;
+		std::vector<LineVertex> m_FrameLines;
+		std::vector<CircleVertex> m_FrameCircles;
+
+		glm::uvec4 m_Viewport = { 0, 0, 0, 0 };
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		Shared<Texture> m_RenderTarget;
+		bool m_DepthTest = true;
+		RendererBlendMode m_BlendMode = RendererBlendMode::Alpha;
+		uint32_t m_ClearsCount = 0;
+		uint32_t m_VisibleLights = 0;
+	};
+
+}
@@ -0,0 +1,380 @@
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/RenderGraph.h"
+#include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
+
+#include <glad/glad.h>
+
+namespace proton {
+
+	static const uint32_t s_InvalidIndex = 0xffffffff;
+
+	// Pooled textures follow the framebuffer resize policy: grow with 25% headroom rounded up to
+	// the granularity, reuse a texture only when at least half of it is used
+	static const uint32_t s_TextureSizeGranularity = 64;
+	static const float s_TextureGrowFactor = 1.25f;
+	static const float s_TextureShrinkThreshold = 0.5f;
+
+	namespace Utils {
+
+		static bool IsDepthFormat(FramebufferTextureFormat format)
+		{
+			return format == FramebufferTextureFormat::DEPTH24STENCIL8;
+		}
+
+		static GLenum GetInternalFormat(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+			case FramebufferTextureFormat::RGBA8:           return GL_RGBA8;
+			case FramebufferTextureFormat::RGBA16F:         return GL_RGBA16F;
+			case FramebufferTextureFormat::RED_INTEGER:     return GL_R32I;
+			case FramebufferTextureFormat::DEPTH24STENCIL8: return GL_DEPTH24_STENCIL8;
+			}
+
+			PT_CORE_ASSERT(false);
+			return 0;
+		}
+
+		static uint64_t GetBytesPerPixel(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+			case FramebufferTextureFormat::RGBA8:           return 4;
+			case FramebufferTextureFormat::RGBA16F:         return 8;
+			case FramebufferTextureFormat::RED_INTEGER:     return 4;
+			case FramebufferTextureFormat::DEPTH24STENCIL8: return 4;
+			}
+
+			PT_CORE_ASSERT(false);
+			return 0;
+		}
+
+		static uint32_t GetAllocationSize(uint32_t size)
+		{
+			uint32_t grown = (uint32_t)(size * s_TextureGrowFactor);
+			return (grown + s_TextureSizeGranularity - 1) / s_TextureSizeGranularity * s_TextureSizeGranularity;
+		}
+
+		static bool Contains(const std::vector<RenderGraphResource>& resources, RenderGraphResource resource)
+		{
+			return std::find(resources.begin(), resources.end(), resource) != resources.end();
+		}
+
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		for (PooledTexture& texture : m_Pool)
+			ReleasePooledTexture(texture);
+
+		for (uint32_t framebuffer : m_Framebuffers)
+			GLState::OnFramebufferDeleted(framebuffer);
+		glDeleteFramebuffers((GLsizei)m_Framebuffers.size(), m_Framebuffers.data());
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Resources.clear();
+		m_Passes.clear();
+		m_Compiled = false;
+	}
+
+	RenderGraphResource RenderGraph::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		PT_CORE_ASSERT(desc.Width > 0 && desc.Height > 0, "Render graph texture has zero size!");
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+		resource.Desc = desc;
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, uint32_t textureID, const RenderGraphTextureDesc& desc)
+	{
+		Resource& resource = m_Resources.emplace_back();
+		resource.Name = name;
+		resource.Desc = desc;
+		resource.ImportedID = textureID;
+		resource.Imported = true;
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, std::initializer_list<RenderGraphResource> reads,
+		std::initializer_list<RenderGraphResource> writes, const std::function<void()>& execute)
+	{
+		PT_CORE_ASSERT(writes.size() > 0, "Render graph pass must write at least one texture!");
+		Pass& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Reads = reads;
+		pass.Writes = writes;
+		pass.Execute = execute;
+	}
+
+	void RenderGraph::Compile()
+	{
+		PROFILE_FUNCTION();
+
+		// Backward liveness: a pass is needed when it writes a texture read by a later needed pass
+		// or an imported texture. Textures written without being read are overwritten, so earlier
+		// writes to them are dead unless a pass in between reads them.
+		std::vector<bool> needed(m_Resources.size());
+		for (size_t i = 0; i < m_Resources.size(); i++)
+			needed[i] = m_Resources[i].Imported;
+
+		m_CulledPasses = 0;
+		for (size_t i = m_Passes.size(); i-- > 0;)
+		{
+			Pass& pass = m_Passes[i];
+			pass.Culled = std::none_of(pass.Writes.begin(), pass.Writes.end(),
+				[&](RenderGraphResource resource) { return needed[resource]; });
+			if (pass.Culled)
+			{
+				m_CulledPasses++;
+				continue;
+			}
+
+			for (RenderGraphResource resource : pass.Writes)
+			{
+				m_Resources[resource].Used |= needed[resource];
+				if (!Utils::Contains(pass.Reads, resource))
+					needed[resource] = false;
+			}
+			for (RenderGraphResource resource : pass.Reads)
+			{
+				m_Resources[resource].Used = true;
+				needed[resource] = true;
+			}
+		}
+
+		// Lifetimes in pass order
+		for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++)
+		{
+			const Pass& pass = m_Passes[i];
+			if (pass.Culled)
+				continue;
+
+			auto use = [&](RenderGraphResource resource)
+			{
+				Resource& r = m_Resources[resource];
+				r.FirstUse = glm::min(r.FirstUse, i);
+				r.LastUse = glm::max(r.LastUse, i);
+			};
+			for (RenderGraphResource resource : pass.Reads)
+			{
+				if (!m_Resources[resource].Imported && m_Resources[resource].FirstUse == s_InvalidIndex)
+					PT_CORE_WARN("Render graph pass '{0}' reads '{1}' before it is written", pass.Name, m_Resources[resource].Name);
+				use(resource);
+			}
+			for (RenderGraphResource resource : pass.Writes)
+				use(resource);
+		}
+
+		// Assign transient textures to pooled textures in order of first use, a pooled texture is
+		// shared by textures of the same format and size with disjoint lifetimes
+		std::vector<uint32_t> transients;
+		for (uint32_t i = 0; i < (uint32_t)m_Resources.size(); i++)
+		{
+			if (!m_Resources[i].Imported && m_Resources[i].Used)
+				transients.push_back(i);
+		}
+		std::stable_sort(transients.begin(), transients.end(),
+			[&](uint32_t a, uint32_t b) { return m_Resources[a].FirstUse < m_Resources[b].FirstUse; });
+
+		for (PooledTexture& texture : m_Pool)
+			texture.Used = false;
+
+		uint64_t requestedMemory = 0;
+		for (uint32_t index : transients)
+		{
+			Resource& resource = m_Resources[index];
+			resource.PooledTexture = AcquirePooledTexture(resource.Desc, resource.FirstUse);
+			PooledTexture& texture = m_Pool[resource.PooledTexture];
+			texture.LastUse = resource.LastUse;
+			texture.Used = true;
+			requestedMemory += (uint64_t)texture.Width * texture.Height * Utils::GetBytesPerPixel(texture.Format);
+		}
+
+		// Textures not needed by this frame are released
+		for (size_t i = 0; i < m_Pool.size();)
+		{
+			if (m_Pool[i].Used)
+			{
+				i++;
+				continue;
+			}
+
+			ReleasePooledTexture(m_Pool[i]);
+			m_Pool.erase(m_Pool.begin() + i);
+			for (Resource& resource : m_Resources)
+			{
+				if (resource.PooledTexture != s_InvalidIndex && resource.PooledTexture > i)
+					resource.PooledTexture--;
+			}
+		}
+
+		m_TransientTextures = (uint32_t)transients.size();
+		m_TransientMemory = 0;
+		for (const PooledTexture& texture : m_Pool)
+			m_TransientMemory += (uint64_t)texture.Width * texture.Height * Utils::GetBytesPerPixel(texture.Format);
+		m_AliasedMemorySaved = requestedMemory - m_TransientMemory;
+
+		m_Compiled = true;
+	}
+
+	uint32_t RenderGraph::AcquirePooledTexture(const RenderGraphTextureDesc& desc, uint32_t firstUse)
+	{
+		for (uint32_t i = 0; i < (uint32_t)m_Pool.size(); i++)
+		{
+			const PooledTexture& texture = m_Pool[i];
+			bool available = !texture.Used || texture.LastUse < firstUse;
+			bool fits = texture.Format == desc.Format && desc.Width <= texture.Width && desc.Height <= texture.Height;
+			bool wasteful = desc.Width < texture.Width * s_TextureShrinkThreshold || desc.Height < texture.Height * s_TextureShrinkThreshold;
+			if (available && fits && !wasteful)
+				return i;
+		}
+
+		PooledTexture& texture = m_Pool.emplace_back();
+		texture.Format = desc.Format;
+		texture.Width = Utils::GetAllocationSize(desc.Width);
+		texture.Height = Utils::GetAllocationSize(desc.Height);
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture.RendererID);
+		glTextureStorage2D(texture.RendererID, 1, Utils::GetInternalFormat(desc.Format), texture.Width, texture.Height);
+
+		// Integer textures are not filterable
+		GLenum filter = desc.Format == FramebufferTextureFormat::RED_INTEGER ? GL_NEAREST : GL_LINEAR;
+		glTextureParameteri(texture.RendererID, GL_TEXTURE_MIN_FILTER, filter);
+		glTextureParameteri(texture.RendererID, GL_TEXTURE_MAG_FILTER, filter);
+		glTextureParameteri(texture.RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture.RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		return (uint32_t)m_Pool.size() - 1;
+	}
+
+	void RenderGraph::ReleasePooledTexture(PooledTexture& texture)
+	{
+		// Detach from pass framebuffers, the name can be reused by OpenGL
+		for (size_t i = 0; i < m_Framebuffers.size(); i++)
+		{
+			std::vector<uint32_t>& attachments = m_FramebufferAttachments[i];
+			if (Utils::Contains(attachments, texture.RendererID))
+				attachments.clear();
+		}
+
+		GLState::OnTextureDeleted(texture.RendererID);
+		glDeleteTextures(1, &texture.RendererID);
+		texture.RendererID = 0;
+	}
+
+	uint32_t RenderGraph::GetTextureID(RenderGraphResource resource) const
+	{
+		PT_CORE_ASSERT(resource < m_Resources.size());
+		const Resource& r = m_Resources[resource];
+		if (r.Imported)
+			return r.ImportedID;
+		return r.PooledTexture != s_InvalidIndex ? m_Pool[r.PooledTexture].RendererID : 0;
+	}
+
+	void RenderGraph::BindPassTargets(Pass& pass, uint32_t passIndex)
+	{
+		while (m_Framebuffers.size() <= passIndex)
+		{
+			uint32_t framebuffer;
+			glCreateFramebuffers(1, &framebuffer);
+			m_Framebuffers.push_back(framebuffer);
+			m_FramebufferAttachments.emplace_back();
+		}
+
+		// Color slots follow the declaration order, dead textures leave their slot empty
+		// so fragment outputs keep their locations. The last entry is the depth attachment.
+		std::vector<uint32_t> attachments;
+		uint32_t depthAttachment = 0;
+		glm::uvec2 viewportSize = { 0, 0 };
+		for (RenderGraphResource resource : pass.Writes)
+		{
+			uint32_t textureID = m_Resources[resource].Used ? GetTextureID(resource) : 0;
+			if (Utils::IsDepthFormat(m_Resources[resource].Desc.Format))
+				depthAttachment = textureID;
+			else
+				attachments.push_back(textureID);
+
+			if (textureID && viewportSize.x == 0)
+				viewportSize = { m_Resources[resource].Desc.Width, m_Resources[resource].Desc.Height };
+		}
+		attachments.push_back(depthAttachment);
+
+		uint32_t framebuffer = m_Framebuffers[passIndex];
+		std::vector<uint32_t>& bound = m_FramebufferAttachments[passIndex];
+		if (bound != attachments)
+		{
+			PT_CORE_ASSERT(attachments.size() <= 5);
+			GLenum drawBuffers[4];
+			size_t colorCount = attachments.size() - 1;
+			for (size_t slot = 0; slot < 4; slot++)
+			{
+				uint32_t textureID = slot < colorCount ? attachments[slot] : 0;
+				glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0 + (GLenum)slot, textureID, 0);
+				drawBuffers[slot] = textureID ? GL_COLOR_ATTACHMENT0 + (GLenum)slot : GL_NONE;
+			}
+			glNamedFramebufferDrawBuffers(framebuffer, (GLsizei)glm::max(colorCount, (size_t)1), drawBuffers);
+			glNamedFramebufferTexture(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, depthAttachment, 0);
+
+			PT_CORE_ASSERT(glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+				"Render graph framebuffer is incomplete!");
+			bound = attachments;
+		}
+
+		GLState::BindFramebuffer(framebuffer);
+		Renderer::SetViewport(0, 0, viewportSize.x, viewportSize.y);
+
+		// Clear on first write, textures also read by the pass are loaded
+		uint32_t colorSlot = 0;
+		for (RenderGraphResource resource : pass.Writes)
+		{
+			Resource& r = m_Resources[resource];
+			bool depth = Utils::IsDepthFormat(r.Desc.Format);
+			bool clear = r.Used && r.Desc.Clear && !r.Cleared && !Utils::Contains(pass.Reads, resource);
+			r.Cleared = true;
+
+			if (clear && depth)
+			{
+				glClearNamedFramebufferfi(framebuffer, GL_DEPTH_STENCIL, 0, r.Desc.ClearValue.x, 0);
+			}
+			else if (clear && r.Desc.Format == FramebufferTextureFormat::RED_INTEGER)
+			{
+				glm::ivec4 value = glm::ivec4(r.Desc.ClearValue);
+				glClearNamedFramebufferiv(framebuffer, GL_COLOR, colorSlot, &value.x);
+			}
+			else if (clear)
+			{
+				glClearNamedFramebufferfv(framebuffer, GL_COLOR, colorSlot, &r.Desc.ClearValue.x);
+			}
+
+			if (!depth)
+				colorSlot++;
+		}
+	}
+
+	void RenderGraph::Execute()
+	{
+		PROFILE_FUNCTION();
+		PT_CORE_ASSERT(m_Compiled, "Render graph must be compiled before execution!");
+
+		for (Resource& resource : m_Resources)
+			resource.Cleared = false;
+
+		for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++)
+		{
+			Pass& pass = m_Passes[i];
+			if (pass.Culled)
+				continue;
+
+			PROFILE_SCOPE(pass.Name.c_str());
+			BindPassTargets(pass, i);
+			pass.Execute();
+		}
+
+		GLState::BindFramebuffer(0);
+	}
+
+}
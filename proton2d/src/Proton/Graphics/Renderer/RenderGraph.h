@@ -0,0 +1,118 @@
+//
+// Minimal render graph.
+// The graph is described every frame: passes declare the textures they read and write, then
+// Compile() culls passes whose outputs are never used, computes resource lifetimes and assigns
+// transient textures to pooled GPU textures, aliasing those with disjoint lifetimes. Resources are
+// cleared on their first write. Imported textures (owned outside of the graph) are the outputs.
+//
+#pragma once
+
+#include "Proton/Graphics/Renderer/Framebuffer.h"
+
+#include <glm/glm.hpp>
+#include <functional>
+
+namespace proton {
+
+	using RenderGraphResource = uint32_t;
+
+	struct RenderGraphTextureDesc
+	{
+		FramebufferTextureFormat Format = FramebufferTextureFormat::RGBA8;
+		uint32_t Width = 0, Height = 0;
+
+		// Value written on the first write of the frame (depth uses x, integer formats are truncated)
+		glm::vec4 ClearValue = { 0.0f, 0.0f, 0.0f, 0.0f };
+		bool Clear = true;
+	};
+
+	class RenderGraph
+	{
+	public:
+		static constexpr RenderGraphResource InvalidResource = 0xffffffff;
+
+		RenderGraph() = default;
+		virtual ~RenderGraph();
+
+		// Discard the description of the previous frame (pooled textures are kept)
+		void Reset();
+
+		RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+		RenderGraphResource ImportTexture(const std::string& name, uint32_t textureID, const RenderGraphTextureDesc& desc);
+
+		// Written color textures become color attachments in declaration order, a written depth
+		// texture the depth attachment. Textures both read and written are loaded instead of cleared.
+		// Read-only textures can be sampled by the pass through GetTextureID().
+		void AddPass(const std::string& name, std::initializer_list<RenderGraphResource> reads,
+			std::initializer_list<RenderGraphResource> writes, const std::function<void()>& execute);
+
+		void Compile();
+		void Execute();
+
+		// OpenGL texture of a resource, valid during Execute() (0 for culled resources)
+		uint32_t GetTextureID(RenderGraphResource resource) const;
+
+		// Stats of the last compiled frame
+		uint32_t GetPassesCount() const { return (uint32_t)m_Passes.size(); }
+		uint32_t GetCulledPassesCount() const { return m_CulledPasses; }
+		uint32_t GetTransientTexturesCount() const { return m_TransientTextures; }
+		uint32_t GetPooledTexturesCount() const { return (uint32_t)m_Pool.size(); }
+		uint64_t GetTransientMemory() const { return m_TransientMemory; }
+		uint64_t GetAliasedMemorySaved() const { return m_AliasedMemorySaved; }
+
+	private:
+		struct Resource
+		{
+			std::string Name;
+			RenderGraphTextureDesc Desc;
+			uint32_t ImportedID = 0;
+			bool Imported = false;
+
+			// Compile results
+			bool Used = false;
+			uint32_t FirstUse = 0xffffffff, LastUse = 0;
+			uint32_t PooledTexture = 0xffffffff;
+			bool Cleared = false;
+		};
+
+		struct Pass
+		{
+			std::string Name;
+			std::vector<RenderGraphResource> Reads;
+			std::vector<RenderGraphResource> Writes;
+			std::function<void()> Execute;
+
+			// Compile results
+			bool Culled = false;
+		};
+
+		struct PooledTexture
+		{
+			uint32_t RendererID = 0;
+			FramebufferTextureFormat Format = FramebufferTextureFormat::None;
+			uint32_t Width = 0, Height = 0;
+			uint32_t LastUse = 0;
+			bool Used = false;
+		};
+
+		uint32_t AcquirePooledTexture(const RenderGraphTextureDesc& desc, uint32_t firstUse);
+		void ReleasePooledTexture(PooledTexture& texture);
+		void BindPassTargets(Pass& pass, uint32_t passIndex);
+
+	private:
+		std::vector<Resource> m_Resources;
+		std::vector<Pass> m_Passes;
+		std::vector<PooledTexture> m_Pool;
+
+		// One framebuffer object per pass index, attachments are swapped when aliasing changes
+		std::vector<uint32_t> m_Framebuffers;
+		std::vector<std::vector<uint32_t>> m_FramebufferAttachments;
+
+		bool m_Compiled = false;
+		uint32_t m_CulledPasses = 0;
+		uint32_t m_TransientTextures = 0;
+		uint64_t m_TransientMemory = 0;
+		uint64_t m_AliasedMemorySaved = 0;
+	};
+
+}
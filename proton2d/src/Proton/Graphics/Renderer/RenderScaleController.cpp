@@ -0,0 +1,85 @@
+//
+// Dynamic resolution scaling.
+// Picks an internal render resolution scale from the measured GPU frame time against a target budget.
+// GPU time of 2D rendering is mostly fill-rate bound, so it is assumed to scale with the pixel count.
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/RenderScaleController.h"
+#include "Proton/Graphics/Renderer/GPUTimer.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	static constexpr float s_FrameTimeSmoothing = 0.1f;
+	static constexpr float s_ScaleStep = 0.05f;        // quantized scale, avoids reallocating for tiny changes
+	static constexpr float s_UpscaleHeadroom = 1.3f;   // budget / time ratio required to scale up
+	static constexpr float s_TargetBudgetUsage = 0.9f; // aim slightly below the budget
+	static constexpr uint32_t s_CooldownFrames = 30;   // wait for new measurements after a change
+
+	RenderScaleController::RenderScaleController()
+		: m_Timer(MakeUnique<GPUTimer>())
+	{
+	}
+
+	RenderScaleController::~RenderScaleController() = default;
+
+	void RenderScaleController::BeginFrame()
+	{
+		float milliseconds;
+		if (m_Timer->PollResult(milliseconds))
+			OnFrameTimeMeasured(milliseconds);
+
+		m_Timer->Begin();
+	}
+
+	void RenderScaleController::EndFrame()
+	{
+		m_Timer->End();
+	}
+
+	void RenderScaleController::SetEnabled(bool enabled)
+	{
+		m_Enabled = enabled;
+		m_RenderScale = m_MaxScale;
+		m_CooldownFrames = s_CooldownFrames;
+	}
+
+	void RenderScaleController::SetScaleRange(float minScale, float maxScale)
+	{
+		m_MinScale = glm::clamp(minScale, s_ScaleStep, 1.0f);
+		m_MaxScale = glm::clamp(maxScale, m_MinScale, 1.0f);
+		m_RenderScale = glm::clamp(m_RenderScale, m_MinScale, m_MaxScale);
+	}
+
+	void RenderScaleController::OnFrameTimeMeasured(float milliseconds)
+	{
+		m_GPUFrameTime = m_GPUFrameTime > 0.0f ? glm::mix(m_GPUFrameTime, milliseconds, s_FrameTimeSmoothing) : milliseconds;
+
+		if (!m_Enabled || m_GPUFrameTime <= 0.0f)
+			return;
+
+		if (m_CooldownFrames)
+		{
+			m_CooldownFrames--;
+			return;
+		}
+
+		// Hysteresis: scale down when over budget, scale up only with enough headroom
+		float budgetRatio = m_TargetFrameTime / m_GPUFrameTime;
+		if (budgetRatio >= 1.0f && budgetRatio <= s_UpscaleHeadroom)
+			return;
+
+		// Pixel count (and GPU time) is proportional to the square of the scale
+		float scale = m_RenderScale * glm::sqrt(budgetRatio * s_TargetBudgetUsage);
+		scale = glm::round(scale / s_ScaleStep) * s_ScaleStep;
+		scale = glm::clamp(scale, m_MinScale, m_MaxScale);
+
+		if (scale != m_RenderScale)
+		{
+			m_RenderScale = scale;
+			m_CooldownFrames = s_CooldownFrames;
+		}
+	}
+
+}
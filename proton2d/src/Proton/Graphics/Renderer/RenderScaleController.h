@@ -0,0 +1,53 @@
+//
+// Dynamic resolution scaling.
+// Picks an internal render resolution scale from the measured GPU frame time against a target budget.
+// GPU time of 2D rendering is mostly fill-rate bound, so it is assumed to scale with the pixel count.
+//
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+namespace proton {
+
+	class GPUTimer;
+
+	class RenderScaleController
+	{
+	public:
+		RenderScaleController();
+		virtual ~RenderScaleController();
+
+		// Enclose GPU work of the scaled render target
+		void BeginFrame();
+		void EndFrame();
+
+		float GetRenderScale() const { return m_Enabled ? m_RenderScale : 1.0f; }
+		float GetGPUFrameTime() const { return m_GPUFrameTime; } // ms, smoothed
+
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return m_Enabled; }
+
+		void SetTargetFrameTime(float milliseconds) { m_TargetFrameTime = milliseconds; }
+		float GetTargetFrameTime() const { return m_TargetFrameTime; }
+
+		void SetScaleRange(float minScale, float maxScale);
+		float GetMinScale() const { return m_MinScale; }
+		float GetMaxScale() const { return m_MaxScale; }
+
+	private:
+		void OnFrameTimeMeasured(float milliseconds);
+
+	private:
+		Unique<GPUTimer> m_Timer;
+
+		bool m_Enabled = false;
+		float m_RenderScale = 1.0f;
+		float m_MinScale = 0.5f;
+		float m_MaxScale = 1.0f;
+		float m_TargetFrameTime = 12.0f; // ms
+
+		float m_GPUFrameTime = 0.0f;
+		uint32_t m_CooldownFrames = 0;
+	};
+
+}
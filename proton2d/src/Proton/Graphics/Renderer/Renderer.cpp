@@ -6,40 +6,68 @@
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/Renderer.h"
 
-#include "Proton/Graphics/Renderer/Shader.h"
-#include "Proton/Graphics/Renderer/UniformBuffer.h"
-#include "Proton/Graphics/Renderer/VertexArray.h"
+#include "Proton/Graphics/Renderer/RendererBackend.h"
 #include "Proton/Graphics/Renderer/Texture.h"
+#include "Proton/Graphics/Renderer/LightGrid.h"
+#include "Proton/Graphics/Renderer/QuadMesh.h"
+#include "Proton/Utils/Utils.h"
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+
 
 namespace proton {
 
-	struct QuadVertex // vertex buffer data
+	//
+	// Multi-view rendering
+	// Batches recorded between BeginFrameBatch/EndFrameBatch are kept on the GPU for the whole frame
+	// and replayed for every view, only the camera uniform buffer and the culling differ between views.
+	//
+
+	// Consecutive primitives of a recorded batch and their world space bounds (per-view culling)
+	struct FrameBatchChunk
 	{
-		glm::vec3 Position;
-		glm::vec4 Color;
-		glm::vec2 TextureCoords;
-		float TextureIndex;
-		float TilingFactor;
+		glm::vec2 Min, Max;
+		uint32_t FirstPrimitive;
+		uint32_t PrimitiveCount;
 	};
 
-	struct LineVertex // vertex buffer data
+	struct FrameBatch
 	{
-		glm::vec3 Position;
-		glm::vec4 Color;
+		RendererPrimitive Type;
+		uint32_t BaseVertex;                 // into the frame vertices of the batch type
+		uint32_t FirstChunk = 0, ChunkCount = 0;
+		uint32_t FirstTexture = 0, TextureCount = 0; // quads only
+		float LineWidth = 1.0f;              // lines only
+		RendererBlendMode BlendMode = RendererBlendMode::Alpha;
 	};
 
-	struct CircleVertex
+	struct FrameBatchData
 	{
-		glm::vec3 WorldPosition;
-		glm::vec3 LocalPosition;
-		glm::vec4 Color;
-		float Thickness;
-		float Fade;
+		static constexpr uint32_t ChunkSize = 256; // primitives
+		static constexpr uint32_t SortGridSize = 1024; // cells per axis of a batch, primitives are ordered along a Morton curve
+
+		bool Recording = false;
+		std::vector<QuadVertex> Quads;
+		std::vector<LineVertex> Lines;
+		std::vector<CircleVertex> Circles;
+		std::vector<FrameBatch> Batches;
+		std::vector<FrameBatchChunk> Chunks;
+		std::vector<Shared<Texture>> Textures;
+
+		// Lights submitted while recording, re-culled for every view
+		std::vector<PointLightData> Lights;
+		bool LightingEnabled = false;
+		glm::vec4 AmbientColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		// Per-view visible primitive ranges (first, count)
+		std::vector<glm::uvec2> DrawRanges;
+
+		// Scratch storage of the spatial sort: primitive centers and (Morton key, primitive index)
+		std::vector<glm::vec2> PrimitiveCenters;
+		std::vector<std::pair<uint32_t, uint32_t>> SortKeys;
 	};
 
 	static struct RendererData
@@ -49,134 +77,73 @@ namespace proton {
 		uint32_t MaxIndices = MaxQuads * 6;
 		uint32_t MaxTextureSlots = 32;
 
-		// Quads OpenGL objects
-		Shared<VertexArray> QuadVertexArray;
-		Shared<VertexBuffer> QuadVertexBuffer;
-		Shared<Shader> QuadShader;
+		Unique<RendererBackend> Backend;
 
 		// Quads VertexBuffer data
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
 		uint32_t QuadIndexCount = 0;
 
-		// Lines OpenGL objects
-		Shared<VertexArray> LineVertexArray;
-		Shared<VertexBuffer> LineVertexBuffer;
-		Shared<Shader> LineShader;
-
 		// Lines VertexBuffer data
 		LineVertex* LineVertexBufferBase = nullptr;
 		LineVertex* LineVertexBufferPtr = nullptr;
 		uint32_t LineVertexCount = 0;
 		float LineWidth = 1.0f;
 
+		RendererBlendMode BlendMode = RendererBlendMode::Alpha;
+
 		// Circles VertexBuffer data
-		Shared<VertexArray> CircleVertexArray;
-		Shared<VertexBuffer> CircleVertexBuffer;
-		Shared<Shader> CircleShader;
 		uint32_t CircleIndexCount = 0;
 		CircleVertex* CircleVertexBufferBase = nullptr;
 		CircleVertex* CircleVertexBufferPtr = nullptr;
 
-		// Textures and camera uniform buffer
+		// Texture slots of the current batch, slot 0 is the white texture (nullptr)
 		std::vector<Shared<Texture>> TextureSlots;
 		uint32_t TextureSlotIndex = 1;
-		Shared<UniformBuffer> CameraUniformBuffer;
+
+		// Lighting
+		Unique<LightGrid> LightGrid;
+		glm::uvec4 Viewport = { 0, 0, 0, 0 }; // x, y, width, height
+
+		// Batches recorded for multi-view rendering
+		FrameBatchData Frame;
+
+		// Render to texture
+		glm::uvec4 PreviousViewport = { 0, 0, 0, 0 };
 
 		// Stats
 		uint32_t OpenGLDrawCalls = 0;
 		uint32_t LastOpenGLDrawCalls = 0;
-	} data;
+		uint32_t LastVisibleLights = 0;
 
-	static void OpenGLMessageCallback(unsigned source, unsigned type, unsigned id, unsigned severity, int length, const char* message, const void* userParam)
-	{
-		switch (severity)
-		{
-		case GL_DEBUG_SEVERITY_HIGH:          PT_CORE_CRITICAL("[OpenGL] {}", message); return;
-		case GL_DEBUG_SEVERITY_MEDIUM:        PT_CORE_WARN("[OpenGL] {}", message); return;
-		case GL_DEBUG_SEVERITY_LOW:           PT_CORE_WARN("[OpenGL] {}", message); return;
-		case GL_DEBUG_SEVERITY_NOTIFICATION:  PT_CORE_INFO("[OpenGL] {}", message); return;
-		}
-	}
+		// Tight sprite meshes, world area of sprites drawn as meshes and of their full quads
+		bool UseSpriteMeshes = false;
+		float SpriteMeshArea = 0.0f;
+		float SpriteQuadArea = 0.0f;
+		float LastSpriteMeshCoverage = 1.0f;
 
-	void Renderer::Init()
-	{
-#	ifdef PROTON_DEBUG
-		glEnable(GL_DEBUG_OUTPUT);
-		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-		glDebugMessageCallback(OpenGLMessageCallback, nullptr);
-		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
-#	endif
-
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_LINE_SMOOTH);
-		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, (int*)&data.MaxTextureSlots);
-
-		// Create quad vertex buffer
-		data.QuadVertexBuffer = MakeShared<VertexBuffer>((uint32_t)(data.MaxVertices * sizeof(QuadVertex)));
-		data.QuadVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "Position"      },
-			{ ShaderDataType::Float4, "Color"         },
-			{ ShaderDataType::Float2, "TextureCoords" },
-			{ ShaderDataType::Float,  "TextureIndex"  },
-			{ ShaderDataType::Float,  "TilingFactor"  }
-		});
-		data.QuadVertexBufferBase = new QuadVertex[data.MaxVertices];
+		RendererDebugMode DebugMode = RendererDebugMode::None;
+	} data;
 
-		// Create quad index buffer data
-		uint32_t* indicies = new uint32_t[data.MaxIndices];
+	void Renderer::Init(RendererBackendType backend)
+	{
+		// Textures are created without GPU objects when there is no context
+		Texture::s_Headless = backend != RendererBackendType::OpenGL;
 
-		for (uint32_t i = 0; i < data.MaxIndices; i++)
-		{
-			uint32_t offset = 4 * (i / 6);
-			constexpr uint32_t quadIndices[] = { 0, 1, 2, 2, 3, 0 };
-			indicies[i] = offset + quadIndices[i % 6];
-		}
+		data.Backend = RendererBackend::Create(backend);
+		data.Backend->Init(data.MaxQuads);
+		data.MaxTextureSlots = data.Backend->GetMaxTextureSlots();
 
-		// Create quad vertex array
-		data.QuadVertexArray = MakeShared<VertexArray>();
-		data.QuadVertexArray->AddVertexBuffer(data.QuadVertexBuffer);
-		Shared<IndexBuffer> quadIB = MakeShared<IndexBuffer>(indicies, data.MaxIndices);
-		data.QuadVertexArray->SetIndexBuffer(quadIB);
-		delete[] indicies;
-
-		// Create line vertex buffer and vertex array
-		data.LineVertexBuffer = MakeShared<VertexBuffer>(data.MaxVertices * (uint32_t)sizeof(LineVertex));
-		data.LineVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "Position" },
-			{ ShaderDataType::Float4, "Color"    }
-		});
+		data.QuadVertexBufferBase = new QuadVertex[data.MaxVertices];
 		data.LineVertexBufferBase = new LineVertex[data.MaxVertices];
-		data.LineVertexArray = MakeShared<VertexArray>();
-		data.LineVertexArray->AddVertexBuffer(data.LineVertexBuffer);
-
-		// Circles
-		data.CircleVertexArray = MakeShared<VertexArray>();
-		data.CircleVertexBuffer = MakeShared<VertexBuffer>(data.MaxVertices * (uint32_t)sizeof(CircleVertex));
-		data.CircleVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "WorldPosition" },
-			{ ShaderDataType::Float3, "LocalPosition" },
-			{ ShaderDataType::Float4, "Color"         },
-			{ ShaderDataType::Float,  "Thickness"     },
-			{ ShaderDataType::Float,  "Fade"          }
-		});
-		data.CircleVertexArray->AddVertexBuffer(data.CircleVertexBuffer);
-		data.CircleVertexArray->SetIndexBuffer(quadIB); // Use quad IB
 		data.CircleVertexBufferBase = new CircleVertex[data.MaxVertices];
 
 		// Init texture slots vector
 		data.TextureSlots.resize(data.MaxTextureSlots);
-		data.TextureSlots[0] = MakeShared<Texture>(1, 1, true); // white texture
+		data.Viewport = data.Backend->GetViewport();
 
-		// Shaders
-		data.QuadShader = MakeShared<Shader>("content/shaders/Quad2D.glsl");
-		data.LineShader = MakeShared<Shader>("content/shaders/Line2D.glsl");
-		data.CircleShader = MakeShared<Shader>("content/shaders/Circle2D.glsl");
-
-		// Camera shader uniform buffer
-		data.CameraUniformBuffer = MakeShared<UniformBuffer>((uint32_t)sizeof(glm::mat4), 0);
+		// Point lights tile grid
+		data.LightGrid = MakeUnique<LightGrid>();
 	
 		SetClearColor(DEFAULT_CLEAR_COLOR);
 	}
@@ -185,6 +152,18 @@ namespace proton {
 	{
 		delete[] data.QuadVertexBufferBase;
 		delete[] data.LineVertexBufferBase;
+		delete[] data.CircleVertexBufferBase;
+		data.LightGrid.reset();
+		data.Frame = FrameBatchData();
+		data.TextureSlots.clear();
+
+		data.Backend->Shutdown();
+		data.Backend.reset();
+	}
+
+	RendererBackend& Renderer::GetBackend()
+	{
+		return *data.Backend;
 	}
 
 	void Renderer::BeginScene(const Camera& camera, const glm::vec3& position)
@@ -192,9 +171,11 @@ namespace proton {
 		PROFILE_FUNCTION();
 		glm::mat4 viewMatrix = glm::inverse(glm::translate(glm::mat4(1.0f), position));
 		glm::mat4 viewProjection = camera.GetProjection() * viewMatrix;
-		data.CameraUniformBuffer->SetData(&viewProjection, sizeof(glm::mat4));
+		data.Backend->SetCamera(viewProjection);
 		data.LastOpenGLDrawCalls = data.OpenGLDrawCalls;
 		data.OpenGLDrawCalls = 0;
+		ResetSpriteMeshStats();
+		data.LightGrid->Begin(viewProjection, data.Viewport);
 		StartBatch();
 	}
 
@@ -220,40 +201,30 @@ namespace proton {
 
 	void Renderer::Flush()
 	{
-		if (data.QuadIndexCount)
+		if (data.Frame.Recording)
 		{
-			uint32_t dataSize = (uint32_t)((uint8_t*)data.QuadVertexBufferPtr - (uint8_t*)data.QuadVertexBufferBase);
-			data.QuadVertexBuffer->SetData(data.QuadVertexBufferBase, dataSize);
+			RecordFrameBatches();
+			return;
+		}
 
-			for (uint32_t i = 0; i < data.TextureSlotIndex; i++)
-				data.TextureSlots[i]->Bind(i);
+		if (data.QuadIndexCount)
+		{
+			data.LightGrid->Upload(*data.Backend);
+			data.LastVisibleLights = data.LightGrid->GetVisibleLightsCount();
 
-			data.QuadShader->Bind();
-			data.QuadVertexArray->Bind();
-			glDrawElements(GL_TRIANGLES, data.QuadIndexCount, GL_UNSIGNED_INT, nullptr);
+			data.Backend->DrawQuads(data.QuadVertexBufferBase, data.QuadIndexCount / 6, data.TextureSlots.data(), data.TextureSlotIndex);
 			data.OpenGLDrawCalls++;
 		}
 
 		if (data.LineVertexCount)
 		{
-			uint32_t dataSize = (uint32_t)((uint8_t*)data.LineVertexBufferPtr - (uint8_t*)data.LineVertexBufferBase);
-			data.LineVertexBuffer->SetData(data.LineVertexBufferBase, dataSize);
-
-			data.LineShader->Bind();
-			data.LineVertexArray->Bind();
-			glLineWidth(data.LineWidth);
-			glDrawArrays(GL_LINES, 0, data.LineVertexCount);
+			data.Backend->DrawLines(data.LineVertexBufferBase, data.LineVertexCount, data.LineWidth);
 			data.OpenGLDrawCalls++;
 		}
 
 		if (data.CircleIndexCount)
 		{
-			uint32_t dataSize = (uint32_t)((uint8_t*)data.CircleVertexBufferPtr - (uint8_t*)data.CircleVertexBufferBase);
-			data.CircleVertexBuffer->SetData(data.CircleVertexBufferBase, dataSize);
-
-			data.CircleShader->Bind();
-			data.CircleVertexArray->Bind();
-			glDrawElements(GL_TRIANGLES, data.CircleIndexCount, GL_UNSIGNED_INT, nullptr);
+			data.Backend->DrawCircles(data.CircleVertexBufferBase, data.CircleIndexCount / 6);
 			data.OpenGLDrawCalls++;
 		}
 	}
@@ -264,6 +235,245 @@ namespace proton {
 		StartBatch();
 	}
 
+	static FrameBatch& RecordFrameBatch(RendererPrimitive type, uint32_t baseVertex)
+	{
+		FrameBatch& batch = data.Frame.Batches.emplace_back();
+		batch.Type = type;
+		batch.BaseVertex = baseVertex;
+		batch.FirstChunk = (uint32_t)data.Frame.Chunks.size();
+		batch.BlendMode = data.BlendMode;
+		return batch;
+	}
+
+	// Bits of the value interleaved with zeros, 16 bits of input
+	static uint32_t SpreadBits(uint32_t value)
+	{
+		value &= 0xffff;
+		value = (value | (value << 8)) & 0x00ff00ff;
+		value = (value | (value << 4)) & 0x0f0f0f0f;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+		return value;
+	}
+
+	// Copy primitives to the frame storage in Morton order of their centers, so consecutive primitives
+	// (and the chunks cut from them) are close to each other in world space whatever the submission order.
+	// Primitives of the same cell keep their submission order. Overlapping primitives of different cells can
+	// swap: at different depths the depth test resolves them like before, at equal depth the one drawn first wins.
+	template<typename TVertex, typename TPositionFn>
+	static void CopySpatiallySorted(std::vector<TVertex>& frameVertices, const TVertex* vertices, uint32_t primitiveCount,
+		uint32_t primitiveVertexCount, TPositionFn getPosition)
+	{
+		auto& centers = data.Frame.PrimitiveCenters;
+		centers.resize(primitiveCount);
+		glm::vec2 min = glm::vec2(FLT_MAX);
+		glm::vec2 max = glm::vec2(-FLT_MAX);
+		for (uint32_t i = 0; i < primitiveCount; i++)
+		{
+			glm::vec2 center = glm::vec2(0.0f);
+			for (uint32_t v = 0; v < primitiveVertexCount; v++)
+				center += glm::vec2(getPosition(vertices[i * primitiveVertexCount + v]));
+			centers[i] = center / (float)primitiveVertexCount;
+			min = glm::min(min, centers[i]);
+			max = glm::max(max, centers[i]);
+		}
+
+		auto& keys = data.Frame.SortKeys;
+		keys.resize(primitiveCount);
+		glm::vec2 cellScale = (float)(FrameBatchData::SortGridSize - 1) / glm::max(max - min, glm::vec2(1e-6f));
+		for (uint32_t i = 0; i < primitiveCount; i++)
+		{
+			glm::uvec2 cell = glm::uvec2((centers[i] - min) * cellScale);
+			keys[i] = { SpreadBits(cell.x) | (SpreadBits(cell.y) << 1), i };
+		}
+		std::sort(keys.begin(), keys.end());
+
+		size_t offset = frameVertices.size();
+		frameVertices.resize(offset + (size_t)primitiveCount * primitiveVertexCount);
+		for (uint32_t i = 0; i < primitiveCount; i++)
+		{
+			const TVertex* source = vertices + keys[i].second * primitiveVertexCount;
+			std::copy(source, source + primitiveVertexCount, frameVertices.begin() + offset + (size_t)i * primitiveVertexCount);
+		}
+	}
+
+	// Copy batch vertices to the frame storage and split them into chunks with world space bounds
+	template<typename TVertex, typename TPositionFn>
+	static FrameBatch& RecordFrameBatch(RendererPrimitive type, std::vector<TVertex>& frameVertices,
+		const TVertex* vertices, uint32_t vertexCount, uint32_t primitiveVertexCount, TPositionFn getPosition)
+	{
+		uint32_t baseVertex = (uint32_t)frameVertices.size();
+		FrameBatch& batch = RecordFrameBatch(type, baseVertex);
+
+		// A single chunk is culled as a whole, its order does not matter for culling
+		uint32_t primitiveCount = vertexCount / primitiveVertexCount;
+		if (primitiveCount > FrameBatchData::ChunkSize)
+			CopySpatiallySorted(frameVertices, vertices, primitiveCount, primitiveVertexCount, getPosition);
+		else
+			frameVertices.insert(frameVertices.end(), vertices, vertices + vertexCount);
+
+		for (uint32_t first = 0; first < primitiveCount; first += FrameBatchData::ChunkSize)
+		{
+			FrameBatchChunk chunk;
+			chunk.FirstPrimitive = first;
+			chunk.PrimitiveCount = glm::min(FrameBatchData::ChunkSize, primitiveCount - first);
+			chunk.Min = glm::vec2(FLT_MAX);
+			chunk.Max = glm::vec2(-FLT_MAX);
+
+			const TVertex* chunkVertices = frameVertices.data() + baseVertex + first * primitiveVertexCount;
+			for (uint32_t i = 0; i < chunk.PrimitiveCount * primitiveVertexCount; i++)
+			{
+				glm::vec2 position = glm::vec2(getPosition(chunkVertices[i]));
+				chunk.Min = glm::min(chunk.Min, position);
+				chunk.Max = glm::max(chunk.Max, position);
+			}
+			data.Frame.Chunks.push_back(chunk);
+		}
+
+		batch.ChunkCount = (uint32_t)data.Frame.Chunks.size() - batch.FirstChunk;
+		return batch;
+	}
+
+	void Renderer::RecordFrameBatches()
+	{
+		PROFILE_FUNCTION();
+
+		// Same batch order as Flush, primitives inside a batch are sorted spatially (see CopySpatiallySorted)
+		if (data.QuadIndexCount)
+		{
+			uint32_t vertexCount = (uint32_t)(data.QuadVertexBufferPtr - data.QuadVertexBufferBase);
+			FrameBatch& batch = RecordFrameBatch(RendererPrimitive::Quad, data.Frame.Quads, data.QuadVertexBufferBase, vertexCount, 4,
+				[](const QuadVertex& vertex) { return glm::vec2(vertex.Position); });
+
+			batch.FirstTexture = (uint32_t)data.Frame.Textures.size();
+			batch.TextureCount = data.TextureSlotIndex;
+			data.Frame.Textures.insert(data.Frame.Textures.end(), data.TextureSlots.begin(), data.TextureSlots.begin() + data.TextureSlotIndex);
+		}
+
+		if (data.LineVertexCount)
+		{
+			FrameBatch& batch = RecordFrameBatch(RendererPrimitive::Line, data.Frame.Lines, data.LineVertexBufferBase, data.LineVertexCount, 2,
+				[](const LineVertex& vertex) { return glm::vec2(vertex.Position); });
+			batch.LineWidth = data.LineWidth;
+		}
+
+		if (data.CircleIndexCount)
+		{
+			uint32_t vertexCount = (uint32_t)(data.CircleVertexBufferPtr - data.CircleVertexBufferBase);
+			RecordFrameBatch(RendererPrimitive::Circle, data.Frame.Circles, data.CircleVertexBufferBase, vertexCount, 4,
+				[](const CircleVertex& vertex) { return glm::vec2(vertex.WorldPosition); });
+		}
+	}
+
+	void Renderer::BeginFrameBatch()
+	{
+		PROFILE_FUNCTION();
+		FrameBatchData& frame = data.Frame;
+		frame.Recording = true;
+		frame.Quads.clear();
+		frame.Lines.clear();
+		frame.Circles.clear();
+		frame.Batches.clear();
+		frame.Chunks.clear();
+		frame.Textures.clear();
+
+		data.LastOpenGLDrawCalls = data.OpenGLDrawCalls;
+		data.OpenGLDrawCalls = 0;
+		ResetSpriteMeshStats();
+		data.LightGrid->Begin(glm::mat4(1.0f), data.Viewport);
+		StartBatch();
+	}
+
+	void Renderer::EndFrameBatch()
+	{
+		PROFILE_FUNCTION();
+		FrameBatchData& frame = data.Frame;
+		Flush(); // records the last batch
+		frame.Recording = false;
+
+		frame.Lights = data.LightGrid->GetSubmittedLights();
+		frame.LightingEnabled = data.LightGrid->IsEnabled();
+		frame.AmbientColor = data.LightGrid->GetAmbientColor();
+
+		data.Backend->UploadFrameVertices(frame.Quads, frame.Lines, frame.Circles);
+		StartBatch();
+	}
+
+	void Renderer::DrawFrameBatch(const Camera& camera, const glm::vec3& position)
+	{
+		PROFILE_FUNCTION();
+		FrameBatchData& frame = data.Frame;
+		PT_CORE_ASSERT(!frame.Recording, "DrawFrameBatch called between BeginFrameBatch and EndFrameBatch!");
+
+		glm::mat4 viewMatrix = glm::inverse(glm::translate(glm::mat4(1.0f), position));
+		glm::mat4 viewProjection = camera.GetProjection() * viewMatrix;
+		data.Backend->SetCamera(viewProjection);
+
+		// View bounds in world space
+		glm::mat4 inverseViewProjection = glm::inverse(viewProjection);
+		glm::vec2 viewMin = glm::vec2(FLT_MAX);
+		glm::vec2 viewMax = glm::vec2(-FLT_MAX);
+		for (const glm::vec2& corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+		{
+			glm::vec4 worldCorner = inverseViewProjection * glm::vec4(corner, 0.0f, 1.0f);
+			viewMin = glm::min(viewMin, glm::vec2(worldCorner) / worldCorner.w);
+			viewMax = glm::max(viewMax, glm::vec2(worldCorner) / worldCorner.w);
+		}
+
+		// Lights of the frame, culled and binned for this view
+		data.LightGrid->Begin(viewProjection, data.Viewport);
+		data.LightGrid->SetAmbientLight(frame.LightingEnabled, frame.AmbientColor);
+		for (const PointLightData& light : frame.Lights)
+			data.LightGrid->Submit(light);
+		data.LightGrid->Upload(*data.Backend);
+		data.LastVisibleLights = data.LightGrid->GetVisibleLightsCount();
+
+		for (const FrameBatch& batch : frame.Batches)
+		{
+			frame.DrawRanges.clear();
+
+			// Visible chunks, adjacent ones are merged into a single range
+			for (uint32_t i = batch.FirstChunk; i < batch.FirstChunk + batch.ChunkCount; i++)
+			{
+				const FrameBatchChunk& chunk = frame.Chunks[i];
+				if (chunk.Max.x < viewMin.x || chunk.Max.y < viewMin.y || chunk.Min.x > viewMax.x || chunk.Min.y > viewMax.y)
+					continue;
+
+				if (frame.DrawRanges.size() && frame.DrawRanges.back().x + frame.DrawRanges.back().y == chunk.FirstPrimitive)
+					frame.DrawRanges.back().y += chunk.PrimitiveCount;
+				else
+					frame.DrawRanges.push_back({ chunk.FirstPrimitive, chunk.PrimitiveCount });
+			}
+
+			if (frame.DrawRanges.empty())
+				continue;
+
+			const Shared<Texture>* textures = batch.TextureCount ? &frame.Textures[batch.FirstTexture] : nullptr;
+			data.Backend->SetBlendMode(batch.BlendMode);
+			data.Backend->DrawFrameRanges(batch.Type, batch.BaseVertex, frame.DrawRanges, textures, batch.TextureCount, batch.LineWidth);
+			data.OpenGLDrawCalls++;
+		}
+		data.Backend->SetBlendMode(data.BlendMode);
+	}
+
+	void Renderer::DrawQuadMesh(QuadMesh& mesh, const glm::mat4& viewProjection)
+	{
+		PROFILE_FUNCTION();
+		PT_CORE_ASSERT(!data.Frame.Recording, "DrawQuadMesh called between BeginFrameBatch and EndFrameBatch!");
+		if (mesh.IsEmpty())
+			return;
+
+		data.Backend->SetCamera(viewProjection);
+
+		// Retained geometry is drawn over the scene and never lit
+		data.LightGrid->Begin(viewProjection, data.Viewport);
+		data.LightGrid->Upload(*data.Backend);
+		data.Backend->SetDepthTest(false);
+		data.Backend->DrawQuadMesh(mesh);
+		data.OpenGLDrawCalls += mesh.GetBatchesCount();
+		data.Backend->SetDepthTest(true);
+	}
+
 	constexpr static glm::vec4 QuadVertexPositions[] = {
 		{ -0.5f, -0.5f, 0.0f, 1.0f },
 		{  0.5f, -0.5f, 0.0f, 1.0f },
@@ -301,9 +511,45 @@ namespace proton {
 
 	void Renderer::DrawQuad(const glm::mat4& transform, const Sprite& sprite, const glm::vec4& tintColor, float tilingFactor)
 	{
+		// Mesh rects are fitted to a single repetition of the texture region
+		const Shared<SpriteMesh>& mesh = sprite.GetSpriteMesh();
+		if (data.UseSpriteMeshes && mesh && tilingFactor == 1.0f)
+		{
+			DrawSpriteMesh(transform, sprite.GetTexture(), sprite.GetTextureCoords(), *mesh, tintColor);
+			return;
+		}
 		DrawQuad(transform, sprite.GetTexture(), sprite.GetTextureCoords(), tintColor, tilingFactor);
 	}
 
+	void Renderer::DrawSpriteMesh(const glm::mat4& transform, const Shared<Texture>& texture,
+		const TextureCoords& textureCoords, const SpriteMesh& mesh, const glm::vec4& tintColor)
+	{
+		PROFILE_FUNCTION();
+
+		float quadArea = glm::abs(transform[0][0] * transform[1][1] - transform[0][1] * transform[1][0]);
+		data.SpriteQuadArea += quadArea;
+		data.SpriteMeshArea += quadArea * mesh.Coverage;
+
+		// Every rect is a quad with texture coords interpolated from the region corners
+		for (const glm::vec4& rect : mesh.Rects)
+		{
+			glm::vec2 min = { rect.x, rect.y };
+			glm::vec2 max = { rect.z, rect.w };
+			glm::mat4 rectTransform = transform * Math::GetTransform({ (min + max) * 0.5f - 0.5f, 0.0f }, max - min);
+
+			TextureCoords rectCoords;
+			const glm::vec2 corners[] = { min, { max.x, min.y }, max, { min.x, max.y } };
+			for (int i = 0; i < 4; i++)
+			{
+				glm::vec2 bottom = glm::mix(textureCoords[0], textureCoords[1], corners[i].x);
+				glm::vec2 top = glm::mix(textureCoords[3], textureCoords[2], corners[i].x);
+				rectCoords[i] = glm::mix(bottom, top, corners[i].y);
+			}
+
+			DrawQuad(rectTransform, texture, rectCoords, tintColor);
+		}
+	}
+
 	void Renderer::DrawQuad(const glm::mat4& transform, const Shared<Texture>& texture,
 		const TextureCoords& textureCoords, const glm::vec4& tintColor, float tilingFactor)
 	{
@@ -438,24 +684,84 @@ namespace proton {
 		data.CircleIndexCount += 6;
 	}
 
+	void Renderer::BeginRenderToTexture(const Shared<Texture>& target, const glm::vec2& worldMin, const glm::vec2& worldMax)
+	{
+		PROFILE_FUNCTION();
+		PT_CORE_ASSERT(!data.Frame.Recording, "Render to texture while recording a frame batch!");
+		uint32_t width = target->GetWidth();
+		uint32_t height = target->GetHeight();
+
+		data.PreviousViewport = data.Viewport;
+		data.Backend->BeginRenderTarget(target);
+
+		glm::mat4 viewProjection = glm::ortho(worldMin.x, worldMax.x, worldMin.y, worldMax.y, -1.0f, 1.0f);
+		data.Backend->SetCamera(viewProjection);
+		data.LightGrid->Begin(viewProjection, { 0, 0, width, height });
+		StartBatch();
+	}
+
+	void Renderer::EndRenderToTexture()
+	{
+		PROFILE_FUNCTION();
+		Flush();
+
+		data.Backend->EndRenderTarget();
+		const glm::uvec4& viewport = data.PreviousViewport;
+		SetViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+	}
+
+	void Renderer::SetLighting(bool enabled, const glm::vec4& ambientColor)
+	{
+		data.LightGrid->SetAmbientLight(enabled, ambientColor);
+		data.LastVisibleLights = 0;
+	}
+
+	void Renderer::SubmitPointLight(const glm::vec2& position, float radius, const glm::vec3& color, float intensity)
+	{
+		data.LightGrid->Submit(position, radius, color, intensity);
+	}
+
 	void Renderer::SetLineWidth(float width)
 	{
 		data.LineWidth = width;
 	}
 
+	void Renderer::SetBlendMode(RendererBlendMode mode)
+	{
+		if (mode == data.BlendMode)
+			return;
+
+		// Quads submitted so far keep the previous mode
+		NextBatch();
+		data.BlendMode = mode;
+		if (!data.Frame.Recording)
+			data.Backend->SetBlendMode(mode);
+	}
+
 	void Renderer::SetClearColor(glm::vec4 color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		data.Backend->SetClearColor(color);
 	}
 
 	void Renderer::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		data.Backend->Clear();
 	}
 
 	void Renderer::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		data.Backend->SetViewport(x, y, width, height);
+		data.Viewport = { x, y, width, height };
+	}
+
+	glm::uvec2 Renderer::GetViewportSize()
+	{
+		return { data.Viewport.z, data.Viewport.w };
+	}
+
+	glm::uvec4 Renderer::GetViewport()
+	{
+		return data.Viewport;
 	}
 
 	void Renderer::SetMaxQuadsCount(uint32_t count)
@@ -465,9 +771,58 @@ namespace proton {
 		data.MaxIndices = data.MaxQuads * 6;
 	}
 
+	uint32_t Renderer::GetMaxQuadsCount()
+	{
+		return data.MaxQuads;
+	}
+
+	uint32_t Renderer::GetMaxTextureSlots()
+	{
+		return data.MaxTextureSlots;
+	}
+
 	uint32_t Renderer::GetDrawCallsCount()
 	{
 		return data.LastOpenGLDrawCalls;
 	}
 
+	void Renderer::SetSpriteMeshes(bool enabled)
+	{
+		data.UseSpriteMeshes = enabled;
+	}
+
+	float Renderer::GetSpriteMeshCoverage()
+	{
+		return data.LastSpriteMeshCoverage;
+	}
+
+	void Renderer::ResetSpriteMeshStats()
+	{
+		data.LastSpriteMeshCoverage = data.SpriteQuadArea > 0.0f ? data.SpriteMeshArea / data.SpriteQuadArea : 1.0f;
+		data.SpriteMeshArea = 0.0f;
+		data.SpriteQuadArea = 0.0f;
+	}
+
+	uint32_t Renderer::GetVisibleLightsCount()
+	{
+		return data.LastVisibleLights;
+	}
+
+	void Renderer::SetDebugMode(RendererDebugMode mode)
+	{
+		data.DebugMode = mode;
+		data.Backend->SetDebugMode(mode);
+	}
+
+	RendererDebugMode Renderer::GetDebugMode()
+	{
+		return data.DebugMode;
+	}
+
+	void Renderer::ResolveOverdraw(uint32_t countTextureID)
+	{
+		PROFILE_FUNCTION();
+		data.Backend->ResolveOverdraw(countTextureID);
+	}
+
 }
@@ -9,14 +9,19 @@
 
 #include "Proton/Graphics/Sprite.h"
 #include "Proton/Graphics/Camera.h"
+#include "Proton/Graphics/Renderer/RendererBackend.h"
 
 namespace proton {
 
+	class QuadMesh;
+
 	class Renderer
 	{
 	public:
-		static void Init();
+		// Null and Recording backends run the render path without a GPU context (headless benchmarks)
+		static void Init(RendererBackendType backend = RendererBackendType::OpenGL);
 		static void Shutdown();
+		static RendererBackend& GetBackend();
 
 		static void BeginScene(const Camera& camera, const glm::vec3& position);
 		static void EndScene();
@@ -26,6 +31,10 @@ namespace proton {
 		static void DrawQuad(const glm::mat4& transform, const Sprite& sprite, const glm::vec4& tintColor = glm::vec4(1.0f), float tilingFactor = 1.0f);
 		static void DrawQuad(const glm::mat4& transform, const Shared<Texture>& texture, const TextureCoords& textureCoords, const glm::vec4& tintColor, float tilingFactor = 1.0f);
 
+		// Draw only the rects of a tight sprite mesh covering the texture region (see SpriteMesh).
+		// DrawQuad with a Sprite uses it automatically when sprite meshes are enabled.
+		static void DrawSpriteMesh(const glm::mat4& transform, const Shared<Texture>& texture, const TextureCoords& textureCoords, const SpriteMesh& mesh, const glm::vec4& tintColor);
+
 		static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
 		static void DrawRect(const glm::mat4& transform, const glm::vec4& color);
 		static void DrawDashedRect(const glm::mat4& transform, const glm::vec4& color, float lineScale = 1.0f);
@@ -35,17 +44,60 @@ namespace proton {
 		
 		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f);
 
+		// Multi-view rendering (split-screen, minimap).
+		// Draw calls between BeginFrameBatch and EndFrameBatch are recorded instead of drawn,
+		// DrawFrameBatch then replays them into the current framebuffer and viewport with its own camera and culling.
+		// Recorded batches stay valid until the next BeginFrameBatch.
+		static void BeginFrameBatch();
+		static void EndFrameBatch();
+		static void DrawFrameBatch(const Camera& camera, const glm::vec3& position);
+
+		// Render to texture (sprite impostors). Draw calls between these are rendered into the target texture,
+		// with world region worldMin..worldMax mapped onto the whole texture. Not allowed while recording a frame batch.
+		static void BeginRenderToTexture(const Shared<Texture>& target, const glm::vec2& worldMin, const glm::vec2& worldMax);
+		static void EndRenderToTexture();
+
+		// Retained quad geometry (runtime UI), drawn over the current framebuffer without depth testing.
+		// The mesh is uploaded only when it changed since the last draw. Not allowed while recording a frame batch.
+		static void DrawQuadMesh(QuadMesh& mesh, const glm::mat4& viewProjection);
+
+		// 2D lighting (Quad2D only). Call after BeginScene (or BeginFrameBatch), before any quad is flushed.
+		// Lighting is disabled by default on each BeginScene.
+		static void SetLighting(bool enabled, const glm::vec4& ambientColor);
+		static void SubmitPointLight(const glm::vec2& position, float radius, const glm::vec3& color, float intensity = 1.0f);
+
 		static void SetLineWidth(float width);
+		// Blending of the following draws, Premultiplied for textures rendered with BeginRenderToTexture.
+		// Changing the mode starts a new batch, set it back to Alpha when done.
+		static void SetBlendMode(RendererBlendMode mode);
 		static void SetClearColor(glm::vec4 color);
 		static void Clear();
 		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static glm::uvec2 GetViewportSize();
+		static glm::uvec4 GetViewport(); // x, y, width, height
 
 		static void SetMaxQuadsCount(uint32_t count);
+		static uint32_t GetMaxQuadsCount();
+		static uint32_t GetMaxTextureSlots();
 		static uint32_t GetDrawCallsCount();
+		static uint32_t GetVisibleLightsCount();
+
+		// Sprites drawn with their tight meshes instead of full quads (disabled by default)
+		static void SetSpriteMeshes(bool enabled);
+		// Drawn sprite mesh area relative to full quads in the last scene (1.0 - no reduction)
+		static float GetSpriteMeshCoverage();
+
+		// Debug visualization of the Quad2D path. In overdraw mode the scene has to be rendered into a RGBA16F
+		// texture cleared to zero, then ResolveOverdraw draws its color ramp into the bound framebuffer.
+		static void SetDebugMode(RendererDebugMode mode);
+		static RendererDebugMode GetDebugMode();
+		static void ResolveOverdraw(uint32_t countTextureID);
 		
 	private:
 		static void StartBatch();
 		static void NextBatch();
+		static void RecordFrameBatches();
+		static void ResetSpriteMeshStats();
 	};
 
 }
@@ -0,0 +1,22 @@
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/RendererBackend.h"
+#include "Proton/Graphics/Renderer/OpenGLRendererBackend.h"
+#include "Proton/Graphics/Renderer/NullRendererBackend.h"
+#include "Proton/Graphics/Renderer/RecordingRendererBackend.h"
+
+namespace proton {
+
+	Unique<RendererBackend> RendererBackend::Create(RendererBackendType type)
+	{
+		switch (type)
+		{
+		case RendererBackendType::OpenGL:    return MakeUnique<OpenGLRendererBackend>();
+		case RendererBackendType::Null:      return MakeUnique<NullRendererBackend>();
+		case RendererBackendType::Recording: return MakeUnique<RecordingRendererBackend>();
+		}
+
+		PT_CORE_ASSERT(false, "Unknown renderer backend!");
+		return nullptr;
+	}
+
+}
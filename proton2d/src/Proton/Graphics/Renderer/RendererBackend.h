@@ -0,0 +1,105 @@
+//
+// Renderer backend interface.
+// Renderer builds batches, records frame batches and bins lights on the CPU, every GPU operation
+// goes through the active backend. Besides OpenGL there are two backends without a GPU context:
+// Null discards everything and Recording keeps the submitted batches in memory, so the CPU cost
+// of the render path can be measured and its output inspected headless.
+//
+#pragma once
+
+#include "Proton/Graphics/Renderer/QuadMesh.h"
+#include "Proton/Graphics/Renderer/LightGrid.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	class Texture;
+
+	struct LineVertex // vertex buffer data
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+	};
+
+	struct CircleVertex
+	{
+		glm::vec3 WorldPosition;
+		glm::vec3 LocalPosition;
+		glm::vec4 Color;
+		float Thickness;
+		float Fade;
+	};
+
+	enum class RendererBackendType
+	{
+		OpenGL = 0, Null, Recording
+	};
+
+	enum class RendererPrimitive : uint8_t
+	{
+		Quad, Line, Circle
+	};
+
+	// Quad2D shader variants for finding fill rate and batching problems
+	enum class RendererDebugMode
+	{
+		None = 0,
+		Overdraw,    // additive fragment count of quads (lines and circles are skipped), shown with ResolveOverdraw
+		BatchID,     // quads colored by the draw call they landed in (per view)
+		TextureSlot  // quads colored by their texture slot
+	};
+
+	enum class RendererBlendMode
+	{
+		Alpha = 0,
+		Premultiplied // color already multiplied by alpha (render target contents)
+	};
+
+	class RendererBackend
+	{
+	public:
+		virtual ~RendererBackend() = default;
+
+		static Unique<RendererBackend> Create(RendererBackendType type);
+
+		virtual RendererBackendType GetType() const = 0;
+
+		virtual void Init(uint32_t maxQuads) = 0;
+		virtual void Shutdown() = 0;
+		virtual uint32_t GetMaxTextureSlots() const = 0;
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+		virtual glm::uvec4 GetViewport() const = 0; // x, y, width, height
+		virtual void SetClearColor(const glm::vec4& color) = 0;
+		virtual void Clear() = 0;
+		virtual void SetDepthTest(bool enabled) = 0;
+		virtual void SetBlendMode(RendererBlendMode mode) = 0;
+		virtual void SetCamera(const glm::mat4& viewProjection) = 0;
+		virtual void UploadLightGrid(const LightGridHeader& header, const std::vector<PointLightData>& lights,
+			const std::vector<glm::uvec2>& tileRanges, const std::vector<uint32_t>& tileLightIndices) = 0;
+
+		// Batches, textures are bound to slots 0..textureCount-1 (nullptr is the white texture)
+		virtual void DrawQuads(const QuadVertex* vertices, uint32_t quadCount, const Shared<Texture>* textures, uint32_t textureCount) = 0;
+		virtual void DrawLines(const LineVertex* vertices, uint32_t vertexCount, float lineWidth) = 0;
+		virtual void DrawCircles(const CircleVertex* vertices, uint32_t circleCount) = 0;
+
+		// Frame batches: vertices are uploaded once per frame, then drawn per view in primitive ranges
+		// (first, count) relative to the base vertex of the batch
+		virtual void UploadFrameVertices(const std::vector<QuadVertex>& quads, const std::vector<LineVertex>& lines, const std::vector<CircleVertex>& circles) = 0;
+		virtual void DrawFrameRanges(RendererPrimitive primitive, uint32_t baseVertex, const std::vector<glm::uvec2>& ranges,
+			const Shared<Texture>* textures, uint32_t textureCount, float lineWidth) = 0;
+
+		// Retained geometry, uploaded only when the mesh changed. One draw per mesh batch.
+		virtual void DrawQuadMesh(QuadMesh& mesh) = 0;
+
+		// Draws between these go to the target texture (cleared to transparent), with alpha accumulated
+		virtual void BeginRenderTarget(const Shared<Texture>& target) = 0;
+		virtual void EndRenderTarget() = 0;
+
+		virtual void SetDebugMode(RendererDebugMode mode) = 0;
+		// Maps the fragment counts of the overdraw mode (RGBA16F texture) to a color ramp in the bound framebuffer
+		virtual void ResolveOverdraw(uint32_t countTextureID) = 0;
+	};
+
+}
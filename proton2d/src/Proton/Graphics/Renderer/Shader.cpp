@@ -5,6 +5,7 @@
 //
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/Shader.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 #include "Proton/Utils/Utils.h"
 
 #include <filesystem>
@@ -14,20 +15,38 @@
 
 namespace proton {
 
-	Shader::Shader(const std::string& filePath)
+	Shader::Shader(const std::string& filePath, const std::vector<std::string>& defines)
 		: m_Name(std::filesystem::path(filePath).stem().string())
 	{
-		std::string vertexSource = Utils::ReadFile(filePath + ".vert");
-		std::string fragmentSource = Utils::ReadFile(filePath + ".frag");
+		std::string vertexSource = InsertDefines(Utils::ReadFile(filePath + ".vert"), defines);
+		std::string fragmentSource = InsertDefines(Utils::ReadFile(filePath + ".frag"), defines);
 
 		Compile({ {GL_VERTEX_SHADER, vertexSource}, {GL_FRAGMENT_SHADER, fragmentSource} });
 	}
 
 	Shader::~Shader()
 	{
+		GLState::OnProgramDeleted(m_Object_ID);
 		glDeleteProgram(m_Object_ID);
 	}
 
+	std::string Shader::InsertDefines(const std::string& source, const std::vector<std::string>& defines)
+	{
+		if (defines.empty())
+			return source;
+
+		std::string defineLines;
+		for (const std::string& define : defines)
+			defineLines += "#define " + define + "\n";
+
+		// #version must stay the first directive
+		size_t version = source.find("#version");
+		size_t lineEnd = version == std::string::npos ? std::string::npos : source.find('\n', version);
+		if (lineEnd == std::string::npos)
+			return defineLines + source;
+		return source.substr(0, lineEnd + 1) + defineLines + source.substr(lineEnd + 1);
+	}
+
 	void Shader::Compile(const std::unordered_map<GLenum, std::string>& shaderSources)
 	{
 		GLuint program = glCreateProgram();
@@ -98,12 +117,12 @@ namespace proton {
 
 	void Shader::Bind() const
 	{
-		glUseProgram(m_Object_ID);
+		GLState::UseProgram(m_Object_ID);
 	}
 
 	void Shader::Unbind() const
 	{
-		glUseProgram(0);
+		GLState::UseProgram(0);
 	}
 
 	void Shader::SetInt(const std::string& name, int value)
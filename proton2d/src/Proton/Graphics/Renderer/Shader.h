@@ -14,7 +14,8 @@ namespace proton {
 	class Shader
 	{
 	public:
-		Shader(const std::string& filePath);
+		// Defines are inserted after the #version line of every stage (shader variants)
+		Shader(const std::string& filePath, const std::vector<std::string>& defines = {});
 		virtual ~Shader();
 
 		void Bind() const;
@@ -32,6 +33,7 @@ namespace proton {
 		const std::string& GetName() const { return m_Name; }
 	
 	private:
+		static std::string InsertDefines(const std::string& source, const std::vector<std::string>& defines);
 		void Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
 	
 	private:
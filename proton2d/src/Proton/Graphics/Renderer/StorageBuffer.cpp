@@ -0,0 +1,38 @@
+//
+// This file provides functionalities for creation, binding, and data handling of OpenGL shader storage buffers.
+// Mirrors the UniformBuffer class, but the buffer grows on demand so it can hold variable-length arrays.
+//
+#include "ptpch.h"
+#include "Proton/Graphics/Renderer/StorageBuffer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
+
+#include <glad/glad.h>
+
+namespace proton {
+
+	StorageBuffer::StorageBuffer(uint32_t size, uint32_t binding)
+		: m_Binding(binding), m_Size(size)
+	{
+		glCreateBuffers(1, &m_Object_ID);
+		glNamedBufferData(m_Object_ID, size, nullptr, GL_DYNAMIC_DRAW);
+		GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_Object_ID);
+	}
+
+	StorageBuffer::~StorageBuffer()
+	{
+		GLState::OnBufferDeleted(m_Object_ID);
+		glDeleteBuffers(1, &m_Object_ID);
+	}
+
+	void StorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		if (offset + size > m_Size)
+		{
+			// Grow by half to avoid reallocating every frame when the light count creeps up
+			m_Size = (offset + size) + (offset + size) / 2;
+			glNamedBufferData(m_Object_ID, m_Size, nullptr, GL_DYNAMIC_DRAW);
+		}
+		glNamedBufferSubData(m_Object_ID, offset, size, data);
+	}
+
+}
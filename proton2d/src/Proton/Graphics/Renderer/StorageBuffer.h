@@ -0,0 +1,25 @@
+//
+// This file provides functionalities for creation, binding, and data handling of OpenGL shader storage buffers.
+// Mirrors the UniformBuffer class, but the buffer grows on demand so it can hold variable-length arrays.
+//
+#pragma once
+
+namespace proton {
+
+	class StorageBuffer
+	{
+	public:
+		StorageBuffer(uint32_t size, uint32_t binding);
+		virtual ~StorageBuffer();
+
+		// Reallocates buffer storage if data does not fit into the current buffer.
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0);
+
+		uint32_t GetSize() const { return m_Size; }
+
+	private:
+		uint32_t m_Object_ID = 0;
+		uint32_t m_Binding = 0;
+		uint32_t m_Size = 0;
+	};
+}
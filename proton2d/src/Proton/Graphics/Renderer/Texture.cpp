@@ -5,18 +5,46 @@
 //
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/Texture.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 
 #include <glad/glad.h>
 #include <stb_image.h>
 
 namespace proton {
 
+	TextureImage::TextureImage(const std::string& path)
+		: Path(path)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(1);
+		Pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+		if (!Pixels)
+			return;
+
+		Width = width;
+		Height = height;
+		Channels = channels;
+
+		if (channels == 4)
+		{
+			size_t pixels = (size_t)Width * (size_t)Height;
+			AlphaMask.resize(pixels);
+			for (size_t i = 0; i < pixels; i++)
+				AlphaMask[i] = Pixels[i * 4 + 3] != 0;
+		}
+	}
+
+	TextureImage::~TextureImage()
+	{
+		if (Pixels)
+			stbi_image_free(Pixels);
+	}
+
 	Texture::Texture(uint32_t width, uint32_t height, bool fillDataWhitePixels)
 		: m_Width(width), m_Height(height),
 		m_InternalFormat(GL_RGBA8), m_DataFormat(GL_RGBA)
 	{
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_Object_ID);
-		glTextureStorage2D(m_Object_ID, 1, m_InternalFormat, m_Width, m_Height);
+		CreateObject();
 
 		SetFilterMode(TextureFilterMode::Nearest);
 		SetWrapMode(TextureWrapMode::Repeat);
@@ -33,58 +61,90 @@ namespace proton {
 	}
 
 	Texture::Texture(const std::string& path)
-		: m_Path(path)
+		: Texture(TextureImage(path))
 	{
-		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* data = stbi_load((path).c_str(), &width, &height, &channels, 0);
-			
-		if (data)
-		{
-			m_IsLoaded = true;
-			m_Width = width;
-			m_Height = height;
+	}
 
-			if (channels == 4)
-			{
-				m_InternalFormat = GL_RGBA8;
-				m_DataFormat = GL_RGBA;
-			}
-			else if (channels == 3)
-			{
-				m_InternalFormat = GL_RGB8;
-				m_DataFormat = GL_RGB;
-			}
+	Texture::Texture(TextureImage&& image)
+		: m_Path(image.Path)
+	{
+		if (!image.IsLoaded())
+			return;
+
+		m_IsLoaded = true;
+		m_Width = image.Width;
+		m_Height = image.Height;
+
+		if (image.Channels == 4)
+		{
+			m_InternalFormat = GL_RGBA8;
+			m_DataFormat = GL_RGBA;
+		}
+		else if (image.Channels == 3)
+		{
+			m_InternalFormat = GL_RGB8;
+			m_DataFormat = GL_RGB;
+		}
 
-			PT_CORE_ASSERT(m_InternalFormat & m_DataFormat && "Format not supported!");
+		PT_CORE_ASSERT(m_InternalFormat & m_DataFormat && "Format not supported!");
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_Object_ID);
-			glTextureStorage2D(m_Object_ID, 1, m_InternalFormat, m_Width, m_Height);
+		CreateObject();
 
-			SetFilterMode(TextureFilterMode::Nearest);
-			SetWrapMode(TextureWrapMode::Repeat);
+		SetFilterMode(TextureFilterMode::Nearest);
+		SetWrapMode(TextureWrapMode::Repeat);
 
-			glTextureSubImage2D(m_Object_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		if (!s_Headless)
+			glTextureSubImage2D(m_Object_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, image.Pixels);
 
-			stbi_image_free(data);
+		if (image.Channels == 4)
+		{
+			m_AlphaMask = std::move(image.AlphaMask);
+			m_SpriteMesh = GetSpriteMesh({ 0, 0 }, { m_Width, m_Height });
 		}
 	}
 
 	Texture::~Texture()
 	{
-		glDeleteTextures(1, &m_Object_ID);
+		if (s_Headless)
+			return;
+
+		uint32_t objectID = m_Object_ID;
+		auto deletion = [objectID]()
+		{
+			GLState::OnTextureDeleted(objectID);
+			glDeleteTextures(1, &objectID);
+		};
+
+		if (!GLState::DeferDeletion("Texture::Delete", deletion))
+			deletion();
+	}
+
+	void Texture::CreateObject()
+	{
+		if (s_Headless)
+		{
+			m_Object_ID = ++s_HeadlessObjectsCount;
+			return;
+		}
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_Object_ID);
+		glTextureStorage2D(m_Object_ID, 1, m_InternalFormat, m_Width, m_Height);
 	}
 
 	void Texture::SetData(void* data, size_t size)
 	{
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		PT_CORE_ASSERT(size == m_Width * m_Height * bpp && "Data must be entire texture!");
-		glTextureSubImage2D(m_Object_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		if (!s_Headless)
+			glTextureSubImage2D(m_Object_ID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
 	}
 
 	void Texture::SetFilterMode(TextureFilterMode mode)
 	{
 		m_FilterMode = mode;
+		if (s_Headless)
+			return;
+
 		if (mode == TextureFilterMode::Nearest)
 		{
 			glTextureParameteri(m_Object_ID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -116,14 +176,31 @@ namespace proton {
 	void Texture::SetWrapMode(TextureWrapMode xMode, TextureWrapMode yMode)
 	{
 		m_WrapModeX = xMode; m_WrapModeY = yMode;
+		if (s_Headless)
+			return;
+
 		GLenum sWrap = ProtonWrapModeToOpenGL(xMode);
 		GLenum tWrap = ProtonWrapModeToOpenGL(yMode);
 		glTextureParameteri(m_Object_ID, GL_TEXTURE_WRAP_S, sWrap);
 		glTextureParameteri(m_Object_ID, GL_TEXTURE_WRAP_T, tWrap);
 	}
 
+	Shared<SpriteMesh> Texture::GetSpriteMesh(const glm::uvec2& position, const glm::uvec2& size) const
+	{
+		PT_CORE_ASSERT(position.x + size.x <= m_Width && position.y + size.y <= m_Height, "Region out of texture bounds!");
+
+		// Texture sizes fit in 16 bits (GL_MAX_TEXTURE_SIZE)
+		uint64_t key = (uint64_t)position.x | (uint64_t)position.y << 16 | (uint64_t)size.x << 32 | (uint64_t)size.y << 48;
+		std::lock_guard<std::mutex> lock(m_RegionSpriteMeshesMutex);
+		Shared<SpriteMesh>& mesh = m_RegionSpriteMeshes[key];
+		if (!mesh)
+			mesh = MakeShared<SpriteMesh>(SpriteMesh::Generate(m_AlphaMask, m_Width, position, size));
+		return mesh;
+	}
+
 	void Texture::Bind(uint32_t slot) const
 	{
-		glBindTextureUnit(slot, m_Object_ID);
+		if (!s_Headless)
+			GLState::BindTextureUnit(slot, m_Object_ID);
 	}
 }
@@ -6,6 +6,9 @@
 #pragma once
 
 #include "Proton/Core/Base.h"
+#include "Proton/Graphics/SpriteMesh.h"
+
+#include <mutex>
 
 // Forward declaration
 typedef unsigned int GLenum;
@@ -22,11 +25,31 @@ namespace proton {
 		Repeat, ClampToBorder, ClampToEdge
 	};
 
+	// Decoded image file, does not touch OpenGL and can be loaded on any thread.
+	// Uploaded on the main thread by the Texture constructor.
+	struct TextureImage
+	{
+		std::string Path;
+		uint32_t Width = 0, Height = 0;
+		uint32_t Channels = 0;
+		unsigned char* Pixels = nullptr;
+		std::vector<bool> AlphaMask; // RGBA images only
+
+		TextureImage(const std::string& path);
+		~TextureImage();
+
+		TextureImage(const TextureImage&) = delete;
+		TextureImage& operator=(const TextureImage&) = delete;
+
+		bool IsLoaded() const { return Pixels != nullptr; }
+	};
+
 	class Texture
 	{
 	public:
 		Texture(uint32_t width, uint32_t height, bool fillDataWhitePixels = false);
 		Texture(const std::string& path);
+		Texture(TextureImage&& image);
 		virtual ~Texture();
 
 		uint32_t GetOpenGL_ID() const { return m_Object_ID; }
@@ -39,6 +62,11 @@ namespace proton {
 		void SetData(void* data, size_t size);
 		bool IsLoaded() const { return m_IsLoaded; }
 
+		// Tight mesh of the whole texture, generated on load
+		const Shared<SpriteMesh>& GetSpriteMesh() const { return m_SpriteMesh; }
+		// Tight mesh of a texture region (pixels, bottom left origin), generated once per region and shared
+		Shared<SpriteMesh> GetSpriteMesh(const glm::uvec2& position, const glm::uvec2& size) const;
+
 		TextureFilterMode GetFilterMode() const { return m_FilterMode; }
 		std::pair< TextureWrapMode, TextureWrapMode> GetWrapMode() const { return { m_WrapModeX, m_WrapModeY }; }
 
@@ -51,6 +79,9 @@ namespace proton {
 			return m_Object_ID == other.m_Object_ID;
 		}
 
+	private:
+		void CreateObject();
+
 	private:
 		bool m_IsLoaded = false;
 		std::string m_Path;
@@ -62,7 +93,19 @@ namespace proton {
 		TextureWrapMode m_WrapModeX = TextureWrapMode::Repeat;
 		TextureWrapMode m_WrapModeY = TextureWrapMode::Repeat;
 
+		// Not fully transparent pixels (RGBA textures only), kept for spritesheet regions
+		std::vector<bool> m_AlphaMask;
+		Shared<SpriteMesh> m_SpriteMesh = MakeShared<SpriteMesh>();
+		// Region meshes by packed position and size, sprites recompute their coords from worker threads
+		mutable std::unordered_map<uint64_t, Shared<SpriteMesh>> m_RegionSpriteMeshes;
+		mutable std::mutex m_RegionSpriteMeshesMutex;
+
+		// Set by Renderer::Init for backends without a GPU context, textures then only get unique ids
+		static inline bool s_Headless = false;
+		static inline uint32_t s_HeadlessObjectsCount = 0;
+
 		friend class SceneSerializer;
+		friend class Renderer;
 	};
 
 }
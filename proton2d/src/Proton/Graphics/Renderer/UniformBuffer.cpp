@@ -5,6 +5,7 @@
 //
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/UniformBuffer.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 
 #include <glad/glad.h>
 
@@ -14,11 +15,12 @@ namespace proton {
 	{
 		glCreateBuffers(1, &m_Object_ID);
 		glNamedBufferData(m_Object_ID, size, nullptr, GL_DYNAMIC_DRAW);
-		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_Object_ID);
+		GLState::BindBufferBase(GL_UNIFORM_BUFFER, binding, m_Object_ID);
 	}
 
 	UniformBuffer::~UniformBuffer()
 	{
+		GLState::OnBufferDeleted(m_Object_ID);
 		glDeleteBuffers(1, &m_Object_ID);
 	}
 
@@ -7,6 +7,7 @@
 
 #include "ptpch.h"
 #include "Proton/Graphics/Renderer/VertexArray.h"
+#include "Proton/Graphics/Renderer/GLState.h"
 
 #include <glad/glad.h>
 
@@ -40,24 +41,32 @@ namespace proton {
 
 	VertexArray::~VertexArray()
 	{
-		glDeleteVertexArrays(1, &m_Object_ID);
+		uint32_t objectID = m_Object_ID;
+		auto deletion = [objectID]()
+		{
+			GLState::OnVertexArrayDeleted(objectID);
+			glDeleteVertexArrays(1, &objectID);
+		};
+
+		if (!GLState::DeferDeletion("VertexArray::Delete", deletion))
+			deletion();
 	}
 
 	void VertexArray::Bind() const
 	{
-		glBindVertexArray(m_Object_ID);
+		GLState::BindVertexArray(m_Object_ID);
 	}
 
 	void VertexArray::Unbind() const
 	{
-		glBindVertexArray(0);
+		GLState::BindVertexArray(0);
 	}
 
 	void VertexArray::AddVertexBuffer(const Shared<VertexBuffer>& vertexBuffer)
 	{
 		PT_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_Object_ID);
+		GLState::BindVertexArray(m_Object_ID);
 		vertexBuffer->Bind();
 
 		const auto& layout = vertexBuffer->GetLayout();
@@ -123,7 +132,7 @@ namespace proton {
 
 	void VertexArray::SetIndexBuffer(const Shared<IndexBuffer>& indexBuffer)
 	{
-		glBindVertexArray(m_Object_ID);
+		GLState::BindVertexArray(m_Object_ID);
 		indexBuffer->Bind();
 
 		m_IndexBuffer = indexBuffer;
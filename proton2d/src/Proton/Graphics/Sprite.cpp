@@ -73,13 +73,15 @@ namespace proton {
 		if (!m_Spritesheet)
 		{
 			m_TextureCoords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+			m_SpriteMesh = m_Texture ? m_Texture->GetSpriteMesh() : nullptr;
 			return;
 		}
 		
 		// Single tile (1x1) coords
 		if (m_TileSize.x == 1 && m_TileSize.y == 1)
 		{
-			m_TextureCoords = m_Spritesheet->GetTextureCoords(m_TilePos.x, m_TilePos.y);;
+			m_TextureCoords = m_Spritesheet->GetTextureCoords(m_TilePos.x, m_TilePos.y);
+			m_SpriteMesh = m_Spritesheet->GetSpriteMesh(m_TilePos.x, m_TilePos.y);
 			return;
 		}
 		
@@ -98,6 +100,10 @@ namespace proton {
 		m_TextureCoords[2] = topRightCoords[2];
 		// Change top left y 
 		m_TextureCoords[3].y = topRightCoords[3].y;
+
+		// Regions of multiple tiles are generated on first use and cached by the texture
+		glm::uvec2 tileSize = m_Spritesheet->m_TileSize;
+		m_SpriteMesh = m_Texture->GetSpriteMesh(m_TilePos * tileSize, (s - m_TilePos + 1u) * tileSize);
 	}
 
 	const TextureCoords& Sprite::GetTextureCoords() const
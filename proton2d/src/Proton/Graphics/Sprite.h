@@ -33,12 +33,14 @@ namespace proton {
 	private:
 		void CalculateTextureCoords();
 		const TextureCoords& GetTextureCoords() const;
+		const Shared<SpriteMesh>& GetSpriteMesh() const { return m_SpriteMesh; }
 		
 	private:
 		Shared<Texture> m_Texture = nullptr;
 		Shared<Spritesheet> m_Spritesheet = nullptr;
 
 		TextureCoords m_TextureCoords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+		Shared<SpriteMesh> m_SpriteMesh = nullptr; // covers the texture coords region
 		
 		glm::uvec2 m_PixelSize = { 0, 0 };
 		glm::uvec2 m_TilePos   = { 0, 0 };
@@ -46,6 +48,7 @@ namespace proton {
 		bool m_MirrorFlipX = false, m_MirrorFlipY = false;
 
 		friend class Renderer;
+		friend class SpriteImpostorCache;
 		friend class Scene;
 		friend class Entity;
 		friend class AssetManager;
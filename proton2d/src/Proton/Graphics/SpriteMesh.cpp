@@ -0,0 +1,116 @@
+#include "ptpch.h"
+#include "Proton/Graphics/SpriteMesh.h"
+
+namespace proton {
+
+	struct SpriteMeshRect
+	{
+		uint32_t MinX, MinY, MaxX, MaxY; // pixels
+	};
+
+	// Horizontal runs of covered columns per band, bands with the same runs are merged into one rect
+	static void BuildBandRects(const std::vector<bool>& alphaMask, uint32_t maskWidth, const glm::uvec2& regionPosition,
+		const glm::uvec2& regionSize, uint32_t bandHeight, uint32_t minGap, std::vector<SpriteMeshRect>& rects)
+	{
+		std::vector<bool> columns(regionSize.x);
+		std::vector<SpriteMeshRect> openRects, bandRects;
+		rects.clear();
+
+		for (uint32_t bandMin = 0; bandMin < regionSize.y; bandMin += bandHeight)
+		{
+			uint32_t bandMax = glm::min(bandMin + bandHeight, regionSize.y);
+
+			// One pixel border around covered pixels, linear filtering bleeds into neighbours
+			uint32_t rowMin = bandMin ? bandMin - 1 : 0;
+			uint32_t rowMax = glm::min(bandMax + 1, regionSize.y);
+			std::fill(columns.begin(), columns.end(), false);
+			for (uint32_t y = rowMin; y < rowMax; y++)
+			{
+				size_t rowOffset = (size_t)(regionPosition.y + y) * maskWidth + regionPosition.x;
+				for (uint32_t x = 0; x < regionSize.x; x++)
+				{
+					if (alphaMask[rowOffset + x])
+						columns[x] = true;
+				}
+			}
+
+			bandRects.clear();
+			for (uint32_t x = 0; x < regionSize.x;)
+			{
+				if (!columns[x])
+				{
+					x++;
+					continue;
+				}
+
+				uint32_t runMin = x ? x - 1 : 0;
+				while (x < regionSize.x && columns[x])
+					x++;
+				uint32_t runMax = glm::min(x + 1, regionSize.x);
+
+				// Small gaps are not worth an extra rect
+				if (bandRects.size() && runMin < bandRects.back().MaxX + minGap)
+					bandRects.back().MaxX = runMax;
+				else
+					bandRects.push_back({ runMin, bandMin, runMax, bandMax });
+			}
+
+			// Extend rects of the previous band with the same extents, close the others
+			for (SpriteMeshRect& rect : bandRects)
+			{
+				for (auto it = openRects.begin(); it != openRects.end(); ++it)
+				{
+					if (it->MinX == rect.MinX && it->MaxX == rect.MaxX)
+					{
+						rect.MinY = it->MinY;
+						openRects.erase(it);
+						break;
+					}
+				}
+			}
+			rects.insert(rects.end(), openRects.begin(), openRects.end());
+			openRects.swap(bandRects);
+		}
+		rects.insert(rects.end(), openRects.begin(), openRects.end());
+	}
+
+	SpriteMesh SpriteMesh::Generate(const std::vector<bool>& alphaMask, uint32_t maskWidth, const glm::uvec2& regionPosition, const glm::uvec2& regionSize)
+	{
+		SpriteMesh mesh;
+		if (alphaMask.empty() || regionSize.x == 0 || regionSize.y == 0)
+			return mesh;
+
+		// Coarser bands and merging of bigger gaps until the rect count fits
+		uint32_t bandHeight = glm::max(regionSize.y / 16, 4u);
+		uint32_t minGap = glm::max(regionSize.x / 16, 4u);
+		std::vector<SpriteMeshRect> rects;
+		for (;;)
+		{
+			BuildBandRects(alphaMask, maskWidth, regionPosition, regionSize, bandHeight, minGap, rects);
+			if (rects.size() <= MaxRects || bandHeight >= regionSize.y)
+				break;
+			bandHeight *= 2;
+			minGap *= 2;
+		}
+
+		if (rects.size() > MaxRects)
+			return mesh;
+
+		uint64_t coveredArea = 0;
+		for (const SpriteMeshRect& rect : rects)
+			coveredArea += (uint64_t)(rect.MaxX - rect.MinX) * (rect.MaxY - rect.MinY);
+
+		float coverage = (float)((double)coveredArea / ((double)regionSize.x * regionSize.y));
+		if (coverage > MaxCoverage)
+			return mesh;
+
+		glm::vec2 size = glm::vec2(regionSize);
+		mesh.Rects.clear();
+		mesh.Rects.reserve(rects.size());
+		for (const SpriteMeshRect& rect : rects)
+			mesh.Rects.push_back(glm::vec4(rect.MinX / size.x, rect.MinY / size.y, rect.MaxX / size.x, rect.MaxY / size.y));
+		mesh.Coverage = coverage;
+		return mesh;
+	}
+
+}
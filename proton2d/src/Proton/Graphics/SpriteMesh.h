@@ -0,0 +1,31 @@
+#pragma once
+#include "Proton/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	//
+	// Tight sprite mesh.
+	// A few rectangles covering all non transparent pixels of a texture region, drawn instead of
+	// the full quad so fully transparent areas don't cost fill rate (Quad2D discards them anyway).
+	// Rectangles are built from horizontal bands of the alpha mask, merged across bands with equal
+	// extents, so concave shapes (parallax layers, characters) are covered much tighter than by a convex hull.
+	//
+	struct SpriteMesh
+	{
+		static constexpr uint32_t MaxRects = 32;
+		static constexpr float MaxCoverage = 0.9f; // above this, the full quad is cheaper
+
+		// min xy, max xy in region normalized coordinates, (0, 0) bottom left, (1, 1) top right
+		std::vector<glm::vec4> Rects = { { 0.0f, 0.0f, 1.0f, 1.0f } };
+
+		// Fraction of the region area covered by rects
+		float Coverage = 1.0f;
+
+		// Generate mesh for a region of an alpha mask (true - pixel is not fully transparent),
+		// rows of the mask go from bottom to top like texture coordinates
+		static SpriteMesh Generate(const std::vector<bool>& alphaMask, uint32_t maskWidth, const glm::uvec2& regionPosition, const glm::uvec2& regionSize);
+	};
+
+}
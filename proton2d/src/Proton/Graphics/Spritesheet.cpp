@@ -12,11 +12,15 @@ namespace proton {
 
 		uint32_t x = 0, y = 0;
 		m_TextureCoords.resize(m_TileCount.x);
+		m_SpriteMeshes.resize(m_TileCount.x);
 		for (auto& column : m_TextureCoords)
 		{
 			column.resize(m_TileCount.y);
+			m_SpriteMeshes[x].resize(m_TileCount.y);
 			for (auto& tileTextureCoords : column)
 			{
+				m_SpriteMeshes[x][y] = texture->GetSpriteMesh(glm::uvec2(x, y) * m_TileSize, m_TileSize);
+
 				// Texture coords: [0.0 - 1.0] range
 				tileTextureCoords[0] = { x * m_TileScale.x, y * m_TileScale.y };
 				tileTextureCoords[1] = { (x + 1) * m_TileScale.x, y * m_TileScale.y };
@@ -34,4 +38,10 @@ namespace proton {
 		return m_TextureCoords[x % m_TileCount.x][y % m_TileCount.y];
 	}
 
+	const Shared<SpriteMesh>& Spritesheet::GetSpriteMesh(uint32_t x, uint32_t y) const
+	{
+		PT_CORE_ASSERT(x < m_TileCount.x && y < m_TileCount.y, "Tile position out of bounds!");
+		return m_SpriteMeshes[x % m_TileCount.x][y % m_TileCount.y];
+	}
+
 }
@@ -28,9 +28,11 @@ namespace proton {
 
 	private:
 		const TextureCoords& GetTextureCoords(uint32_t x, uint32_t y) const;
+		const Shared<SpriteMesh>& GetSpriteMesh(uint32_t x, uint32_t y) const;
 
 	private:
 		std::vector<std::vector<TextureCoords>> m_TextureCoords;
+		std::vector<std::vector<Shared<SpriteMesh>>> m_SpriteMeshes; // per tile
 		Shared<Texture> m_Texture;
 
 		glm::uvec2 m_SheetSize = { 0, 0 }; // pixels
@@ -1,5 +1,6 @@
 #include "ptpch.h"
 #include "Proton/Physics/PhysicsWorld.h"
+#include "Proton/Scene/TransformHierarchy.h"
 
 #include <box2d/b2_world.h>
 #include <box2d/b2_body.h>
@@ -43,7 +44,7 @@ namespace proton {
 		b2BodyDef bodyDef;
 		bodyDef.type = rb.Type;
 		bodyDef.position.Set(transform.WorldPosition.x, transform.WorldPosition.y);
-		bodyDef.angle = glm::radians(transform.Rotation);
+		bodyDef.angle = glm::radians(transform.WorldRotation);
 
 		b2Body* body = m_World->CreateBody(&bodyDef);
 		body->SetFixedRotation(rb.FixedRotation);
@@ -177,15 +178,21 @@ namespace proton {
 
 		// Update physics world
 		m_World->Step(ts, m_PhysicsVelocityIterations, m_PhysicsPositionIterations);
-		auto view = m_Scene->m_Registry.view<IDComponent, TransformComponent, RigidbodyComponent>();
-		for (auto entity : view)
+		auto group = m_Scene->m_Registry.group<RigidbodyComponent>(entt::get<TransformComponent>);
+		for (auto [entity, rb, transform] : group.each())
 		{
-			auto [id, transform] = view.get<IDComponent, TransformComponent>(entity);
-			b2Body* body = m_RuntimeBodies.at(id.ID);
-			// Retrive positions of entities
-			transform.WorldPosition.x = body->GetPosition().x;
-			transform.WorldPosition.y = body->GetPosition().y;
-			transform.Rotation = glm::degrees(body->GetAngle());
+			b2Body* body = rb.RuntimeBody;
+			PT_CORE_ASSERT(body, "Physics runtime body not found!");
+			// Retrive positions of entities, only moved bodies are propagated by the hierarchy
+			glm::vec2 position = { body->GetPosition().x, body->GetPosition().y };
+			float rotation = glm::degrees(body->GetAngle());
+			if (position == glm::vec2(transform.WorldPosition) && rotation == transform.WorldRotation)
+				continue;
+
+			transform.WorldPosition.x = position.x;
+			transform.WorldPosition.y = position.y;
+			transform.WorldRotation = rotation;
+			m_Scene->m_TransformHierarchy->MarkDirty(entity);
 		}
 	}
 
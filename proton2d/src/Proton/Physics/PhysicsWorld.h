@@ -58,6 +58,7 @@ namespace proton {
 		friend class Scene;
 		friend class SceneSerializer;
 		friend class Entity;
+		friend class PrefabManager;
 
 		friend class EditorLayer;
 		friend class ToolbarPanel;
@@ -26,13 +26,18 @@ namespace proton {
 		std::string Tag;
 	};
 
-	// Use Entity::SetWorldPosition to modify world position manually
+	// Use Entity::SetWorldPosition to modify world position manually,
+	// other direct writes have to be followed by Entity::MarkTransformDirty
 	struct TransformComponent
 	{
 		glm::vec3 WorldPosition { 0.0f, 0.0f, 0.0f };
 		glm::vec3 LocalPosition { 0.0f, 0.0f, 0.0f };
-		float Rotation { 0.0f };
+		float Rotation { 0.0f }; // degrees, relative to the parent
 		glm::vec2 Scale { 1.0f, 1.0f };
+
+		// Updated by the scene transform hierarchy (see TransformHierarchy)
+		float WorldRotation { 0.0f };
+		glm::mat4 WorldMatrix { 1.0f };
 	};
 
 	struct RelationshipComponent
@@ -72,6 +77,14 @@ namespace proton {
 		float Fade = 0.005f;
 	};
 
+	// 2D point light affecting Quad2D shading (requires scene lighting to be enabled)
+	struct PointLight2DComponent
+	{
+		glm::vec3 Color{ 1.0f, 1.0f, 1.0f };
+		float Intensity = 1.0f;
+		float Radius = 5.0f;
+	};
+
 	class EntityScript; // forward declaration
 
 	struct ScriptComponent
@@ -115,4 +128,10 @@ namespace proton {
 	{
 		SpriteAnimation SpriteAnimation;
 	};
+
+	// Root entity loaded from a streamed cell (see WorldStreamer), not serialized
+	struct StreamingCellComponent
+	{
+		glm::ivec2 Cell { 0, 0 };
+	};
 }
@@ -3,8 +3,12 @@
 #include "Proton/Scene/EntityComponent.h"
 #include "Proton/Scripting/EntityScript.h"
 #include "Proton/Physics/PhysicsWorld.h"
+#include "Proton/Scene/TransformHierarchy.h"
+#include "Proton/Scene/SpriteImpostorCache.h"
+#include "Proton/Scene/EntityCommandBuffer.h"
 
 #include <box2d/b2_body.h>
+#include <cstdlib>
 
 namespace proton 
 {
@@ -15,6 +19,7 @@ namespace proton
 
 	void Entity::RemoveScript(const std::string& scriptClassName)
 	{
+		m_Scene->CheckStructuralChange("RemoveScript");
 		auto& component = GetComponent<ScriptComponent>();
 		delete component.Scripts.at(scriptClassName);
 		component.Scripts.erase(scriptClassName);
@@ -49,9 +54,17 @@ namespace proton
 
 	void Entity::AddChildEntity(Entity child, bool refreshChildWorldPosition) const
 	{
+		if (m_Scene->m_ParallelScriptsUpdate)
+		{
+			m_Scene->m_CommandBuffer->SetParent(child, *this);
+			return;
+		}
+
 		auto& parentComponent = GetComponent<RelationshipComponent>();
 		auto& childComponent = child.GetComponent<RelationshipComponent>();
 
+		if (childComponent.Parent == entt::null)
+			m_Scene->UnlinkRootEntity(child.m_Handle);
 		childComponent.Parent = m_Handle;
 
 		if (parentComponent.ChildrenCount)
@@ -64,17 +77,25 @@ namespace proton
 		parentComponent.First = child.m_Handle;
 		parentComponent.ChildrenCount++;
 
-		std::vector<Entity>& sceneRoot = m_Scene->m_Root;
-		auto it = std::find(sceneRoot.begin(), sceneRoot.end(), child);
-		if (it != sceneRoot.end())
-			sceneRoot.erase(it);
-
 		if (refreshChildWorldPosition)
-			child.SetWorldPosition(child.GetTransform().WorldPosition);
+		{
+			// Keep the child where it is, in the space of its new parent
+			auto& transform = child.GetTransform();
+			child.SetWorldPosition(transform.WorldPosition);
+			transform.Rotation = transform.WorldRotation - GetTransform().WorldRotation;
+		}
+		m_Scene->m_TransformHierarchy->Invalidate();
+		m_Scene->m_SpriteImpostors->Invalidate();
 	}
 
 	void Entity::PopHierarchy() const
 	{
+		if (m_Scene->m_ParallelScriptsUpdate)
+		{
+			m_Scene->m_CommandBuffer->SetParent(*this, Entity());
+			return;
+		}
+
 		auto& rc = GetComponent<RelationshipComponent>();
 		if (rc.Parent != entt::null)
 		{
@@ -101,9 +122,12 @@ namespace proton
 			rc.Prev = entt::null;
 			rc.Parent = entt::null;
 
-			m_Scene->m_Root.push_back(*this);
+			m_Scene->LinkRootEntity(m_Handle);
 			auto& transform = GetTransform();
 			transform.LocalPosition = transform.WorldPosition;
+			transform.Rotation = transform.WorldRotation;
+			m_Scene->m_TransformHierarchy->Invalidate();
+			m_Scene->m_SpriteImpostors->Invalidate();
 		}
 	}
 
@@ -150,6 +174,12 @@ namespace proton
 		return GetComponent<TagComponent>().Tag;
 	}
 
+	void Entity::SetTag(const std::string& tag) const
+	{
+		// Patched through the registry to keep the scene tag index up to date
+		m_Scene->m_Registry.patch<TagComponent>(m_Handle, [&](TagComponent& component) { component.Tag = tag; });
+	}
+
 	TransformComponent& Entity::GetTransform() const
 	{
 		return GetComponent<TransformComponent>();
@@ -224,6 +254,7 @@ namespace proton
 			return;
 		}
 		GetTransform().Rotation = angle;
+		MarkTransformDirty();
 	}
 
 	void Entity::RotateCenter(float angle) const
@@ -235,6 +266,29 @@ namespace proton
 			return;
 		}
 		GetTransform().Rotation += angle;
+		MarkTransformDirty();
+	}
+
+	void Entity::SetScale(const glm::vec2& scale) const
+	{
+		GetTransform().Scale = scale;
+		MarkTransformDirty();
+	}
+
+	void EntityRange::OnInvalidAccess()
+	{
+		PT_CORE_CRITICAL("EntityRange used after the tag index changed, copy the entities with Scene::FindAllByTag(tag, outEntities)!");
+		std::abort();
+	}
+
+	void Entity::MarkTransformDirty() const
+	{
+		m_Scene->m_TransformHierarchy->MarkDirty(m_Handle);
+	}
+
+	void Entity::MarkSpriteDirty() const
+	{
+		m_Scene->m_Registry.patch<SpriteComponent>(m_Handle);
 	}
 
 	void Entity::DestroyAllScripts()
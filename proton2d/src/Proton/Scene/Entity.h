@@ -19,13 +19,19 @@ namespace proton {
 		TComponent& GetComponent() const
 		{
 			PT_CORE_ASSERT(HasComponent<TComponent>(), "Entity does not have component!");
-			return m_Scene->m_Registry.get<TComponent>(m_Handle);
+			TComponent& component = m_Scene->m_Registry.get<TComponent>(m_Handle);
+		#ifdef PROTON_DEBUG
+			if (m_Scene->m_ParallelScriptsUpdate && m_Handle != Scene::s_ParallelScriptEntity)
+				m_Scene->TrackParallelAccess(m_Handle, &component, sizeof(TComponent), typeid(TComponent).name());
+		#endif
+			return component;
 		}
 
 		template <typename TComponent, typename... TArgs>
 		TComponent& AddComponent(TArgs&& ...args) const
 		{
 			PT_CORE_ASSERT(!HasComponent<TComponent>(), "Entity already have component!");
+			m_Scene->CheckStructuralChange("AddComponent");
 			return m_Scene->m_Registry.emplace<TComponent>(m_Handle, std::forward<TArgs>(args)...);
 		}
 
@@ -64,6 +70,7 @@ namespace proton {
 		void RemoveComponent()
 		{
 			PT_CORE_ASSERT(HasComponent<TComponent>(), "Entity does not have a component!");
+			m_Scene->CheckStructuralChange("RemoveComponent");
 
 			if (std::is_base_of<ScriptComponent, TComponent>::value)
 				DestroyAllScripts();
@@ -82,6 +89,7 @@ namespace proton {
 		template <typename TScriptClass>
 		EntityScript* AddScript() const
 		{
+			m_Scene->CheckStructuralChange("AddScript");
 			if (!HasComponent<ScriptComponent>())
 				AddComponent<ScriptComponent>();
 
@@ -93,6 +101,7 @@ namespace proton {
 			scriptInstance = new TScriptClass();
 			scriptInstance->m_Handle = m_Handle;
 			scriptInstance->m_Scene = m_Scene;
+			scriptInstance->m_ThreadSafeUpdate = TScriptClass::__ThreadSafeUpdate;
 			scriptInstance->OnRegisterFields();
 			return scriptInstance;
 		}
@@ -114,6 +123,8 @@ namespace proton {
 		Scene* GetScene() const;
 		UUID GetUUID() const;
 		const std::string& GetTag() const;
+		void SetTag(const std::string& tag) const;
+		// Writes through the returned reference need MarkTransformDirty, prefer the transform modifiers below
 		TransformComponent& GetTransform() const;
 		Sprite& GetSprite() const;
 		SpriteAnimation& GetSpriteAnimation() const;
@@ -124,6 +135,11 @@ namespace proton {
 		void SetLocalPosition(const glm::vec3& position) const;
 		void SetRotationCenter(float angle) const;
 		void RotateCenter(float angle) const;
+		void SetScale(const glm::vec2& scale) const;
+		// Direct writes to the TransformComponent are propagated only after this call
+		void MarkTransformDirty() const;
+		// Direct writes to the SpriteComponent of a static sprite reach its chunk impostor only after this call
+		void MarkSpriteDirty() const;
 
 		// Box2D body related methods
 		glm::vec2 GetLinearVelocity() const;
@@ -157,4 +173,57 @@ namespace proton {
 		friend class SceneViewportPanel;
 	};
 
+	//
+	// Non-owning range of entities in the tag index of a scene.
+	// The range points into the live index: creating, destroying or retagging any tagged entity of the scene
+	// invalidates it, accessing an invalidated range aborts in every build configuration. To change entities
+	// while iterating, copy them first with the Scene::FindAllByTag overload filling a vector, or defer the
+	// changes through the command buffer.
+	//
+	class EntityRange
+	{
+	public:
+		class Iterator
+		{
+		public:
+			Iterator(const entt::entity* it, const EntityRange* range) : m_It(it), m_Range(range) {}
+
+			Entity operator*() const { m_Range->CheckVersion(); return Entity(*m_It, m_Range->m_Scene); }
+			Iterator& operator++() { ++m_It; return *this; }
+			bool operator==(const Iterator& other) const { return m_It == other.m_It; }
+			bool operator!=(const Iterator& other) const { return m_It != other.m_It; }
+
+		private:
+			const entt::entity* m_It;
+			const EntityRange* m_Range;
+		};
+
+		EntityRange() = default;
+		EntityRange(const std::vector<entt::entity>& entities, const TagIndex* index, Scene* scene)
+			: m_First(entities.data()), m_Count((uint32_t)entities.size()), m_Index(index), m_Version(index->GetVersion()), m_Scene(scene) {}
+
+		Iterator begin() const { return Iterator(m_First, this); }
+		Iterator end() const { return Iterator(m_First + m_Count, this); }
+		Entity operator[](uint32_t index) const { CheckVersion(); return Entity(m_First[index], m_Scene); }
+
+		uint32_t size() const { return m_Count; }
+		bool empty() const { return m_Count == 0; }
+
+	private:
+		void CheckVersion() const
+		{
+			// Entity lists may have been reallocated, the range would read freed memory
+			if (m_Index->GetVersion() != m_Version)
+				OnInvalidAccess();
+		}
+		[[noreturn]] static void OnInvalidAccess();
+
+	private:
+		const entt::entity* m_First = nullptr;
+		uint32_t m_Count = 0;
+		const TagIndex* m_Index = nullptr;
+		uint32_t m_Version = 0;
+		Scene* m_Scene = nullptr;
+	};
+
 }
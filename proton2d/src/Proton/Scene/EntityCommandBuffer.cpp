@@ -0,0 +1,183 @@
+#include "ptpch.h"
+#include "Proton/Scene/EntityCommandBuffer.h"
+#include "Proton/Core/Application.h"
+
+#include <cstdlib>
+
+namespace proton {
+
+	EntityCommandBuffer::EntityCommandBuffer(Scene* scene)
+		: m_Scene(scene)
+	{
+		m_Buffers.resize(GetThreadsCount());
+	}
+
+	uint32_t EntityCommandBuffer::GetThreadIndex()
+	{
+		// Other threads would share the buffer of the main thread
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		uint32_t index = jobSystem.GetQueueIndex();
+		if (index == 0 && !jobSystem.IsMainThread())
+		{
+			PT_CORE_CRITICAL("Entity commands recorded from a thread outside of the job system!");
+			std::abort();
+		}
+		return index;
+	}
+
+	uint32_t EntityCommandBuffer::GetThreadsCount()
+	{
+		return Application::Get().GetJobSystem().GetQueuesCount();
+	}
+
+	EntityCommandBuffer::ThreadBuffer& EntityCommandBuffer::GetThreadBuffer()
+	{
+		// Slots are only written by their own thread, no locking needed
+		Unique<ThreadBuffer>& buffer = m_Buffers[GetThreadIndex()];
+		if (!buffer)
+			buffer = MakeUnique<ThreadBuffer>();
+		return *buffer;
+	}
+
+	DeferredEntity EntityCommandBuffer::CreateEntity(const std::string& name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		buffer.CreatedNames.push_back(name);
+		return { GetThreadIndex(), (uint32_t)buffer.CreatedNames.size() - 1 };
+	}
+
+	void EntityCommandBuffer::DestroyEntity(Target entity)
+	{
+		GetThreadBuffer().Destroyed.push_back(entity);
+	}
+
+	void EntityCommandBuffer::SetParent(Target child, Target parent)
+	{
+		GetThreadBuffer().Reparented.emplace_back(child, parent);
+	}
+
+	entt::entity EntityCommandBuffer::Resolve(const Target& target) const
+	{
+		if (!target.m_IsDeferred)
+			return target.m_Handle;
+
+		const ThreadBuffer& buffer = *m_Buffers[target.m_Deferred.Buffer];
+		PT_CORE_ASSERT(target.m_Deferred.Index < buffer.CreatedHandles.size(), "Deferred entity used before it was created!");
+		return buffer.CreatedHandles[target.m_Deferred.Index];
+	}
+
+	bool EntityCommandBuffer::IsEmpty() const
+	{
+		for (const auto& buffer : m_Buffers)
+		{
+			if (!buffer)
+				continue;
+
+			if (buffer->CreatedNames.size() || buffer->Destroyed.size() || buffer->Reparented.size())
+				return false;
+
+			for (const auto& commands : buffer->Components)
+			{
+				if (!commands->IsEmpty())
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void EntityCommandBuffer::Apply()
+	{
+		PROFILE_FUNCTION();
+
+		if (IsEmpty())
+			return;
+
+		// Creations, handles are needed by all other commands
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer || buffer->CreatedNames.empty())
+				continue;
+
+			buffer->CreatedHandles.resize(buffer->CreatedNames.size());
+			m_Scene->CreateEntities((uint32_t)buffer->CreatedNames.size(), buffer->CreatedNames.data(), buffer->CreatedHandles.data());
+		}
+
+		// Component commands of all threads are merged per type, each pool is touched once
+		m_MergedComponents.clear();
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer)
+				continue;
+
+			for (auto& commands : buffer->Components)
+			{
+				if (commands->IsEmpty())
+					continue;
+
+				auto it = std::find_if(m_MergedComponents.begin(), m_MergedComponents.end(),
+					[&](ComponentCommands* merged) { return merged->Type == commands->Type; });
+				if (it == m_MergedComponents.end())
+					m_MergedComponents.push_back(commands.get());
+				else
+					(*it)->Append(*commands);
+			}
+		}
+
+		for (ComponentCommands* commands : m_MergedComponents)
+			commands->ApplyAdded(*this);
+		for (ComponentCommands* commands : m_MergedComponents)
+			commands->ApplyRemoved(*this);
+
+		// Reparenting
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer)
+				continue;
+
+			for (auto& [childTarget, parentTarget] : buffer->Reparented)
+			{
+				Entity child{ Resolve(childTarget), m_Scene };
+				Entity parent{ Resolve(parentTarget), m_Scene };
+				if (!child.IsValid())
+					continue;
+
+				child.PopHierarchy();
+				if (parent.IsValid() && parent != child && !child.IsParentOf(parent))
+					parent.AddChildEntity(child);
+			}
+		}
+
+		// Destruction
+		m_DestroyedEntities.clear();
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer)
+				continue;
+
+			for (const Target& target : buffer->Destroyed)
+				m_DestroyedEntities.emplace_back(Resolve(target), m_Scene);
+		}
+		if (m_DestroyedEntities.size())
+			m_Scene->DestroyEntities(m_DestroyedEntities);
+
+		Clear();
+	}
+
+	void EntityCommandBuffer::Clear()
+	{
+		// Storage of the buffers is kept for the next frame
+		for (auto& buffer : m_Buffers)
+		{
+			if (!buffer)
+				continue;
+
+			buffer->CreatedNames.clear();
+			buffer->CreatedHandles.clear();
+			buffer->Destroyed.clear();
+			buffer->Reparented.clear();
+			for (auto& commands : buffer->Components)
+				commands->Clear();
+		}
+	}
+
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "Proton/Scene/Entity.h"
+
+namespace proton {
+
+	// Entity created by a recorded command, it exists in the scene once the command buffer is applied
+	struct DeferredEntity
+	{
+		uint32_t Buffer = 0; // thread buffer which recorded the creation
+		uint32_t Index = 0;
+	};
+
+	//
+	// Deferred structural changes of a scene.
+	// Creating and destroying entities, adding and removing components and reparenting are recorded
+	// instead of being applied while the registry is iterated (script updates, parallel jobs). Every thread
+	// records into its own buffer, without locking. All commands are applied at once at a sync point
+	// (Scene::OnUpdate, after scripts), grouped by kind and component type so each pool is touched once:
+	// creations -> added components -> removed components -> reparenting -> destruction.
+	// Commands targeting entities destroyed before the sync point are skipped.
+	//
+	class EntityCommandBuffer
+	{
+	public:
+		// Existing scene entity or an entity created by this buffer
+		class Target
+		{
+		public:
+			Target(Entity entity) : m_Handle(entity) {}
+			Target(DeferredEntity entity) : m_Deferred(entity), m_IsDeferred(true) {}
+
+		private:
+			entt::entity m_Handle = entt::null;
+			DeferredEntity m_Deferred;
+			bool m_IsDeferred = false;
+
+			friend class EntityCommandBuffer;
+		};
+
+		EntityCommandBuffer(Scene* scene);
+		virtual ~EntityCommandBuffer() = default;
+
+		DeferredEntity CreateEntity(const std::string& name = "Entity");
+		void DestroyEntity(Target entity);
+
+		// Parent of an invalid entity (Entity()) moves the child to the scene root
+		void SetParent(Target child, Target parent);
+
+		template<typename TComponent>
+		void AddComponent(Target entity, TComponent component = TComponent())
+		{
+			static_assert(!std::is_same<TComponent, ScriptComponent>::value, "Scripts have to be added with Entity::AddScript!");
+			static_assert(!std::is_same<TComponent, SpriteAnimationComponent>::value, "SpriteAnimationComponent cannot be deferred!");
+
+			auto& commands = GetComponentCommands<TComponent>(GetThreadBuffer());
+			commands.Added.push_back(entity);
+			commands.Components.push_back(std::move(component));
+		}
+
+		template<typename TComponent>
+		void RemoveComponent(Target entity)
+		{
+			GetComponentCommands<TComponent>(GetThreadBuffer()).Removed.push_back(entity);
+		}
+
+		// Sync point, main thread only. No thread may record commands while they are applied.
+		void Apply();
+		// Discard all recorded commands
+		void Clear();
+
+		bool IsEmpty() const;
+
+		// Job system queue of the calling thread (see JobSystem::GetQueueIndex), commands can only be
+		// recorded from the main thread and job system workers
+		static uint32_t GetThreadIndex();
+		static uint32_t GetThreadsCount();
+
+	private:
+		struct ComponentCommands
+		{
+			virtual ~ComponentCommands() = default;
+			virtual void Append(ComponentCommands& other) = 0;
+			virtual void ApplyAdded(EntityCommandBuffer& buffer) = 0;
+			virtual void ApplyRemoved(EntityCommandBuffer& buffer) = 0;
+			virtual void Clear() = 0;
+			virtual bool IsEmpty() const = 0;
+
+			entt::id_type Type = 0;
+		};
+
+		// Entity overrides of AddComponent / RemoveComponent with side effects, these are not applied in bulk
+		template<typename TComponent>
+		static constexpr bool HasAddOverride = std::is_same<TComponent, RigidbodyComponent>::value
+			|| std::is_same<TComponent, BoxColliderComponent>::value
+			|| std::is_same<TComponent, ResizableSpriteComponent>::value;
+
+		template<typename TComponent>
+		static constexpr bool HasRemoveOverride = std::is_same<TComponent, CameraComponent>::value;
+
+		template<typename TComponent>
+		struct TypedComponentCommands : public ComponentCommands
+		{
+			std::vector<Target> Added;
+			std::vector<TComponent> Components;
+			std::vector<Target> Removed;
+
+			virtual void Append(ComponentCommands& other) override
+			{
+				auto& typed = static_cast<TypedComponentCommands<TComponent>&>(other);
+				Added.insert(Added.end(), typed.Added.begin(), typed.Added.end());
+				Components.insert(Components.end(), std::make_move_iterator(typed.Components.begin()), std::make_move_iterator(typed.Components.end()));
+				Removed.insert(Removed.end(), typed.Removed.begin(), typed.Removed.end());
+				typed.Clear();
+			}
+
+			virtual void ApplyAdded(EntityCommandBuffer& buffer) override
+			{
+				// Resolve targets and drop the ones destroyed in the meantime, components are kept aligned.
+				// An entity added more than once keeps the last recorded component.
+				entt::registry& registry = buffer.m_Scene->m_Registry;
+				auto& handles = buffer.m_ResolvedHandles;
+				auto& indices = buffer.m_AddedIndices;
+				handles.clear();
+				indices.clear();
+				uint32_t count = 0;
+				for (uint32_t i = 0; i < (uint32_t)Added.size(); i++)
+				{
+					entt::entity handle = buffer.Resolve(Added[i]);
+					if (!registry.valid(handle))
+						continue;
+
+					auto [it, inserted] = indices.try_emplace(handle, count);
+					if (!inserted)
+					{
+						Components[it->second] = std::move(Components[i]);
+						continue;
+					}
+
+					handles.push_back(handle);
+					if (count != i)
+						Components[count] = std::move(Components[i]);
+					count++;
+				}
+
+				if constexpr (HasAddOverride<TComponent>)
+				{
+					for (uint32_t i = 0; i < count; i++)
+					{
+						Entity entity(handles[i], buffer.m_Scene);
+						if (entity.HasComponent<TComponent>())
+							entity.GetComponent<TComponent>() = std::move(Components[i]);
+						else
+							entity.AddComponent<TComponent>() = std::move(Components[i]);
+					}
+				}
+				else
+				{
+					// Entities already owning the component are replaced, insert is only valid for the others
+					uint32_t insertCount = 0;
+					for (uint32_t i = 0; i < count; i++)
+					{
+						if (registry.all_of<TComponent>(handles[i]))
+						{
+							registry.emplace_or_replace<TComponent>(handles[i], std::move(Components[i]));
+							continue;
+						}
+
+						if (insertCount != i)
+						{
+							handles[insertCount] = handles[i];
+							Components[insertCount] = std::move(Components[i]);
+						}
+						insertCount++;
+					}
+					registry.insert<TComponent>(handles.begin(), handles.begin() + insertCount, std::make_move_iterator(Components.begin()));
+				}
+			}
+
+			virtual void ApplyRemoved(EntityCommandBuffer& buffer) override
+			{
+				auto& handles = buffer.m_ResolvedHandles;
+				handles.clear();
+				for (const Target& target : Removed)
+				{
+					entt::entity handle = buffer.Resolve(target);
+					if (buffer.m_Scene->m_Registry.valid(handle))
+						handles.push_back(handle);
+				}
+
+				if constexpr (HasRemoveOverride<TComponent>)
+				{
+					for (entt::entity handle : handles)
+					{
+						Entity entity(handle, buffer.m_Scene);
+						if (entity.HasComponent<TComponent>())
+							entity.RemoveComponent<TComponent>();
+					}
+				}
+				else
+				{
+					buffer.m_Scene->m_Registry.remove<TComponent>(handles.begin(), handles.end());
+				}
+			}
+
+			virtual void Clear() override
+			{
+				Added.clear();
+				Components.clear();
+				Removed.clear();
+			}
+
+			virtual bool IsEmpty() const override { return Added.empty() && Removed.empty(); }
+		};
+
+		struct ThreadBuffer
+		{
+			std::vector<std::string> CreatedNames;
+			std::vector<entt::entity> CreatedHandles; // resolved when applied
+			std::vector<Target> Destroyed;
+			std::vector<std::pair<Target, Target>> Reparented;
+			std::vector<Unique<ComponentCommands>> Components; // in order of first use
+		};
+
+		ThreadBuffer& GetThreadBuffer();
+		entt::entity Resolve(const Target& target) const;
+
+		template<typename TComponent>
+		TypedComponentCommands<TComponent>& GetComponentCommands(ThreadBuffer& buffer)
+		{
+			entt::id_type type = entt::type_hash<TComponent>::value();
+			for (auto& commands : buffer.Components)
+			{
+				if (commands->Type == type)
+					return static_cast<TypedComponentCommands<TComponent>&>(*commands);
+			}
+
+			auto commands = MakeUnique<TypedComponentCommands<TComponent>>();
+			commands->Type = type;
+			auto& result = *commands;
+			buffer.Components.push_back(std::move(commands));
+			return result;
+		}
+
+	private:
+		Scene* m_Scene = nullptr;
+		std::vector<Unique<ThreadBuffer>> m_Buffers; // by thread index
+
+		// Scratch storage of Apply
+		std::vector<ComponentCommands*> m_MergedComponents;
+		std::vector<entt::entity> m_ResolvedHandles;
+		std::unordered_map<entt::entity, uint32_t> m_AddedIndices; // resolved handle -> index of its component
+		std::vector<Entity> m_DestroyedEntities;
+	};
+
+}
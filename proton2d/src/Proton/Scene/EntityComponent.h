@@ -11,6 +11,7 @@ namespace proton {
 	RigidbodyComponent& Entity::AddComponent() const
 	{
 		PT_CORE_ASSERT(!HasComponent<RigidbodyComponent>(), "Entity already has component!");
+		m_Scene->CheckStructuralChange("AddComponent");
 		auto& rb = m_Scene->m_Registry.emplace<RigidbodyComponent>(m_Handle);
 		if (m_Scene->m_SceneState == SceneState::Play && m_Scene->m_PhysicsWorld->IsInitialized())
 			m_Scene->m_PhysicsWorld->m_EntitiesToInitialize.push_back(*this);
@@ -22,6 +23,7 @@ namespace proton {
 	BoxColliderComponent& Entity::AddComponent() const
 	{
 		PT_CORE_ASSERT(!HasComponent<BoxColliderComponent>(), "Entity already has component!");
+		m_Scene->CheckStructuralChange("AddComponent");
 		auto& bc = m_Scene->m_Registry.emplace<BoxColliderComponent>(m_Handle);
 		if (m_Scene->m_SceneState == SceneState::Play && m_Scene->m_PhysicsWorld->IsInitialized())
 			m_Scene->m_PhysicsWorld->m_EntitiesToInitialize.push_back(*this);
@@ -33,6 +35,7 @@ namespace proton {
 	ResizableSpriteComponent& Entity::AddComponent() const
 	{
 		PT_CORE_ASSERT(!HasComponent<ResizableSpriteComponent>(), "Entity already has component!");
+		m_Scene->CheckStructuralChange("AddComponent");
 		PT_CORE_ASSERT(HasComponent<TransformComponent>(), "Entity does not have TransformComponent!");
 		auto& component = m_Scene->m_Registry.emplace<ResizableSpriteComponent>(m_Handle);
 		return component;
@@ -43,6 +46,7 @@ namespace proton {
 	SpriteAnimationComponent& Entity::AddComponent() const
 	{
 		PT_CORE_ASSERT(!HasComponent<SpriteAnimationComponent>(), "Entity already has component!");
+		m_Scene->CheckStructuralChange("AddComponent");
 		PT_CORE_ASSERT(HasComponent<SpriteComponent>(), "Entity must have SpriteComponent!");
 		PT_CORE_ASSERT(GetSprite().m_Spritesheet, "Entity must have Spritesheet Texture!");
 		auto& component = m_Scene->m_Registry.emplace<SpriteAnimationComponent>(m_Handle);
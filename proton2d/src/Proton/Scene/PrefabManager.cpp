@@ -1,6 +1,9 @@
 #include "ptpch.h"
 #include "Proton/Scene/PrefabManager.h"
 #include "Proton/Assets/SceneSerializer.h"
+#include "Proton/Scripting/EntityScript.h"
+#include "Proton/Scripting/ScriptFactory.h"
+#include "Proton/Physics/PhysicsWorld.h"
 #include "Proton/Utils/Utils.h"
 
 #include <fstream>
@@ -10,6 +13,24 @@
 
 namespace proton {
 
+	template<typename TComponent>
+	struct Prefab::TypedComponentValues : public Prefab::ComponentValues
+	{
+		std::vector<uint32_t> Nodes;
+		std::vector<TComponent> Values;
+
+		virtual void Insert(entt::registry& registry, const entt::entity* handles, uint32_t instancesCount, uint32_t nodesCount, std::vector<entt::entity>& scratch) const override
+		{
+			for (uint32_t i = 0; i < (uint32_t)Nodes.size(); i++)
+			{
+				scratch.clear();
+				for (uint32_t instance = 0; instance < instancesCount; instance++)
+					scratch.push_back(handles[instance * nodesCount + Nodes[i]]);
+				registry.insert<TComponent>(scratch.begin(), scratch.end(), Values[i]);
+			}
+		}
+	};
+
 	PrefabManager* PrefabManager::s_Instance = nullptr;
 
 	void PrefabManager::Init()
@@ -17,12 +38,15 @@ namespace proton {
 		if (!s_Instance)
 		{
 			s_Instance = new PrefabManager();
+			s_Instance->m_TemplateScene = MakeUnique<Scene>("Prefab templates");
 			s_Instance->ReloadAllPrefabs();
 		}
 	}
 
 	void PrefabManager::ReloadAllPrefabs()
 	{
+		s_Instance->m_CompiledPrefabs.clear();
+		s_Instance->m_TemplateScene->Clear();
 		s_Instance->m_PrefabsJsonData.clear();
 		for (const auto& prefabFile : Utils::ScanDirectoryRecursive("content/prefabs", { ".prefab.json" }))
 			LoadPrefab(prefabFile);
@@ -34,6 +58,7 @@ namespace proton {
 		json jsonData = serializer.SerializeEntity(entity);
 		std::string tag = jsonData["Tag"];
 		s_Instance->m_PrefabsJsonData[tag] = jsonData;
+		DropCompiledPrefab(tag);
 		std::ofstream file("content/prefabs/" + tag + ".prefab.json");
 		file << jsonData.dump(4);
 		file.close();
@@ -46,6 +71,7 @@ namespace proton {
 		{
 			json jsonData = json::parse(rawData);
 			s_Instance->m_PrefabsJsonData[prefabPath] = jsonData;
+			DropCompiledPrefab(prefabPath);
 			return true;
 		}
 		return false;
@@ -58,6 +84,7 @@ namespace proton {
 			if (remove(("content/prefabs/" + prefabPath).c_str()) == 0)
 			{
 				s_Instance->m_PrefabsJsonData.erase(prefabPath);
+				DropCompiledPrefab(prefabPath);
 				return true;
 			}
 		}
@@ -69,27 +96,188 @@ namespace proton {
 		return s_Instance->m_PrefabsJsonData.find(prefabPath) != s_Instance->m_PrefabsJsonData.end();
 	}
 
-	Entity PrefabManager::SpawnPrefab(Scene* scene, const std::string& prefabPath)
+	const Prefab* PrefabManager::GetPrefab(const std::string& prefabPath)
 	{
 		if (!Exists(prefabPath))
 		{
 			if (!LoadPrefab(prefabPath))
 			{
 				PT_CORE_ERROR("Prefab '{}' not found", prefabPath);
-				return Entity();
+				return nullptr;
+			}
+		}
+
+		auto& prefab = s_Instance->m_CompiledPrefabs[prefabPath];
+		if (!prefab)
+			prefab = CompilePrefab(s_Instance->m_PrefabsJsonData.at(prefabPath));
+		return prefab.get();
+	}
+
+	template<typename... TComponents>
+	void PrefabManager::CompileComponents(Prefab& prefab, entt::registry& registry, const std::vector<entt::entity>& entities)
+	{
+		([&]()
+		{
+			auto values = MakeUnique<Prefab::TypedComponentValues<TComponents>>();
+			for (uint32_t node = 0; node < (uint32_t)entities.size(); node++)
+			{
+				if (auto* component = registry.try_get<TComponents>(entities[node]))
+				{
+					values->Nodes.push_back(node);
+					values->Values.push_back(*component);
+				}
+			}
+			if (values->Nodes.size())
+				prefab.m_Components.push_back(std::move(values));
+		}(), ...);
+	}
+
+	Unique<Prefab> PrefabManager::CompilePrefab(const json& prefabData)
+	{
+		PROFILE_FUNCTION();
+
+		// Deserialized once, assets are resolved and resizable sprites generated here
+		Scene* templateScene = s_Instance->m_TemplateScene.get();
+		SceneSerializer serializer(templateScene);
+		Entity root = serializer.DeserializeEntity(prefabData, false);
+
+		auto prefab = MakeUnique<Prefab>();
+		prefab->m_TemplateEntity = (entt::entity)root;
+
+		// Depth first, children are pushed in reverse so siblings keep their order
+		std::vector<entt::entity> entities;
+		std::vector<std::pair<entt::entity, uint32_t>> stack = { { (entt::entity)root, Prefab::NoParent } };
+		std::vector<entt::entity> children;
+		while (stack.size())
+		{
+			auto [handle, parent] = stack.back();
+			stack.pop_back();
+
+			Entity entity{ handle, templateScene };
+			uint32_t index = (uint32_t)prefab->m_Nodes.size();
+			Prefab::Node& node = prefab->m_Nodes.emplace_back();
+			node.Tag = entity.GetComponent<TagComponent>().Tag;
+			node.Parent = parent;
+			node.Transform = entity.GetTransform();
+			entities.push_back(handle);
+
+			if (entity.HasComponent<ScriptComponent>())
+			{
+				for (auto& [className, script] : entity.GetComponent<ScriptComponent>().Scripts)
+					prefab->m_Scripts.push_back({ index, className, script });
+			}
+
+			if (entity.HasComponent<RigidbodyComponent>() || entity.HasComponent<BoxColliderComponent>() || entity.HasComponent<CircleColliderComponent>())
+				prefab->m_PhysicsNodes.push_back(index);
+
+			children.clear();
+			for (entt::entity child = entity.GetComponent<RelationshipComponent>().First; child != entt::null;
+				child = Entity(child, templateScene).GetComponent<RelationshipComponent>().Next)
+				children.push_back(child);
+			for (auto it = children.rbegin(); it != children.rend(); it++)
+				stack.emplace_back(*it, index);
+		}
+
+		CompileComponents<SpriteComponent, ResizableSpriteComponent, CircleRendererComponent, PointLight2DComponent,
+			CameraComponent, RigidbodyComponent, BoxColliderComponent, CircleColliderComponent>(*prefab, templateScene->m_Registry, entities);
+
+		return prefab;
+	}
+
+	void PrefabManager::DropCompiledPrefab(const std::string& prefabPath)
+	{
+		auto it = s_Instance->m_CompiledPrefabs.find(prefabPath);
+		if (it == s_Instance->m_CompiledPrefabs.end())
+			return;
+
+		if (it->second)
+			s_Instance->m_TemplateScene->DestroyEntity(Entity(it->second->m_TemplateEntity, s_Instance->m_TemplateScene.get()));
+		s_Instance->m_CompiledPrefabs.erase(it);
+	}
+
+	Entity PrefabManager::SpawnPrefab(Scene* scene, const std::string& prefabPath)
+	{
+		const glm::vec3& camera = scene->GetPrimaryCameraPosition();
+		glm::vec2 position = { camera.x, camera.y };
+
+		std::vector<Entity> roots;
+		if (!SpawnPrefab(scene, prefabPath, 1, &position, &roots))
+			return Entity();
+		return roots.front();
+	}
+
+	uint32_t PrefabManager::SpawnPrefab(Scene* scene, const std::string& prefabPath, uint32_t count, const glm::vec2* positions, std::vector<Entity>* outRoots)
+	{
+		PROFILE_FUNCTION();
+
+		const Prefab* prefab = GetPrefab(prefabPath);
+		if (!prefab || !count)
+			return 0;
+
+		// Entities of instance i are handles[i * nodesCount + node]
+		uint32_t nodesCount = prefab->GetNodesCount();
+		uint32_t entitiesCount = count * nodesCount;
+		auto& names = s_Instance->m_SpawnNames;
+		auto& handles = s_Instance->m_SpawnHandles;
+		names.resize(entitiesCount);
+		handles.resize(entitiesCount);
+		for (uint32_t i = 0; i < entitiesCount; i++)
+			names[i] = prefab->m_Nodes[i % nodesCount].Tag;
+		scene->CreateEntities(entitiesCount, names.data(), handles.data());
+
+		entt::registry& registry = scene->m_Registry;
+		for (uint32_t instance = 0; instance < count; instance++)
+		{
+			const entt::entity* instanceHandles = &handles[instance * nodesCount];
+			for (uint32_t node = 0; node < nodesCount; node++)
+				registry.get<TransformComponent>(instanceHandles[node]) = prefab->m_Nodes[node].Transform;
+
+			auto& rootTransform = registry.get<TransformComponent>(instanceHandles[0]);
+			rootTransform.LocalPosition.x = rootTransform.WorldPosition.x = positions[instance].x;
+			rootTransform.LocalPosition.y = rootTransform.WorldPosition.y = positions[instance].y;
+
+			// Children are prepended to their parent, linking them in reverse keeps the sibling order
+			for (uint32_t node = nodesCount - 1; node > 0; node--)
+			{
+				Entity parent{ instanceHandles[prefab->m_Nodes[node].Parent], scene };
+				parent.AddChildEntity(Entity(instanceHandles[node], scene), false);
+			}
+		}
+
+		for (const auto& components : prefab->m_Components)
+			components->Insert(registry, handles.data(), count, nodesCount, s_Instance->m_SpawnScratch);
+
+		// Scripts are instantiated one by one, field values are copied from the template instances
+		for (uint32_t instance = 0; instance < count; instance++)
+		{
+			for (const Prefab::ScriptTemplate& scriptTemplate : prefab->m_Scripts)
+			{
+				Entity entity{ handles[instance * nodesCount + scriptTemplate.Node], scene };
+				EntityScript* script = ScriptFactory::Get().AddScriptToEntity(entity, scriptTemplate.ClassName);
+				if (!script)
+					continue;
+
+				for (auto& [fieldName, fieldData] : scriptTemplate.Instance->m_ScriptFields)
+					script->SetFieldValueData(fieldName, fieldData.InstanceFieldValue);
+			}
+		}
+
+		// Bodies of instances spawned during play are created by the next physics update, parents first
+		if (scene->m_SceneState == SceneState::Play && scene->m_PhysicsWorld->IsInitialized())
+		{
+			for (uint32_t instance = 0; instance < count; instance++)
+			{
+				for (uint32_t node : prefab->m_PhysicsNodes)
+					scene->m_PhysicsWorld->m_EntitiesToInitialize.emplace_back(handles[instance * nodesCount + node], scene);
 			}
 		}
 
-		SceneSerializer serializer(scene);
-		const json& prefabData = s_Instance->m_PrefabsJsonData.at(prefabPath);
-		Entity entity = serializer.DeserializeEntity(prefabData, false);
-		
-		auto camera = scene->GetPrimaryCameraPosition();
-		auto& transform = entity.GetComponent<TransformComponent>();
-		transform.WorldPosition.x = camera.x;
-		transform.WorldPosition.y = camera.y;
-		
-		return entity;
+		if (outRoots)
+		{
+			for (uint32_t instance = 0; instance < count; instance++)
+				outRoots->emplace_back(handles[instance * nodesCount], scene);
+		}
+		return count;
 	}
 
 }
@@ -7,13 +7,60 @@ namespace proton {
 
 	using json = nlohmann::ordered_json;
 	class Scene;
+	class EntityScript;
+
+	//
+	// Prefab compiled from its JSON data: component values with resolved assets and the hierarchy layout.
+	// Nodes are stored depth first (parents before their children), the root is the first node.
+	//
+	class Prefab
+	{
+	public:
+		uint32_t GetNodesCount() const { return (uint32_t)m_Nodes.size(); }
+
+	private:
+		static constexpr uint32_t NoParent = (uint32_t)-1;
+
+		struct Node
+		{
+			std::string Tag;
+			uint32_t Parent = NoParent;
+			TransformComponent Transform;
+		};
+
+		// Values of one component type, inserted for all instances of a node at once
+		struct ComponentValues
+		{
+			virtual ~ComponentValues() = default;
+			virtual void Insert(entt::registry& registry, const entt::entity* handles, uint32_t instancesCount, uint32_t nodesCount, std::vector<entt::entity>& scratch) const = 0;
+		};
+
+		template<typename TComponent>
+		struct TypedComponentValues;
+
+		struct ScriptTemplate
+		{
+			uint32_t Node = 0;
+			std::string ClassName;
+			EntityScript* Instance = nullptr; // in the template scene, fields are copied from it
+		};
+
+		std::vector<Node> m_Nodes;
+		std::vector<Unique<ComponentValues>> m_Components;
+		std::vector<ScriptTemplate> m_Scripts;
+		std::vector<uint32_t> m_PhysicsNodes; // nodes with a rigidbody or collider, in hierarchy order
+		entt::entity m_TemplateEntity = entt::null;
+
+		friend class PrefabManager;
+	};
 
 	// TODO: Entire rework
 	// 
 	// Class PrefabManager is used to create, load and spawn prefabs.
 	// PrefabManager class methods use prefab filepaths - "prefabPath"
 	// (realative to "prefabs" directory) without ".prefab.json" extension as prefab identifiers (keys in map storage).
-	// Prefabs are stored as JSON object data, which is used for deserialization in SpawnPrefab method.
+	// Prefabs are stored as JSON object data. On first spawn the data is deserialized once into a template
+	// scene and compiled into a Prefab, instances are then created in bulk from the compiled values.
 	// 
 	class PrefabManager
 	{
@@ -26,14 +73,34 @@ namespace proton {
 		static bool LoadPrefab(const std::string& prefabPath);
 		static bool DeletePrefab(const std::string& prefabPath);
 
+		// Spawned at the primary camera position
 		static Entity SpawnPrefab(Scene* scene, const std::string& prefabPath);
+		// Spawns count instances with their root at positions[i] (x, y), roots are appended to outRoots
+		static uint32_t SpawnPrefab(Scene* scene, const std::string& prefabPath, uint32_t count, const glm::vec2* positions, std::vector<Entity>* outRoots = nullptr);
+
+		// Compiled prefab, loaded and compiled if needed
+		static const Prefab* GetPrefab(const std::string& prefabPath);
 
 		static bool Exists(const std::string& prefabPath);
 		
+	private:
+		static Unique<Prefab> CompilePrefab(const json& prefabData);
+		static void DropCompiledPrefab(const std::string& prefabPath);
+
+		template<typename... TComponents>
+		static void CompileComponents(Prefab& prefab, entt::registry& registry, const std::vector<entt::entity>& entities);
+
 	private:
 		static PrefabManager* s_Instance;
 
 		std::map<std::string, json> m_PrefabsJsonData;
+		std::unordered_map<std::string, Unique<Prefab>> m_CompiledPrefabs;
+		Unique<Scene> m_TemplateScene; // holds deserialized prefabs, never updated
+
+		// Scratch storage of SpawnPrefab
+		std::vector<std::string> m_SpawnNames;
+		std::vector<entt::entity> m_SpawnHandles;
+		std::vector<entt::entity> m_SpawnScratch;
 		
 		friend class Application;
 		friend class PrefabPanel;
@@ -8,6 +8,13 @@
 #include "Proton/Assets/SceneSerializer.h"
 #include "Proton/Utils/Utils.h"
 #include "Proton/Physics/PhysicsWorld.h"
+#include "Proton/Scene/SpriteImpostorCache.h"
+#include "Proton/Scene/TransformHierarchy.h"
+#include "Proton/Scene/SpatialIndex.h"
+#include "Proton/Scene/EntityCommandBuffer.h"
+#include "Proton/Scene/SystemScheduler.h"
+#include "Proton/Scene/WorldStreamer.h"
+#include "Proton/UI/UICanvas.h"
 
 #ifdef PT_EDITOR
 #include "Proton/Editor/EditorLayer.h"
@@ -15,12 +22,23 @@
 #include <imgui.h>
 #endif
 
+#include <cstdlib>
+
 namespace proton {
 
 	Scene::Scene(const std::string& name, const std::string& filepath)
 		: m_SceneName(name), m_SceneFilepath(filepath),
-		m_PhysicsWorld(MakeUnique<PhysicsWorld>(this))
+		m_PhysicsWorld(MakeUnique<PhysicsWorld>(this)),
+		m_SpriteImpostors(MakeUnique<SpriteImpostorCache>(this)),
+		m_Canvas(MakeUnique<UICanvas>()),
+		m_TransformHierarchy(MakeUnique<TransformHierarchy>(m_Registry)),
+		m_TagIndex(MakeUnique<TagIndex>(m_Registry)),
+		m_SpatialIndex(MakeUnique<SpatialIndex>(this)),
+		m_CommandBuffer(MakeUnique<EntityCommandBuffer>(this)),
+		m_Systems(MakeUnique<SystemScheduler>(m_Registry))
 	{
+		RegisterGroups();
+		RegisterSystems();
 	}
 
 	Scene::~Scene()
@@ -47,7 +65,7 @@ namespace proton {
 	using ComponentsToCopy =
 		ComponentGroup<TransformComponent, CameraComponent,
 		SpriteComponent, CircleRendererComponent, ResizableSpriteComponent,
-		RigidbodyComponent, BoxColliderComponent, CircleColliderComponent>;
+		RigidbodyComponent, BoxColliderComponent, CircleColliderComponent, PointLight2DComponent>;
 
 	template<typename... TComponent>
 	static void CopyComponent(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap)
@@ -94,6 +112,11 @@ namespace proton {
 		newScene->m_SceneFilepath = m_SceneFilepath;
 		newScene->m_ClearColor = m_ClearColor;
 		newScene->m_EnablePhysics = m_EnablePhysics;
+		newScene->m_EnableLighting = m_EnableLighting;
+		newScene->m_AmbientLightColor = m_AmbientLightColor;
+		newScene->m_EnableSpriteLOD = m_EnableSpriteLOD;
+		newScene->m_MinSpritePixelSize = m_MinSpritePixelSize;
+		newScene->m_EnableSpriteMeshes = m_EnableSpriteMeshes;
 
 		auto& dstSceneRegistry = newScene->m_Registry;
 		std::unordered_map<UUID, entt::entity> enttMap;
@@ -129,10 +152,12 @@ namespace proton {
 				dstComponent.Parent = enttMap.at(m_Registry.get<IDComponent>(srcComponent.Parent).ID);
 		}
 
-		// Update new scene root
-		for (Entity entity : m_Root)
+		// Update new scene root, roots are linked by the Prev/Next handles copied above
+		if (m_RootFirst != entt::null)
 		{
-			newScene->m_Root.push_back(Entity(enttMap.at(entity.GetUUID()), newScene.get()));
+			newScene->m_RootFirst = enttMap.at(m_Registry.get<IDComponent>(m_RootFirst).ID);
+			newScene->m_RootLast = enttMap.at(m_Registry.get<IDComponent>(m_RootLast).ID);
+			newScene->m_RootCount = m_RootCount;
 		}
 
 		// Copy all components except:
@@ -212,30 +237,110 @@ namespace proton {
 
 	Entity Scene::CreateEntityWithUUID(UUID id, const std::string& name, bool addToSceneRoot)
 	{
+		CheckStructuralChange("CreateEntity");
 		Entity entity = Entity{ m_Registry.create(), this };
 		entity.AddComponent<IDComponent>().ID = id;
-		entity.AddComponent<TagComponent>().Tag = name;
+		entity.AddComponent<TagComponent>(name);
 		entity.AddComponent<TransformComponent>();
 		entity.AddComponent<RelationshipComponent>();
 		m_EntityMap[id] = entity;
+		m_TransformHierarchy->AddRoot(entity);
 		if (addToSceneRoot)
 		{
-			m_Root.push_back(entity);
+			LinkRootEntity(entity);
 		}
 		return entity;
 	}
 
+	void Scene::CreateEntities(uint32_t count, Entity* outEntities, const std::string& name)
+	{
+		std::vector<std::string> names(count, name);
+		std::vector<entt::entity> handles(count);
+		CreateEntities(count, names.data(), handles.data());
+		for (uint32_t i = 0; i < count; i++)
+			outEntities[i] = Entity{ handles[i], this };
+	}
+
+	void Scene::CreateEntities(uint32_t count, const std::string* names, entt::entity* outHandles, const UUID* ids)
+	{
+		PROFILE_FUNCTION();
+		CheckStructuralChange("CreateEntities");
+
+		m_Registry.create(outHandles, outHandles + count);
+
+		std::vector<IDComponent> idComponents(count);
+		std::vector<TagComponent> tags(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			idComponents[i].ID = ids ? ids[i] : UUID();
+			tags[i].Tag = names[i];
+		}
+		m_Registry.insert<IDComponent>(outHandles, outHandles + count, idComponents.begin());
+		m_Registry.insert<TagComponent>(outHandles, outHandles + count, std::make_move_iterator(tags.begin()));
+		m_Registry.insert<TransformComponent>(outHandles, outHandles + count);
+		m_Registry.insert<RelationshipComponent>(outHandles, outHandles + count);
+
+		m_EntityMap.reserve(m_EntityMap.size() + count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			m_EntityMap[idComponents[i].ID] = Entity{ outHandles[i], this };
+			LinkRootEntity(outHandles[i]);
+			m_TransformHierarchy->AddRoot(outHandles[i]);
+		}
+	}
+
 	void Scene::DestroyEntity(Entity entity, bool popHierarchy)
 	{
 		if (!entity.IsValid()) return;
 
+		if (m_ParallelScriptsUpdate)
+		{
+			m_CommandBuffer->DestroyEntity(entity);
+			return;
+		}
+
+		m_DestroyDepth++;
+		ReleaseEntity(entity, popHierarchy);
+		FlushReleasedEntities();
+	}
+
+	void Scene::DestroyChildEntities(Entity entity)
+	{
+		m_DestroyDepth++;
+		ReleaseChildEntities(entity);
+		FlushReleasedEntities();
+	}
+
+	void Scene::DestroyEntities(const std::vector<Entity>& entities)
+	{
+		PROFILE_FUNCTION();
+
+		m_DestroyDepth++;
+		for (Entity entity : entities)
+		{
+			// Handles destroyed before this call are skipped. Children of an entity released earlier in the list
+			// stay valid until FlushReleasedEntities, ReleaseEntity skips them since they left m_EntityMap.
+			if (m_Registry.valid(entity.m_Handle))
+				ReleaseEntity(entity, true);
+		}
+		FlushReleasedEntities();
+	}
+
+	void Scene::ReleaseEntity(Entity entity, bool popHierarchy)
+	{
+		// Released entities stay in the registry until the outermost destroy call returns
+		UUID id = entity.GetUUID();
+		if (m_EntityMap.find(id) == m_EntityMap.end())
+			return;
+		m_EntityMap.erase(id);
+
 		if (entity.HasComponent<ScriptComponent>())
 			entity.DestroyAllScripts();
 
 		if (entity.HasComponent<RigidbodyComponent>())
 		{
 			if (m_EnablePhysics && m_PhysicsWorld->IsInitialized())
-				m_PhysicsWorld->DestroyRuntimeBody(entity.GetUUID());	
+				m_PhysicsWorld->DestroyRuntimeBody(id);
 		}
 
 		if (m_PrimaryCameraEntity == entity)
@@ -244,7 +349,7 @@ namespace proton {
 			m_PrimaryCamera = nullptr;
 		}
 
-		DestroyChildEntities(entity);
+		ReleaseChildEntities(entity);
 
 		// Update parent hierarchy only for entity which is being deleted
 		auto& rc = entity.GetComponent<RelationshipComponent>();
@@ -266,106 +371,172 @@ namespace proton {
 				next.GetComponent<RelationshipComponent>().Prev = rc.Prev;
 		}
 
-		if (rc.Parent == entt::null) 
-		{
-			auto it = std::find(m_Root.begin(), m_Root.end(), entity);
-			if (it != m_Root.end())
-				m_Root.erase(it);
-		}
+		if (rc.Parent == entt::null)
+			UnlinkRootEntity(entity);
 
-		m_EntityMap.erase(entity.GetUUID());
-		m_Registry.destroy(entity.m_Handle);
+		m_ReleasedEntities.push_back(entity.m_Handle);
 	}
 
-	void Scene::DestroyChildEntities(Entity entity)
+	void Scene::ReleaseChildEntities(Entity entity)
 	{
-		auto& rc = entity.GetComponent<RelationshipComponent>();
-		Entity current{ rc.First, this };
-		while (current)
+		entt::entity current = entity.GetComponent<RelationshipComponent>().First;
+		while (current != entt::null)
 		{
-			entt::entity next = current.GetComponent<RelationshipComponent>().Next;
-			DestroyEntity(current, false);
-			current = Entity{ next, this };
+			entt::entity next = m_Registry.get<RelationshipComponent>(current).Next;
+			ReleaseEntity(Entity{ current, this }, false);
+			current = next;
 		}
+
+		// Fetched again, scripts destroyed above may have resized the pool
+		auto& rc = entity.GetComponent<RelationshipComponent>();
 		rc.ChildrenCount = 0;
 		rc.First = entt::null;
 	}
 
-	void Scene::DestroyAll()
+	void Scene::FlushReleasedEntities()
 	{
-		m_Registry.view<IDComponent>().each([&](entt::entity e, auto& component)
-		{
-			Entity entity{ e, this };
-			DestroyEntity(entity);
-		});
+		if (--m_DestroyDepth)
+			return;
+
+		m_Registry.destroy(m_ReleasedEntities.begin(), m_ReleasedEntities.end());
+		m_ReleasedEntities.clear();
+		m_TransformHierarchy->Invalidate();
 	}
 
-	void Scene::SetEntityLocalPosition(Entity entity, const glm::vec3& position)
+	void Scene::Clear()
 	{
-		auto [transform, rc] = m_Registry.get<TransformComponent, RelationshipComponent>(entity.m_Handle);
-		transform.WorldPosition = position;
-		transform.LocalPosition = position;
-		Entity current{ rc.Parent, this };
-		while (current)
-		{
-			auto& crc = current.GetComponent<RelationshipComponent>();
-			transform.WorldPosition += current.GetTransform().LocalPosition;
-			current = Entity{ crc.Parent, this };
-		}
+		PROFILE_FUNCTION();
+
+		for (entt::entity e : m_Registry.view<ScriptComponent>())
+			Entity{ e, this }.DestroyAllScripts();
+
+		// Deleting the world releases all runtime bodies, an empty one is built in its place
+		bool physicsWorldInitialized = m_PhysicsWorld->IsInitialized();
+		if (physicsWorldInitialized)
+			m_PhysicsWorld->DestroyWorld();
+		m_PhysicsWorld->m_EntitiesToInitialize.clear();
+
+		m_PrimaryCameraEntity = entt::null;
+		m_PrimaryCamera = nullptr;
+
+		m_Registry.clear();
+		m_EntityMap.clear();
+		m_RootFirst = entt::null;
+		m_RootLast = entt::null;
+		m_RootCount = 0;
+		m_TransformHierarchy->Clear();
+		m_TagIndex->Clear();
+		m_SpatialIndex->Clear();
+		m_CommandBuffer->Clear();
+		if (m_WorldStreamer)
+			m_WorldStreamer->ResetCells();
+
+		if (physicsWorldInitialized)
+			m_PhysicsWorld->BuildWorld();
 	}
 
-	void Scene::SetEntityWorldPosition(Entity entity, const glm::vec3& position)
+	void Scene::EnableWorldStreaming(float cellSize)
 	{
-		auto [transform, rc] = m_Registry.get<TransformComponent, RelationshipComponent>(entity.m_Handle);
-		transform.WorldPosition = position;
-		transform.LocalPosition = position;
-		Entity current{ rc.Parent, this };
-		while (current)
-		{
-			auto& crc = current.GetComponent<RelationshipComponent>();
-			transform.LocalPosition -= current.GetTransform().LocalPosition;
-			current = Entity{ crc.Parent, this };
-		}
+		if (m_WorldStreamer)
+			return;
+
+		m_WorldStreamer = MakeUnique<WorldStreamer>(this, cellSize);
+	}
+
+	void Scene::DisableWorldStreaming()
+	{
+		if (!m_WorldStreamer)
+			return;
+
+		// Streamed entities become regular scene entities
+		m_WorldStreamer->LoadAllCells();
+		m_Registry.clear<StreamingCellComponent>();
+		m_WorldStreamer.reset();
 	}
 
-	static void CalculateEntityWorldPositon(Scene* scene, Entity entity, const glm::vec3& parentPos, RelationshipComponent& rc, bool isPhysicsSimulated)
+	void Scene::LinkRootEntity(entt::entity entity)
 	{
-		auto& transform = entity.GetTransform();
-		if (isPhysicsSimulated && entity.HasComponent<RigidbodyComponent>())
-			scene->SetEntityWorldPosition(entity, transform.WorldPosition);
+		auto& rc = m_Registry.get<RelationshipComponent>(entity);
+		PT_CORE_ASSERT(rc.Parent == entt::null, "Entity has a parent!");
+
+		rc.Prev = m_RootLast;
+		rc.Next = entt::null;
+		if (m_RootLast != entt::null)
+			m_Registry.get<RelationshipComponent>(m_RootLast).Next = entity;
 		else
-			transform.WorldPosition = parentPos + transform.LocalPosition;
-		if (rc.First != entt::null) 
-		{
-			Entity current{ rc.First, scene };
-			while (current) 
-			{
-				auto& crc = current.GetComponent<RelationshipComponent>();
-				CalculateEntityWorldPositon(scene, current, transform.WorldPosition, crc, isPhysicsSimulated);
-				current = Entity{ crc.Next, scene};
-			}
-		}
+			m_RootFirst = entity;
+
+		m_RootLast = entity;
+		m_RootCount++;
 	}
 
-	void Scene::CalculateWorldPositions(bool isPhysicsSimulated)
+	void Scene::UnlinkRootEntity(entt::entity entity)
 	{
-		for (auto& entity : m_Root)
-		{
-			auto& transform = entity.GetTransform();
-			if (isPhysicsSimulated)
-				transform.LocalPosition = transform.WorldPosition;
-			else
-				transform.WorldPosition = transform.LocalPosition;
+		auto& rc = m_Registry.get<RelationshipComponent>(entity);
 
-			auto& rrc = entity.GetComponent<RelationshipComponent>();
-			Entity current{ rrc.First, this };
-			while (current)
-			{
-				auto& rc = current.GetComponent<RelationshipComponent>();
-				CalculateEntityWorldPositon(this, current, transform.WorldPosition, rc, isPhysicsSimulated);
-				current = Entity{ rc.Next, this };
-			}
-		}
+		if (rc.Prev != entt::null)
+			m_Registry.get<RelationshipComponent>(rc.Prev).Next = rc.Next;
+		else if (m_RootFirst == entity)
+			m_RootFirst = rc.Next;
+		else
+			return; // not linked (created with addToSceneRoot = false)
+
+		if (rc.Next != entt::null)
+			m_Registry.get<RelationshipComponent>(rc.Next).Prev = rc.Prev;
+		else
+			m_RootLast = rc.Prev;
+
+		rc.Prev = entt::null;
+		rc.Next = entt::null;
+		m_RootCount--;
+	}
+
+	// World transform of the parent as of the last hierarchy update (identity for roots)
+	static void GetParentWorldTransform(entt::registry& registry, entt::entity parent, glm::vec3& position, float& rotation)
+	{
+		position = glm::vec3(0.0f);
+		rotation = 0.0f;
+		if (parent == entt::null)
+			return;
+
+		auto& transform = registry.get<TransformComponent>(parent);
+		position = transform.WorldPosition;
+		rotation = transform.WorldRotation;
+	}
+
+	void Scene::SetEntityLocalPosition(Entity entity, const glm::vec3& position)
+	{
+		auto [transform, rc] = m_Registry.get<TransformComponent, RelationshipComponent>(entity.m_Handle);
+		glm::vec3 parentPosition; float parentRotation;
+		GetParentWorldTransform(m_Registry, rc.Parent, parentPosition, parentRotation);
+
+		float radians = glm::radians(parentRotation);
+		float cosinus = glm::cos(radians), sinus = glm::sin(radians);
+		transform.LocalPosition = position;
+		transform.WorldPosition = {
+			parentPosition.x + position.x * cosinus - position.y * sinus,
+			parentPosition.y + position.x * sinus + position.y * cosinus,
+			parentPosition.z + position.z
+		};
+		m_TransformHierarchy->MarkDirty(entity.m_Handle);
+	}
+
+	void Scene::SetEntityWorldPosition(Entity entity, const glm::vec3& position)
+	{
+		auto [transform, rc] = m_Registry.get<TransformComponent, RelationshipComponent>(entity.m_Handle);
+		glm::vec3 parentPosition; float parentRotation;
+		GetParentWorldTransform(m_Registry, rc.Parent, parentPosition, parentRotation);
+
+		float radians = glm::radians(parentRotation);
+		float cosinus = glm::cos(radians), sinus = glm::sin(radians);
+		glm::vec3 offset = position - parentPosition;
+		transform.WorldPosition = position;
+		transform.LocalPosition = {
+			offset.x * cosinus + offset.y * sinus,
+			offset.y * cosinus - offset.x * sinus,
+			offset.z
+		};
+		m_TransformHierarchy->MarkDirty(entity.m_Handle);
 	}
 
 	void Scene::OnUpdate(float ts)
@@ -375,35 +546,77 @@ namespace proton {
 		CachePrimaryCameraPosition();
 		CacheCursorWorldPosition();
 
-		if (m_SceneState == SceneState::Play)
-		{
-			// Update physics
-			if (m_EnablePhysics && m_PhysicsWorld->IsInitialized())
-			{
-				m_PhysicsWorld->Update(ts);
-				// Calculate world positions (physics simulation)
-				CalculateWorldPositions(true);
-			}
+		m_Systems->Run(ts);
+	}
 
-			// Update scripts
-			UpdateScripts(ts);
+	void Scene::OnRender()
+	{
+		PROFILE_FUNCTION();
+		RenderScene(GetPrimaryCamera());
+	}
 
-			// Update animations
-			auto view = m_Registry.view<SpriteAnimationComponent>();
-			for (auto entity : view)
-			{
-				auto& animation = view.get<SpriteAnimationComponent>(entity).SpriteAnimation;
-				animation.Update(ts);
-			}
-		}
-		else 
+	void Scene::RegisterGroups()
+	{
+		// Groups are created before any entity exists, then kept sorted by the registry.
+		// Transform and sprite pools are owned: both are packed in the same order for rendering.
+		// Rigidbody and circle pools are ordered by their groups, transforms are looked up.
+		// Adding or removing a SpriteComponent moves TransformComponents inside their pool,
+		// references to transforms must not be kept across these changes.
+		m_Registry.group<TransformComponent, SpriteComponent>();
+		m_Registry.group<RigidbodyComponent>(entt::get<TransformComponent>);
+		m_Registry.group<CircleRendererComponent>(entt::get<TransformComponent>);
+	}
+
+	void Scene::RegisterSystems()
+	{
+		// Declaring component access creates the pools up front, concurrent systems only look them up
+		auto isPlaying = [this]() { return m_SceneState == SceneState::Play; };
+		auto isSimulatingPhysics = [this]() { return m_SceneState == SceneState::Play && m_EnablePhysics && m_PhysicsWorld->IsInitialized(); };
+
+		// Contact callbacks of scripts can touch anything
+		m_Systems->AddSystem("Physics", [this](float ts) { m_PhysicsWorld->Update(ts); })
+			.Exclusive().MainThread().RunIf(isSimulatingPhysics);
+
+		// Propagate world transforms (physics simulation)
+		m_Systems->AddSystem("PhysicsTransforms", [this](float) { UpdateTransforms(true); })
+			.Write<TransformComponent>().Read<RelationshipComponent, RigidbodyComponent>().RunIf(isSimulatingPhysics);
+
+		m_Systems->AddSystem("Scripts", [this](float ts) { UpdateScripts(ts); })
+			.Exclusive().MainThread().RunIf(isPlaying);
+
+		// Sync point of structural changes recorded during the update
+		m_Systems->AddSystem("EntityCommands", [this](float) { m_CommandBuffer->Apply(); })
+			.Exclusive().MainThread();
+
+		// Cells around the camera, entities are created and destroyed
+		m_Systems->AddSystem("WorldStreaming", [this](float) { m_WorldStreamer->Update(m_PrimaryCameraPosition); })
+			.Exclusive().MainThread().RunIf([this]() { return m_WorldStreamer && m_SceneState == SceneState::Play; });
+
+		// Runs alongside the transform propagation
+		m_Systems->AddSystem("Animations", [this](float ts) { UpdateAnimations(ts); })
+			.Write<SpriteAnimationComponent, SpriteComponent>().RunIf(isPlaying);
+
+		// Transforms changed by scripts or the editor, only those nodes are recomputed
+		m_Systems->AddSystem("Transforms", [this, isSimulatingPhysics](float) { UpdateTransforms(isSimulatingPhysics()); })
+			.Write<TransformComponent>().Read<RelationshipComponent, RigidbodyComponent>();
+	}
+
+	void Scene::UpdateAnimations(float ts)
+	{
+		auto view = m_Registry.view<SpriteAnimationComponent>();
+		for (auto entity : view)
 		{
-			// Calculate world positions (no physics simulation)
-			CalculateWorldPositions(false);
+			auto& animation = view.get<SpriteAnimationComponent>(entity).SpriteAnimation;
+			animation.Update(ts);
 		}
+	}
 
-		// Render scene
-		RenderScene(GetPrimaryCamera());
+	void Scene::UpdateTransforms(bool isPhysicsSimulated)
+	{
+		m_TransformHierarchy->Update(isPhysicsSimulated);
+		m_SpatialIndex->Update(m_TransformHierarchy->GetChangedEntities());
+		m_SpriteImpostors->OnTransformsChanged(m_TransformHierarchy->GetChangedEntities());
+		m_TransformHierarchy->ClearChangedEntities();
 	}
 
 	void Scene::UpdateScripts(float ts)
@@ -424,11 +637,88 @@ namespace proton {
 						continue;
 					}
 				}
-				if (!scriptInstance->m_Stopped)
+				if (!scriptInstance->m_Stopped && !scriptInstance->m_ThreadSafeUpdate)
 					scriptInstance->OnUpdate(ts);
 			}
 		}
+
+		// Collected after serial updates, those may have destroyed scripted entities
+		m_ParallelScripts.clear();
+		for (auto entity : view)
+		{
+			for (auto& [scriptClassName, scriptInstance] : view.get<ScriptComponent>(entity).Scripts)
+			{
+				if (scriptInstance->m_ThreadSafeUpdate && scriptInstance->m_Initialized && !scriptInstance->m_Stopped)
+					m_ParallelScripts.push_back(scriptInstance);
+			}
+		}
+
+		if (m_ParallelScripts.size())
+			UpdateParallelScripts(ts);
+	}
+
+	void Scene::OnParallelStructuralChange(const char* operation) const
+	{
+		PT_CORE_CRITICAL("{} called from a thread-safe script, use the scene command buffer!", operation);
+		std::abort();
+	}
+
+	void Scene::UpdateParallelScripts(float ts)
+	{
+		PROFILE_FUNCTION();
+
+	#ifdef PROTON_DEBUG
+		m_ParallelAccesses.resize(EntityCommandBuffer::GetThreadsCount());
+	#endif
+
+		// Structural changes are not allowed or deferred to the command buffer from now on
+		m_ParallelScriptsUpdate = true;
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		jobSystem.ParallelFor("Scene::UpdateParallelScripts", (uint32_t)m_ParallelScripts.size(), 64, [&](uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = first; i < last; i++)
+			{
+				EntityScript* script = m_ParallelScripts[i];
+				s_ParallelScriptEntity = script->m_Handle;
+				script->OnUpdate(ts);
+			}
+			s_ParallelScriptEntity = entt::null;
+		});
+		m_ParallelScriptsUpdate = false;
+
+	#ifdef PROTON_DEBUG
+		ValidateParallelAccesses();
+	#endif
+	}
+
+#ifdef PROTON_DEBUG
+	void Scene::TrackParallelAccess(entt::entity entity, const void* component, size_t size, const char* typeName)
+	{
+		ParallelAccess& access = m_ParallelAccesses[EntityCommandBuffer::GetThreadIndex()].emplace_back();
+		access.Script = s_ParallelScriptEntity;
+		access.Target = entity;
+		access.Component = component;
+		access.Snapshot.assign((const uint8_t*)component, (const uint8_t*)component + size);
+		access.TypeName = typeName;
+	}
+
+	void Scene::ValidateParallelAccesses()
+	{
+		for (auto& accesses : m_ParallelAccesses)
+		{
+			for (const ParallelAccess& access : accesses)
+			{
+				if (memcmp(access.Component, access.Snapshot.data(), access.Snapshot.size()) == 0)
+					continue;
+
+				const std::string& script = access.Script != entt::null ? m_Registry.get<TagComponent>(access.Script).Tag : "<none>";
+				PT_CORE_ERROR("Thread-safe script of entity '{}' accessed {} of entity '{}' which was modified during the parallel update!",
+					script, access.TypeName, m_Registry.get<TagComponent>(access.Target).Tag);
+			}
+			accesses.clear();
+		}
 	}
+#endif
 
 	Entity Scene::FindByID(UUID id)
 	{
@@ -439,52 +729,112 @@ namespace proton {
 
 	Entity Scene::FindByTag(const std::string& tag)
 	{
-		auto view = m_Registry.view<TagComponent>();
-		for (auto entity : view)
-		{
-			if (tag == view.get<TagComponent>(entity).Tag)
-				return Entity(entity, this);
-		}
-		return Entity();
+		return FindByTag(TagIndex::Find(tag));
 	}
 
-	std::vector<Entity> Scene::FindAllByTag(const std::string& tag)
+	Entity Scene::FindByTag(TagSymbol tagSymbol)
 	{
-		auto view = m_Registry.view<TagComponent>();
-		std::vector<Entity> entities;
-		entities.reserve(view.size());
-		for (auto entity : view) 
-		{
-			if (tag == view.get<TagComponent>(entity).Tag)
-				entities.emplace_back(Entity(entity, this));
-		}
-		return entities;
+		const auto& entities = m_TagIndex->GetEntities(tagSymbol);
+		return entities.size() ? Entity(entities.front(), this) : Entity();
+	}
+
+	EntityRange Scene::FindAllByTag(const std::string& tag)
+	{
+		return FindAllByTag(TagIndex::Find(tag));
+	}
+
+	EntityRange Scene::FindAllByTag(TagSymbol tagSymbol)
+	{
+		return EntityRange(m_TagIndex->GetEntities(tagSymbol), m_TagIndex.get(), this);
+	}
+
+	void Scene::FindAllByTag(const std::string& tag, std::vector<Entity>& outEntities)
+	{
+		FindAllByTag(TagIndex::Find(tag), outEntities);
+	}
+
+	void Scene::FindAllByTag(TagSymbol tagSymbol, std::vector<Entity>& outEntities)
+	{
+		const auto& entities = m_TagIndex->GetEntities(tagSymbol);
+		outEntities.reserve(outEntities.size() + entities.size());
+		for (entt::entity entity : entities)
+			outEntities.emplace_back(entity, this);
 	}
 
 	void Scene::RenderScene(const Camera& camera)
 	{
 		PROFILE_FUNCTION();
-		Renderer::BeginScene(camera, GetPrimaryCameraPosition());
+
+		// Sprite level of detail: sprites smaller than a few pixels are skipped and when zoomed out,
+		// static sprites are replaced by chunk impostors (see SpriteImpostorCache)
+		const OrthoProjection& ortho = camera.GetOrthoProjection();
+		float pixelsPerUnit = (float)Renderer::GetViewportSize().y / (ortho.Top - ortho.Bottom);
+		bool enableLOD = m_EnableSpriteLOD && pixelsPerUnit > 0.0f;
+		float minSpriteSize = enableLOD ? m_MinSpritePixelSize / pixelsPerUnit : 0.0f;
+		bool useImpostors = enableLOD && pixelsPerUnit < SpriteImpostorCache::PixelsPerUnitThreshold;
+		m_CulledSpritesCount = 0;
+		m_DrawnImpostorsCount = 0;
+
+		if (useImpostors)
+		{
+			// Impostors are rendered to texture, so they are updated before frame batch recording
+			const glm::vec3& position = GetPrimaryCameraPosition();
+			m_SpriteImpostors->Update({ position.x + ortho.Left, position.y + ortho.Bottom }, { position.x + ortho.Right, position.y + ortho.Top });
+		}
+
+		// With additional views, batches are recorded once and replayed for every view (see Scene::AddView)
+		bool recordFrameBatch = !m_AdditionalViews.empty();
+		Renderer::SetSpriteMeshes(m_EnableSpriteMeshes);
+		if (recordFrameBatch)
+			Renderer::BeginFrameBatch();
+		else
+			Renderer::BeginScene(camera, GetPrimaryCameraPosition());
+
+		// Submit point lights before any quad gets flushed
+		Renderer::SetLighting(m_EnableLighting, m_AmbientLightColor);
+		if (m_EnableLighting)
+		{
+			PROFILE_SCOPE("scene_submit_lights");
+			auto lightsView = m_Registry.view<TransformComponent, PointLight2DComponent>();
+			for (auto e : lightsView)
+			{
+				auto [transform, light] = lightsView.get<TransformComponent, PointLight2DComponent>(e);
+				Renderer::SubmitPointLight(glm::vec2(transform.WorldPosition), light.Radius, light.Color, light.Intensity);
+			}
+		}
 
 		// Render entities with SpriteComponent
-		auto renderableSprite = m_Registry.view<SpriteComponent, TransformComponent>();
-		for (auto e : renderableSprite)
+		if (useImpostors)
 		{
-			PROFILE_SCOPE("entity_render_sprite");
-			auto [transform, sprite] = renderableSprite.get<TransformComponent, SpriteComponent>(e);
-			
-			// Sprite mirror flip
-			glm::vec3 scale = {
-				transform.Scale.x * (sprite.Sprite.m_MirrorFlipX ? -1.0f : 1.0f),
-				transform.Scale.y * (sprite.Sprite.m_MirrorFlipY ? -1.0f : 1.0f), 1.0f
-			};
-
-			glm::mat4 transformMatrix = Math::GetTransform(transform.WorldPosition, scale, transform.Rotation);
-
-			if (sprite.Sprite)
-				Renderer::DrawQuad(transformMatrix, sprite.Sprite, sprite.Color, sprite.TilingFactor);
-			else
-				Renderer::DrawQuad(transformMatrix, sprite.Color, sprite.TilingFactor);
+			m_LODSprites.clear();
+			m_SpriteImpostors->Draw(m_LODSprites);
+			m_DrawnImpostorsCount = m_SpriteImpostors->GetDrawnImpostorsCount();
+
+			for (entt::entity e : m_LODSprites)
+			{
+				PROFILE_SCOPE("entity_render_sprite");
+				auto [transform, sprite] = m_Registry.get<TransformComponent, SpriteComponent>(e);
+				if (glm::max(glm::abs(transform.Scale.x), glm::abs(transform.Scale.y)) < minSpriteSize)
+				{
+					m_CulledSpritesCount++;
+					continue;
+				}
+				DrawSprite(transform, sprite);
+			}
+		}
+		else
+		{
+			auto renderableSprite = m_Registry.group<TransformComponent, SpriteComponent>();
+			for (auto [e, transform, sprite] : renderableSprite.each())
+			{
+				PROFILE_SCOPE("entity_render_sprite");
+				if (glm::max(glm::abs(transform.Scale.x), glm::abs(transform.Scale.y)) < minSpriteSize)
+				{
+					m_CulledSpritesCount++;
+					continue;
+				}
+				DrawSprite(transform, sprite);
+			}
 		}
 
 		// Render entities with ResizableSpriteComponent
@@ -499,7 +849,7 @@ namespace proton {
 			if (!spritesheet)
 				continue;
 
-			glm::mat4 transformMatrix = Math::GetTransform(transform.WorldPosition, glm::vec2{1.0f}, transform.Rotation);
+			glm::mat4 transformMatrix = Math::GetTransform(transform.WorldPosition, glm::vec2{1.0f}, transform.WorldRotation);
 			
 			// TODO: optimize
 			for (const auto& column : sprite.m_Tilemap)
@@ -511,15 +861,52 @@ namespace proton {
 		}
 
 		// Render Circles
-		auto circlesView = m_Registry.view<TransformComponent, CircleRendererComponent>();
-		for (auto entity : circlesView)
+		auto circlesGroup = m_Registry.group<CircleRendererComponent>(entt::get<TransformComponent>);
+		for (auto [entity, circle, transform] : circlesGroup.each())
 		{
-			auto [transform, circle] = circlesView.get<TransformComponent, CircleRendererComponent>(entity);
+			Renderer::DrawCircle(transform.WorldMatrix, circle.Color, circle.Thickness, circle.Fade);
+		}
 
-			Renderer::DrawCircle(Math::GetTransform(transform.WorldPosition, transform.Scale, transform.Rotation), circle.Color, circle.Thickness, circle.Fade);
+		if (recordFrameBatch)
+		{
+			Renderer::EndFrameBatch();
+			Renderer::DrawFrameBatch(camera, GetPrimaryCameraPosition());
+
+			glm::uvec4 viewport = Renderer::GetViewport();
+			for (const SceneView& view : m_AdditionalViews)
+			{
+				Renderer::SetViewport(view.Viewport.x, view.Viewport.y, view.Viewport.z, view.Viewport.w);
+				Renderer::DrawFrameBatch(view.ViewCamera, view.Position);
+			}
+			Renderer::SetViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+			m_AdditionalViews.clear();
 		}
+		else
+		{
+			Renderer::EndScene();
+		}
+
+		m_Canvas->OnRender(Renderer::GetViewportSize());
+	}
+
+	void Scene::DrawSprite(const TransformComponent& transform, const SpriteComponent& sprite)
+	{
+		// Sprite mirror flip
+		glm::mat4 transformMatrix = transform.WorldMatrix;
+		if (sprite.Sprite.m_MirrorFlipX)
+			transformMatrix[0] = -transformMatrix[0];
+		if (sprite.Sprite.m_MirrorFlipY)
+			transformMatrix[1] = -transformMatrix[1];
+
+		if (sprite.Sprite)
+			Renderer::DrawQuad(transformMatrix, sprite.Sprite, sprite.Color, sprite.TilingFactor);
+		else
+			Renderer::DrawQuad(transformMatrix, sprite.Color, sprite.TilingFactor);
+	}
 
-		Renderer::EndScene();
+	void Scene::AddView(const Camera& camera, const glm::vec3& position, const glm::uvec4& viewport)
+	{
+		m_AdditionalViews.push_back({ camera, position, viewport });
 	}
 
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
@@ -606,65 +993,13 @@ namespace proton {
 
 	bool Scene::IsCursorHoveringEntity(Entity entity)
 	{
-		auto& transform = entity.GetComponent<TransformComponent>();
-
-		// Apply entity rotation to point (mouse position)
-		// so we can easliy check after if point is inside rectangle
-		float sinus = sin(glm::radians(-transform.Rotation));
-		float cosinus = cos(glm::radians(-transform.Rotation));
-		glm::vec2 point = GetCursorWorldPosition();
-		if (transform.Rotation)
-		{
-			glm::vec2 rotationCenter = { transform.WorldPosition.x, transform.WorldPosition.y };
-			point -= rotationCenter;
-			point = {
-				point.x * cosinus - point.y * sinus + rotationCenter.x,
-				point.x * sinus + point.y * cosinus + rotationCenter.y
-			};
-		}
-
-		// Check if point is inside entity bounding box
-		const glm::vec3& position = transform.WorldPosition;
-		const glm::vec2& scale = transform.Scale;
-		return point.x >= position.x - scale.x / 2.0f && point.x <= position.x + scale.x / 2.0f
-			&& point.y >= position.y - scale.y / 2.0f && point.y <= position.y + scale.y / 2.0f;
+		return m_SpatialIndex->Contains(entity, GetCursorWorldPosition());
 	}
 
 	std::vector<Entity> Scene::GetEntitiesOnCursorLocation()
 	{
-		// TODO: Optimize / refactor
-		const glm::vec2& mousePos = GetCursorWorldPosition();
-		auto view = m_Registry.view<TransformComponent>();
 		std::vector<Entity> entities;
-
-		for (auto entity : view)
-		{
-			auto& transform = view.get<TransformComponent>(entity);
-
-			// Apply entity rotation to point (mouse position)
-			// so we can easliy check after if point is inside rectangle
-			float sinus = sin(glm::radians(-transform.Rotation));
-			float cosinus = cos(glm::radians(-transform.Rotation));
-			glm::vec2 point = mousePos;
-			if (transform.Rotation)
-			{
-				glm::vec2 rotationCenter = { transform.WorldPosition.x, transform.WorldPosition.y };
-				point -= rotationCenter;
-				point = {
-					point.x * cosinus - point.y * sinus + rotationCenter.x,
-					point.x * sinus + point.y * cosinus + rotationCenter.y
-				};
-			}
-
-			// Check if point is inside entity bounding box
-			const glm::vec3& position = transform.WorldPosition;
-			const glm::vec2& scale = transform.Scale;
-			if (point.x >= position.x - scale.x / 2.0f && point.x <= position.x + scale.x / 2.0f
-				&& point.y >= position.y - scale.y / 2.0f && point.y <= position.y + scale.y / 2.0f)
-			{
-				entities.emplace_back(Entity{ entity, this });
-			}
-		}
+		m_SpatialIndex->QueryPoint(GetCursorWorldPosition(), entities);
 		return entities;
 	}
 
@@ -678,6 +1013,23 @@ namespace proton {
 		m_ClearColor = color;
 	}
 
+	void Scene::SetLighting(bool enabled, const glm::vec4& ambientColor)
+	{
+		m_EnableLighting = enabled;
+		m_AmbientLightColor = ambientColor;
+	}
+
+	void Scene::SetSpriteLOD(bool enabled, float minSpritePixelSize)
+	{
+		m_EnableSpriteLOD = enabled;
+		m_MinSpritePixelSize = minSpritePixelSize;
+	}
+
+	void Scene::SetSpriteMeshes(bool enabled)
+	{
+		m_EnableSpriteMeshes = enabled;
+	}
+
 	uint32_t Scene::GetEntitiesCount() const
 	{
 		return (int32_t)m_Registry.view<IDComponent>().size();
@@ -3,6 +3,7 @@
 #include "Proton/Graphics/Camera.h"
 #include "Proton/Events/Event.h"
 #include "Proton/Core/UUID.h"
+#include "Proton/Scene/TagIndex.h"
 
 #include <entt/entt.hpp>
 
@@ -14,7 +15,18 @@ namespace proton {
 
 	// Forward declaration
 	class Entity;
+	class EntityRange;
 	class PhysicsWorld;
+	class SpriteImpostorCache;
+	class UICanvas;
+	class TransformHierarchy;
+	class SpatialIndex;
+	class EntityCommandBuffer;
+	class SystemScheduler;
+	class WorldStreamer;
+	class EntityScript;
+	struct TransformComponent;
+	struct SpriteComponent;
 
 	enum class SceneState
 	{
@@ -42,14 +54,31 @@ namespace proton {
 		Entity CreateEntityWithUUID(UUID id, const std::string& name = "Entity", bool addToSceneRoot = true);
 		void DestroyEntity(Entity entity, bool popHierachy = true);
 		void DestroyChildEntities(Entity entity);
-		void DestroyAll();
+
+		// Creates root entities in bulk (range create and insert), outEntities has to hold count entities
+		void CreateEntities(uint32_t count, Entity* outEntities, const std::string& name = "Entity");
+
+		// Destroys entities in bulk, entities already destroyed as children of others in the list are skipped
+		void DestroyEntities(const std::vector<Entity>& entities);
+
+		// Destroys all entities at once: scripts are destroyed, runtime bodies are dropped
+		// with the physics world and registry pools are cleared in a single pass
+		void Clear();
 
 		void SetEntityLocalPosition(Entity entity, const glm::vec3& position);
 		void SetEntityWorldPosition(Entity entity, const glm::vec3& position);
 
 		Entity FindByID(UUID id);
 		Entity FindByTag(const std::string& tag);
-		std::vector<Entity> FindAllByTag(const std::string& tag);
+		Entity FindByTag(TagSymbol tagSymbol);
+		// Lookups through the tag index, symbols from TagIndex::Intern skip hashing of the tag
+		// The range is invalidated by creating, destroying or retagging tagged entities, using it afterwards
+		// aborts (see EntityRange). Copy into a vector with the overloads below to change entities while iterating.
+		EntityRange FindAllByTag(const std::string& tag);
+		EntityRange FindAllByTag(TagSymbol tagSymbol);
+		// Appends copies of the entities, safe to iterate while entities are created or destroyed
+		void FindAllByTag(const std::string& tag, std::vector<Entity>& outEntities);
+		void FindAllByTag(TagSymbol tagSymbol, std::vector<Entity>& outEntities);
 
 		void SetPrimaryCameraEntity(Entity entity);
 		Entity GetPrimaryCameraEntity();
@@ -69,21 +98,75 @@ namespace proton {
 		uint32_t GetScriptedEntitiesCount() const;
 
 		void SetScreenClearColor(const glm::vec4& color);
+		void SetLighting(bool enabled, const glm::vec4& ambientColor = { 1.0f, 1.0f, 1.0f, 1.0f });
+
+		// Zoom dependent sprite LOD, sprites smaller than minSpritePixelSize on screen are skipped
+		void SetSpriteLOD(bool enabled, float minSpritePixelSize = 1.0f);
+		uint32_t GetCulledSpritesCount() const { return m_CulledSpritesCount; }
+		uint32_t GetDrawnImpostorsCount() const { return m_DrawnImpostorsCount; }
+
+		// Sprites drawn with tight meshes of their texture alpha instead of full quads (see SpriteMesh), disabled by default
+		void SetSpriteMeshes(bool enabled);
+
+		// Render the scene from an additional camera (split-screen, minimap) into a viewport of the bound
+		// framebuffer. Views are requested before the scene is rendered and dropped after, batches are
+		// recorded and replayed for every view only in frames with additional views.
+		void AddView(const Camera& camera, const glm::vec3& position, const glm::uvec4& viewport);
+
+		// Screen space UI drawn over the scene, created at runtime (not serialized)
+		UICanvas& GetCanvas() { return *m_Canvas; }
+
+		// Area, radius, point and ray queries over entity transforms (see SpatialIndex)
+		SpatialIndex& GetSpatialIndex() { return *m_SpatialIndex; }
+
+		// Structural changes recorded during updates, applied after scripts (see EntityCommandBuffer)
+		EntityCommandBuffer& GetCommandBuffer() { return *m_CommandBuffer; }
+
+		// Systems run by the scene update, custom systems can be added (see SystemScheduler)
+		SystemScheduler& GetSystems() { return *m_Systems; }
+
+		// Streamed scenes are partitioned into cells when saved and loaded around the camera while playing (see WorldStreamer)
+		void EnableWorldStreaming(float cellSize);
+		void DisableWorldStreaming();
+		WorldStreamer* GetWorldStreamer() { return m_WorldStreamer.get(); }
 
 		template<typename... Components>
 		auto GetAllEntitiesWith() { return m_Registry.view<Components...>(); }
 
 	private:
+		// Simulation systems, then rendering of the updated state with the primary camera
 		void OnUpdate(float ts);
+		void OnRender();
+		void RegisterGroups();
+		void RegisterSystems();
+		void UpdateAnimations(float ts);
 		void UpdateScripts(float ts);
+		void UpdateParallelScripts(float ts);
+		// Registry pools are not synchronized, structural changes from thread-safe scripts are fatal
+		void CheckStructuralChange(const char* operation) const { if (m_ParallelScriptsUpdate) OnParallelStructuralChange(operation); }
+		[[noreturn]] void OnParallelStructuralChange(const char* operation) const;
+	#ifdef PROTON_DEBUG
+		void TrackParallelAccess(entt::entity entity, const void* component, size_t size, const char* typeName);
+		void ValidateParallelAccesses();
+	#endif
+		// Entities get new UUIDs when ids is null
+		void CreateEntities(uint32_t count, const std::string* names, entt::entity* outHandles, const UUID* ids = nullptr);
+		void ReleaseEntity(Entity entity, bool popHierarchy);
+		void ReleaseChildEntities(Entity entity);
+		void FlushReleasedEntities();
+
+		void UpdateTransforms(bool isPhysicsSimulated);
 		void RenderScene(const Camera& camera);
+		static void DrawSprite(const TransformComponent& transform, const SpriteComponent& sprite);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
+		// Root entities are linked through RelationshipComponent::Prev/Next, like children of a parent
+		void LinkRootEntity(entt::entity entity);
+		void UnlinkRootEntity(entt::entity entity);
+
 		void CachePrimaryCameraPosition();
 		void CacheCursorWorldPosition();
 
-		void CalculateWorldPositions(bool isPhysicsSimulated);
-
 	private:
 		SceneState m_SceneState = SceneState::Stop;
 
@@ -92,10 +175,60 @@ namespace proton {
 		std::string m_SceneFilepath = "<Unsaved scene>";
 		glm::vec4 m_ClearColor = DEFAULT_SCENE_SCREEN_CLEAR_COLOR;
 
+		// Lighting
+		bool m_EnableLighting = false;
+		glm::vec4 m_AmbientLightColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		// Sprite LOD
+		bool m_EnableSpriteLOD = true;
+		float m_MinSpritePixelSize = 1.0f;
+		uint32_t m_CulledSpritesCount = 0;
+		uint32_t m_DrawnImpostorsCount = 0;
+		std::vector<entt::entity> m_LODSprites;
+
+		struct SceneView
+		{
+			Camera ViewCamera;
+			glm::vec3 Position;
+			glm::uvec4 Viewport; // x, y, width, height
+		};
+		std::vector<SceneView> m_AdditionalViews;
+		bool m_EnableSpriteMeshes = false;
+
 		// ECS
 		entt::registry m_Registry;
 		std::unordered_map<UUID, Entity> m_EntityMap;
-		std::vector<Entity> m_Root;
+		entt::entity m_RootFirst = entt::null;
+		entt::entity m_RootLast = entt::null;
+		uint32_t m_RootCount = 0;
+		Unique<TransformHierarchy> m_TransformHierarchy;
+		Unique<TagIndex> m_TagIndex;
+		Unique<SpatialIndex> m_SpatialIndex;
+		Unique<EntityCommandBuffer> m_CommandBuffer;
+		Unique<SystemScheduler> m_Systems;
+		Unique<WorldStreamer> m_WorldStreamer;
+
+		// Entities torn down by DestroyEntity, removed from the registry at once by the outermost call
+		std::vector<entt::entity> m_ReleasedEntities;
+		uint32_t m_DestroyDepth = 0;
+
+		// Scripts
+		std::vector<EntityScript*> m_ParallelScripts;
+		bool m_ParallelScriptsUpdate = false;
+		static inline thread_local entt::entity s_ParallelScriptEntity = entt::null; // owner of the script updated by this thread
+
+	#ifdef PROTON_DEBUG
+		// Components of other entities accessed by thread-safe scripts, checked for writes after the update
+		struct ParallelAccess
+		{
+			entt::entity Script = entt::null;
+			entt::entity Target = entt::null;
+			const void* Component = nullptr;
+			std::vector<uint8_t> Snapshot;
+			const char* TypeName = nullptr;
+		};
+		std::vector<std::vector<ParallelAccess>> m_ParallelAccesses; // per thread
+	#endif
 
 		// Camera
 		entt::entity m_PrimaryCameraEntity = entt::null;
@@ -106,6 +239,10 @@ namespace proton {
 		bool m_EnablePhysics = true;
 		Unique<PhysicsWorld> m_PhysicsWorld;
 
+		// Rendering
+		Unique<SpriteImpostorCache> m_SpriteImpostors;
+		Unique<UICanvas> m_Canvas;
+
 		// Cache
 		glm::vec3 m_PrimaryCameraPosition = { 0.0f, 0.0f, 0.0f };
 		glm::vec2 m_CursorWorldPosition = { 0.0f, 0.0f };
@@ -115,6 +252,12 @@ namespace proton {
 		friend class SceneSerializer;
 		friend class SceneManager;
 		friend class PhysicsWorld;
+		friend class SpriteImpostorCache;
+		friend class SpatialIndex;
+		friend class EntityCommandBuffer;
+		friend class SceneSnapshot;
+		friend class PrefabManager;
+		friend class WorldStreamer;
 		
 		friend class EditorLayer;
 		friend class EditorCamera;
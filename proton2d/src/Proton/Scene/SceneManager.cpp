@@ -1,9 +1,16 @@
 #include "ptpch.h"
 #include "Proton/Scene/SceneManager.h"
 #include "Proton/Scene/Scene.h"
+#include "Proton/Scene/WorldStreamer.h"
 #include "Proton/Assets/SceneSerializer.h"
+#include "Proton/Assets/AssetManager.h"
 #include "Proton/Core/Application.h"
+#include "Proton/Core/JobSystem.h"
+#include "Proton/Core/Timer.h"
 #include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Utils/Utils.h"
+
+#include <unordered_set>
 
 #ifdef PT_EDITOR
 #include "Proton/Editor/EditorLayer.h"
@@ -13,6 +20,28 @@ namespace proton {
 
 	SceneManager* SceneManager::s_Instance = nullptr;
 
+	struct SceneManager::AsyncLoad
+	{
+		enum class LoadState
+		{
+			Reading, Uploading, Building
+		};
+
+		std::string ScenePath;
+		std::string Filepath;
+		LoadState State = LoadState::Reading;
+		JobCounter Counter;
+		bool Failed = false;
+		SceneLoadedCallback Callback;
+
+		// Written by workers, read by the main thread once Counter is done
+		json Data;
+		std::vector<std::string> Textures;
+		std::vector<Unique<TextureImage>> Images;
+		uint32_t UploadedCount = 0;
+		Shared<Scene> LoadedScene;
+	};
+
 	void SceneManager::Init()
 	{
 		if (!s_Instance)
@@ -55,19 +84,192 @@ namespace proton {
 		SceneSerializer serializer(scene.get());
 
 		std::string filepath = "content/scenes/" + scenePath + ".scene.json";
+		Timer timer;
 		if (!serializer.Deserialize(filepath))
 		{
 			PT_CORE_ERROR("Loading '{}' failed!", filepath);
 			return nullptr;
 		}
+		PT_CORE_INFO("scene='{}' entities={} load={:.2f}ms", scenePath, scene->GetEntitiesCount(), timer.ElapsedMillis());
 		s_Instance->m_Scenes[scenePath] = scene;
 		return scene.get();
 	}
 
+	void SceneManager::LoadAsync(const std::string& scenePath, SceneLoadedCallback callback)
+	{
+		if (IsLoading(scenePath))
+		{
+			PT_CORE_WARN("Scene '{}' is already loading!", scenePath);
+			return;
+		}
+
+		if (IsLoaded(scenePath))
+		{
+			if (callback)
+				callback(GetScene(scenePath));
+			return;
+		}
+
+		PT_CORE_INFO("file='{}.scene.json'", scenePath);
+		auto load = MakeUnique<AsyncLoad>();
+		load->ScenePath = scenePath;
+		load->Filepath = "content/scenes/" + scenePath + ".scene.json";
+		load->Callback = std::move(callback);
+
+		// Images are decoded by one job each, the reading job adds them to the counter before it finishes
+		AsyncLoad* target = load.get();
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		jobSystem.Run("SceneManager::ReadScene", [target, &jobSystem]()
+		{
+			// Exceptions would terminate the worker, malformed files fail the load
+			std::string data = Utils::ReadFile(target->Filepath);
+			target->Data = json::parse(data, nullptr, false);
+			if (!data.size() || target->Data.is_discarded())
+			{
+				target->Failed = true;
+				return;
+			}
+
+			std::unordered_set<std::string> textures;
+			SceneSerializer::GetTextureDependencies(target->Data, textures);
+			for (const std::string& texture : textures)
+			{
+				if (!AssetManager::IsTextureLoaded(texture))
+					target->Textures.push_back(texture);
+			}
+
+			target->Images.resize(target->Textures.size());
+			for (size_t i = 0; i < target->Textures.size(); i++)
+			{
+				jobSystem.Run("SceneManager::DecodeTexture", [target, i]()
+				{
+					target->Images[i] = AssetManager::DecodeTexture(target->Textures[i]);
+				}, &target->Counter);
+			}
+		}, &load->Counter);
+
+		s_Instance->m_AsyncLoads.push_back(std::move(load));
+	}
+
+	void SceneManager::Update()
+	{
+		if (s_Instance->m_AsyncLoads.empty())
+			return;
+
+		PROFILE_FUNCTION();
+
+		Timer timer;
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		std::vector<Unique<AsyncLoad>> finished;
+
+		auto& loads = s_Instance->m_AsyncLoads;
+		for (auto it = loads.begin(); it != loads.end();)
+		{
+			AsyncLoad& load = **it;
+			if (!load.Counter.IsDone())
+			{
+				it++;
+				continue;
+			}
+
+			if (load.State == AsyncLoad::LoadState::Reading)
+			{
+				if (load.Failed)
+				{
+					PT_CORE_ERROR("Loading '{}' failed!", load.Filepath);
+					finished.push_back(std::move(*it));
+					it = loads.erase(it);
+					continue;
+				}
+				load.State = AsyncLoad::LoadState::Uploading;
+			}
+
+			if (load.State == AsyncLoad::LoadState::Uploading)
+			{
+				// GL objects are created on the main thread, the budget is shared by all loads
+				while (load.UploadedCount < load.Images.size() && timer.ElapsedMillis() < s_Instance->m_UploadBudget)
+				{
+					// Another load or a synchronous LoadTexture may have created the texture since the read job ran
+					uint32_t index = load.UploadedCount++;
+					if (!AssetManager::IsTextureLoaded(load.Textures[index]))
+						AssetManager::LoadTexture(load.Textures[index], std::move(*load.Images[index]));
+					load.Images[index].reset();
+				}
+
+				if (load.UploadedCount < load.Images.size())
+				{
+					it++;
+					continue;
+				}
+
+				// Textures are in the AssetManager now, deserialization only looks them up
+				load.State = AsyncLoad::LoadState::Building;
+				AsyncLoad* target = &load;
+				jobSystem.Run("SceneManager::BuildScene", [target]()
+				{
+					// Missing or mistyped keys throw json exceptions, they must not escape the worker
+					target->LoadedScene = MakeShared<Scene>(std::string(), target->ScenePath);
+					try
+					{
+						Timer timer;
+						SceneSerializer serializer(target->LoadedScene.get());
+						serializer.Deserialize(target->Data, target->Filepath);
+						PT_CORE_INFO("scene='{}' entities={} build={:.2f}ms", target->ScenePath, target->LoadedScene->GetEntitiesCount(), timer.ElapsedMillis());
+					}
+					catch (const json::exception& e)
+					{
+						PT_CORE_ERROR("Deserializing '{}' failed: {}", target->Filepath, e.what());
+						target->Failed = true;
+					}
+					target->Data = json();
+				}, &load.Counter);
+
+				it++;
+				continue;
+			}
+
+			// Partially built scene is destroyed here, the callback gets nullptr like for a read failure
+			if (load.Failed)
+			{
+				PT_CORE_ERROR("Loading '{}' failed!", load.Filepath);
+				load.LoadedScene.reset();
+				finished.push_back(std::move(*it));
+				it = loads.erase(it);
+				continue;
+			}
+
+			// Built scene is registered, it becomes visible to the rest of the engine only here
+			Shared<Scene> scene = load.LoadedScene;
+		#ifdef PT_EDITOR
+			if (scene->GetWorldStreamer())
+				scene->GetWorldStreamer()->LoadAllCells();
+		#endif
+			s_Instance->m_Scenes[load.ScenePath] = scene;
+			finished.push_back(std::move(*it));
+			it = loads.erase(it);
+		}
+
+		// Callbacks can load or activate scenes
+		for (auto& load : finished)
+		{
+			if (load->Callback)
+				load->Callback(load->LoadedScene.get());
+		}
+	}
+
+	bool SceneManager::IsLoading(const std::string& scenePath)
+	{
+		for (auto& load : s_Instance->m_AsyncLoads)
+		{
+			if (load->ScenePath == scenePath)
+				return true;
+		}
+		return false;
+	}
+
 	void SceneManager::Unload(const std::string& scenePath)
 	{
-		Scene* scene = GetScene(scenePath);
-		if (!scene)
+		if (!IsLoaded(scenePath))
 		{
 			PT_CORE_ERROR("scene='{}' not found", scenePath);
 			return;
@@ -76,8 +278,17 @@ namespace proton {
 		std::string name = scenePath;
 		PT_CORE_INFO("scene='{}'", name);
 
-		bool isActive = scene == s_Instance->m_ActiveScene;
+		Shared<Scene> scene = s_Instance->m_Scenes.at(scenePath);
+		bool isActive = scene.get() == s_Instance->m_ActiveScene;
 		s_Instance->m_Scenes.erase(scenePath);
+
+		// Runtime bodies and editor play mode are stopped here, the registry and scripts are destroyed on a worker.
+		// Textures released with the last reference delete their GL objects on the main thread.
+		scene->Stop();
+		Application::Get().GetJobSystem().Run("SceneManager::DestroyScene", [scene]() mutable
+		{
+			scene.reset();
+		});
 		if (isActive)
 		{
 			if (s_Instance->m_Scenes.size())
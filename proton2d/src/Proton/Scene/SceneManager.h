@@ -1,13 +1,23 @@
 #pragma once
 
+#include <functional>
+
 namespace proton {
 
 	class Scene;
 
+	// Invoked on the main thread when a scene loaded by LoadAsync is ready, nullptr if loading failed
+	using SceneLoadedCallback = std::function<void(Scene*)>;
+
 	/*
 	* SceneManager class methods use scene filepaths - "scenePath" 
 	* (realative to "scenes" directory) without ".scene.json" extension
 	* as scene identifiers (keys in map storage)
+	*
+	* LoadAsync reads, parses and deserializes the scene into a detached registry on JobSystem workers
+	* while the active scene keeps running. Only texture uploads (within a per-frame time budget) and
+	* registering the loaded scene happen on the main thread. Unload stops the scene on the main thread
+	* and destroys it on a worker.
 	*/
 	class SceneManager
 	{
@@ -17,8 +27,14 @@ namespace proton {
 		static Scene* SetActiveScene(const std::string& scenePath);
 
 		static Scene* Load(const std::string& scenePath);
+		static void LoadAsync(const std::string& scenePath, SceneLoadedCallback callback = nullptr);
 		static void Unload(const std::string& scenePath);
 		static bool IsLoaded(const std::string& scenePath);
+		static bool IsLoading(const std::string& scenePath);
+
+		// Milliseconds of texture uploads per frame for scenes loaded asynchronously
+		static void SetUploadBudget(float milliseconds) { s_Instance->m_UploadBudget = milliseconds; }
+		static float GetUploadBudget() { return s_Instance->m_UploadBudget; }
 
 		static void SaveSceneAs(const std::string& scenePath, const std::string& newSenePath);
 
@@ -26,12 +42,20 @@ namespace proton {
 		static void Init();
 		static Scene* CreateEmptyScene(const std::string& scenePath = "<Unsaved scene>");
 
+		// Advances asynchronous loads, called by Application every frame
+		static void Update();
+
 	private:
+		struct AsyncLoad;
+
 		static SceneManager* s_Instance;
 
 		Scene* m_ActiveScene = nullptr;
 		std::map<std::string, Shared<Scene>> m_Scenes;
 
+		std::vector<Unique<AsyncLoad>> m_AsyncLoads;
+		float m_UploadBudget = 2.0f;
+
 		friend class Application;
 		friend class ToolbarPanel;
 
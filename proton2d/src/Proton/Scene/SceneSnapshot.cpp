@@ -0,0 +1,147 @@
+#include "ptpch.h"
+#include "Proton/Scene/SceneSnapshot.h"
+#include "Proton/Scene/Scene.h"
+#include "Proton/Scene/Components.h"
+#include "Proton/Scripting/EntityScript.h"
+#include "Proton/Scripting/ScriptFactory.h"
+#include "Proton/Scene/WorldStreamer.h"
+#include "Proton/Physics/PhysicsWorld.h"
+
+namespace proton {
+
+	template<typename TComponent>
+	struct SceneSnapshot::TypedPool : public SceneSnapshot::Pool
+	{
+		std::vector<entt::entity> Entities;
+		std::vector<TComponent> Components;
+
+		TypedPool(entt::registry& registry)
+		{
+			auto view = registry.view<TComponent>();
+			Entities.reserve(view.size());
+			Components.reserve(view.size());
+			for (auto [entity, component] : view.each())
+			{
+				Entities.push_back(entity);
+				Components.push_back(component);
+			}
+		}
+
+		virtual void Restore(entt::registry& registry) override
+		{
+			registry.insert<TComponent>(Entities.begin(), Entities.end(), std::make_move_iterator(Components.begin()));
+			Entities.clear();
+			Components.clear();
+		}
+	};
+
+	template<typename... TComponents>
+	void SceneSnapshot::CapturePools(entt::registry& registry)
+	{
+		(m_Pools.push_back(MakeUnique<TypedPool<TComponents>>(registry)), ...);
+	}
+
+	SceneSnapshot::SceneSnapshot(Scene* scene)
+		: m_Scene(scene)
+	{
+		PROFILE_FUNCTION();
+		PT_CORE_ASSERT(!scene->m_PhysicsWorld->IsInitialized(), "Snapshot of a scene with runtime bodies!");
+
+		// Every entity has an IDComponent, its pool lists all identifiers
+		entt::registry& registry = scene->m_Registry;
+		auto view = registry.view<IDComponent>();
+		m_Entities.assign(view.begin(), view.end());
+
+		CapturePools<IDComponent, TagComponent, TransformComponent, RelationshipComponent, CameraComponent,
+			SpriteComponent, CircleRendererComponent, ResizableSpriteComponent, PointLight2DComponent,
+			RigidbodyComponent, BoxColliderComponent, CircleColliderComponent, ScriptComponent, StreamingCellComponent>(registry);
+		CaptureScripts();
+
+		m_EntityMap = scene->m_EntityMap;
+		m_RootFirst = scene->m_RootFirst;
+		m_RootLast = scene->m_RootLast;
+		m_RootCount = scene->m_RootCount;
+		m_PrimaryCameraEntity = scene->m_PrimaryCameraEntity;
+
+		m_ClearColor = scene->m_ClearColor;
+		m_EnablePhysics = scene->m_EnablePhysics;
+		m_EnableLighting = scene->m_EnableLighting;
+		m_AmbientLightColor = scene->m_AmbientLightColor;
+		m_EnableSpriteLOD = scene->m_EnableSpriteLOD;
+		m_MinSpritePixelSize = scene->m_MinSpritePixelSize;
+		m_EnableSpriteMeshes = scene->m_EnableSpriteMeshes;
+	}
+
+	SceneSnapshot::~SceneSnapshot()
+	{
+		for (EntityScript* script : m_Scripts)
+			delete script;
+	}
+
+	void SceneSnapshot::CaptureScripts()
+	{
+		// The captured ScriptComponent pool holds the edited instances, the scene continues with copies
+		auto view = m_Scene->m_Registry.view<ScriptComponent>();
+		for (auto entity : view)
+		{
+			auto& component = view.get<ScriptComponent>(entity);
+			auto scripts = std::move(component.Scripts);
+			component.Scripts.clear();
+
+			for (auto& [className, original] : scripts)
+			{
+				m_Scripts.push_back(original);
+				EntityScript* script = ScriptFactory::Get().AddScriptToEntity(Entity(entity, m_Scene), className);
+				if (!script)
+					continue;
+
+				for (auto& [fieldName, fieldData] : original->m_ScriptFields)
+					script->SetFieldValueData(fieldName, fieldData.InstanceFieldValue);
+			}
+		}
+	}
+
+	void SceneSnapshot::Restore()
+	{
+		PROFILE_FUNCTION();
+
+		Scene& scene = *m_Scene;
+		scene.Clear();
+
+		// Identifiers are free after clearing the registry, they are created again as they were
+		for (entt::entity entity : m_Entities)
+		{
+			entt::entity created = scene.m_Registry.create(entity);
+			PT_CORE_ASSERT(created == entity, "Snapshot entity identifier not restored!");
+		}
+
+		for (auto& pool : m_Pools)
+			pool->Restore(scene.m_Registry);
+
+		scene.m_EntityMap = std::move(m_EntityMap);
+		scene.m_RootFirst = m_RootFirst;
+		scene.m_RootLast = m_RootLast;
+		scene.m_RootCount = m_RootCount;
+		if (m_PrimaryCameraEntity != entt::null)
+			scene.SetPrimaryCameraEntity(Entity(m_PrimaryCameraEntity, &scene));
+
+		// Cells unloaded while playing are active again
+		if (scene.m_WorldStreamer)
+			scene.m_WorldStreamer->ResetCells();
+
+		scene.m_ClearColor = m_ClearColor;
+		scene.m_EnablePhysics = m_EnablePhysics;
+		scene.m_EnableLighting = m_EnableLighting;
+		scene.m_AmbientLightColor = m_AmbientLightColor;
+		scene.m_EnableSpriteLOD = m_EnableSpriteLOD;
+		scene.m_MinSpritePixelSize = m_MinSpritePixelSize;
+		scene.m_EnableSpriteMeshes = m_EnableSpriteMeshes;
+
+		// Script instances belong to the scene again
+		m_Entities.clear();
+		m_Pools.clear();
+		m_Scripts.clear();
+		m_EntityMap.clear();
+	}
+
+}
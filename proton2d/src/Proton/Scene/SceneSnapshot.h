@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+#include "Proton/Core/UUID.h"
+#include "Proton/Scene/Entity.h"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	// Forward declaration
+	class Scene;
+	class EntityScript;
+
+	//
+	// Copy of a scene taken when play mode begins, restored when it stops.
+	// Component pools are copied in bulk together with their entity identifiers, so handles stored in
+	// components (hierarchy links, primary camera) and the UUID map stay valid without remapping.
+	// Restoring recreates the same identifiers and moves the pools back into the registry.
+	// The snapshot keeps the edited script instances, the playing scene gets copies of them.
+	// SpriteAnimationComponent is created at runtime, it is not captured.
+	//
+	class SceneSnapshot
+	{
+	public:
+		SceneSnapshot(Scene* scene);
+		virtual ~SceneSnapshot();
+
+		// Replaces the scene state with the snapshot, which is left empty
+		void Restore();
+
+	private:
+		struct Pool
+		{
+			virtual ~Pool() = default;
+			virtual void Restore(entt::registry& registry) = 0;
+		};
+
+		template<typename TComponent>
+		struct TypedPool;
+
+		template<typename... TComponents>
+		void CapturePools(entt::registry& registry);
+		void CaptureScripts();
+
+	private:
+		Scene* m_Scene = nullptr;
+
+		std::vector<entt::entity> m_Entities;
+		std::vector<Unique<Pool>> m_Pools;
+		std::vector<EntityScript*> m_Scripts; // owned until restored
+		std::unordered_map<UUID, Entity> m_EntityMap;
+		entt::entity m_RootFirst = entt::null;
+		entt::entity m_RootLast = entt::null;
+		uint32_t m_RootCount = 0;
+		entt::entity m_PrimaryCameraEntity = entt::null;
+
+		// Scene settings
+		glm::vec4 m_ClearColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+		bool m_EnablePhysics = true;
+		bool m_EnableLighting = false;
+		glm::vec4 m_AmbientLightColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+		bool m_EnableSpriteLOD = true;
+		float m_MinSpritePixelSize = 1.0f;
+		bool m_EnableSpriteMeshes = false;
+	};
+
+}
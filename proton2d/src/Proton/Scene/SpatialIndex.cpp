@@ -0,0 +1,290 @@
+#include "ptpch.h"
+#include "Proton/Scene/SpatialIndex.h"
+#include "Proton/Scene/Scene.h"
+#include "Proton/Scene/Entity.h"
+
+#include <box2d/b2_dynamic_tree.h>
+
+namespace proton {
+
+	// Adapters for the callback objects expected by b2DynamicTree
+	template<typename TFunction>
+	struct TreeQueryCallback
+	{
+		TFunction Function;
+		bool QueryCallback(int32 proxyID) { return Function(proxyID); }
+	};
+
+	template<typename TFunction>
+	struct TreeRayCastCallback
+	{
+		TFunction Function;
+		float RayCastCallback(const b2RayCastInput& input, int32 proxyID) { return Function(input, proxyID); }
+	};
+
+	template<typename TFunction>
+	static void QueryTree(const b2DynamicTree& tree, const glm::vec2& min, const glm::vec2& max, TFunction function)
+	{
+		b2AABB aabb;
+		aabb.lowerBound.Set(min.x, min.y);
+		aabb.upperBound.Set(max.x, max.y);
+		TreeQueryCallback<TFunction> callback{ function };
+		tree.Query(&callback, aabb);
+	}
+
+	template<typename TFunction>
+	static void RayCastTree(const b2DynamicTree& tree, const glm::vec2& from, const glm::vec2& to, TFunction function)
+	{
+		b2RayCastInput input;
+		input.p1.Set(from.x, from.y);
+		input.p2.Set(to.x, to.y);
+		input.maxFraction = 1.0f;
+		TreeRayCastCallback<TFunction> callback{ function };
+		tree.RayCast(&callback, input);
+	}
+
+	static entt::entity GetProxyEntity(const b2DynamicTree& tree, int32 proxyID)
+	{
+		return (entt::entity)(uintptr_t)tree.GetUserData(proxyID);
+	}
+
+	SpatialIndex::SpatialIndex(Scene* context)
+		: m_Scene(context), m_Tree(MakeUnique<b2DynamicTree>())
+	{
+		m_Scene->m_Registry.on_destroy<TransformComponent>().connect<&SpatialIndex::OnTransformDestroyed>(this);
+	}
+
+	SpatialIndex::~SpatialIndex()
+	{
+		m_Scene->m_Registry.on_destroy<TransformComponent>().disconnect(this);
+	}
+
+	void SpatialIndex::Update(const std::vector<entt::entity>& changedEntities)
+	{
+		PROFILE_FUNCTION();
+
+		entt::registry& registry = m_Scene->m_Registry;
+		for (entt::entity entity : changedEntities)
+		{
+			if (!registry.valid(entity))
+				continue;
+
+			uint32_t index = (uint32_t)entt::to_entity(entity);
+			if (index >= m_Proxies.size())
+				m_Proxies.resize(index + 1);
+
+			auto& transform = registry.get<TransformComponent>(entity);
+			Proxy& proxy = m_Proxies[index];
+			glm::vec2 previousCenter = proxy.Center;
+			float radians = glm::radians(transform.WorldRotation);
+			proxy.Center = glm::vec2(transform.WorldPosition);
+			proxy.HalfSize = glm::abs(transform.Scale) * 0.5f;
+			proxy.Axis = { glm::cos(radians), glm::sin(radians) };
+
+			// Bounding box of the rotated rectangle
+			glm::vec2 axis = glm::abs(proxy.Axis);
+			glm::vec2 extents = {
+				axis.x * proxy.HalfSize.x + axis.y * proxy.HalfSize.y,
+				axis.y * proxy.HalfSize.x + axis.x * proxy.HalfSize.y
+			};
+			b2AABB aabb;
+			aabb.lowerBound.Set(proxy.Center.x - extents.x, proxy.Center.y - extents.y);
+			aabb.upperBound.Set(proxy.Center.x + extents.x, proxy.Center.y + extents.y);
+
+			if (proxy.ID == -1)
+			{
+				proxy.ID = m_Tree->CreateProxy(aabb, (void*)(uintptr_t)entity);
+				m_ProxiesCount++;
+			}
+			else
+			{
+				// Tree nodes are fattened, small moves inside of them do not touch the tree
+				glm::vec2 displacement = proxy.Center - previousCenter;
+				m_Tree->MoveProxy(proxy.ID, aabb, { displacement.x, displacement.y });
+			}
+		}
+	}
+
+	void SpatialIndex::Clear()
+	{
+		m_Tree = MakeUnique<b2DynamicTree>();
+		m_Proxies.clear();
+		m_ProxiesCount = 0;
+	}
+
+	void SpatialIndex::OnTransformDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Proxies.size() || m_Proxies[index].ID == -1)
+			return;
+
+		m_Tree->DestroyProxy(m_Proxies[index].ID);
+		m_Proxies[index] = Proxy();
+		m_ProxiesCount--;
+	}
+
+	const SpatialIndex::Proxy* SpatialIndex::GetProxy(entt::entity entity) const
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Proxies.size() || m_Proxies[index].ID == -1)
+			return nullptr;
+		return &m_Proxies[index];
+	}
+
+	bool SpatialIndex::Contains(const Proxy& proxy, const glm::vec2& point)
+	{
+		// Point in the space of the rectangle
+		glm::vec2 d = point - proxy.Center;
+		glm::vec2 local = { d.x * proxy.Axis.x + d.y * proxy.Axis.y, d.y * proxy.Axis.x - d.x * proxy.Axis.y };
+		return glm::abs(local.x) <= proxy.HalfSize.x && glm::abs(local.y) <= proxy.HalfSize.y;
+	}
+
+	bool SpatialIndex::Raycast(const Proxy& proxy, const glm::vec2& from, const glm::vec2& to, float& fraction)
+	{
+		// Slab test in the space of the rectangle
+		glm::vec2 d = from - proxy.Center;
+		glm::vec2 origin = { d.x * proxy.Axis.x + d.y * proxy.Axis.y, d.y * proxy.Axis.x - d.x * proxy.Axis.y };
+		glm::vec2 ray = to - from;
+		glm::vec2 direction = { ray.x * proxy.Axis.x + ray.y * proxy.Axis.y, ray.y * proxy.Axis.x - ray.x * proxy.Axis.y };
+
+		float tMin = 0.0f, tMax = 1.0f;
+		for (int i = 0; i < 2; i++)
+		{
+			if (glm::abs(direction[i]) < 1e-8f)
+			{
+				if (glm::abs(origin[i]) > proxy.HalfSize[i])
+					return false;
+				continue;
+			}
+
+			float t1 = (-proxy.HalfSize[i] - origin[i]) / direction[i];
+			float t2 = (proxy.HalfSize[i] - origin[i]) / direction[i];
+			tMin = glm::max(tMin, glm::min(t1, t2));
+			tMax = glm::min(tMax, glm::max(t1, t2));
+			if (tMin > tMax)
+				return false;
+		}
+
+		fraction = tMin;
+		return true;
+	}
+
+	bool SpatialIndex::Contains(entt::entity entity, const glm::vec2& point) const
+	{
+		const Proxy* proxy = GetProxy(entity);
+		return proxy && Contains(*proxy, point);
+	}
+
+	uint32_t SpatialIndex::QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<Entity>& out) const
+	{
+		PROFILE_FUNCTION();
+
+		uint32_t count = 0;
+		QueryTree(*m_Tree, min, max, [&](int32 proxyID)
+		{
+			// Tree nodes are fattened, test the exact bounding box
+			entt::entity entity = GetProxyEntity(*m_Tree, proxyID);
+			const Proxy& proxy = *GetProxy(entity);
+			glm::vec2 axis = glm::abs(proxy.Axis);
+			glm::vec2 extents = {
+				axis.x * proxy.HalfSize.x + axis.y * proxy.HalfSize.y,
+				axis.y * proxy.HalfSize.x + axis.x * proxy.HalfSize.y
+			};
+			if (proxy.Center.x + extents.x >= min.x && proxy.Center.x - extents.x <= max.x
+				&& proxy.Center.y + extents.y >= min.y && proxy.Center.y - extents.y <= max.y)
+			{
+				out.emplace_back(entity, m_Scene);
+				count++;
+			}
+			return true;
+		});
+		return count;
+	}
+
+	uint32_t SpatialIndex::QueryRadius(const glm::vec2& center, float radius, std::vector<Entity>& out) const
+	{
+		PROFILE_FUNCTION();
+
+		uint32_t count = 0;
+		QueryTree(*m_Tree, center - radius, center + radius, [&](int32 proxyID)
+		{
+			entt::entity entity = GetProxyEntity(*m_Tree, proxyID);
+			const Proxy& proxy = *GetProxy(entity);
+
+			// Closest point of the rectangle to the center, in the space of the rectangle
+			glm::vec2 d = center - proxy.Center;
+			glm::vec2 local = { d.x * proxy.Axis.x + d.y * proxy.Axis.y, d.y * proxy.Axis.x - d.x * proxy.Axis.y };
+			glm::vec2 offset = local - glm::clamp(local, -proxy.HalfSize, proxy.HalfSize);
+			if (glm::dot(offset, offset) <= radius * radius)
+			{
+				out.emplace_back(entity, m_Scene);
+				count++;
+			}
+			return true;
+		});
+		return count;
+	}
+
+	uint32_t SpatialIndex::QueryPoint(const glm::vec2& point, std::vector<Entity>& out) const
+	{
+		PROFILE_FUNCTION();
+
+		uint32_t count = 0;
+		QueryTree(*m_Tree, point, point, [&](int32 proxyID)
+		{
+			entt::entity entity = GetProxyEntity(*m_Tree, proxyID);
+			if (Contains(*GetProxy(entity), point))
+			{
+				out.emplace_back(entity, m_Scene);
+				count++;
+			}
+			return true;
+		});
+		return count;
+	}
+
+	uint32_t SpatialIndex::QueryRay(const glm::vec2& from, const glm::vec2& to, std::vector<RaycastHit>& out) const
+	{
+		PROFILE_FUNCTION();
+
+		if (from == to)
+			return 0;
+
+		uint32_t count = 0;
+		RayCastTree(*m_Tree, from, to, [&](const b2RayCastInput& input, int32 proxyID)
+		{
+			entt::entity entity = GetProxyEntity(*m_Tree, proxyID);
+			float fraction;
+			if (Raycast(*GetProxy(entity), from, to, fraction))
+			{
+				out.push_back({ entity, from + (to - from) * fraction, fraction });
+				count++;
+			}
+			return input.maxFraction; // keep the ray length, all hits are collected
+		});
+		return count;
+	}
+
+	bool SpatialIndex::RaycastClosest(const glm::vec2& from, const glm::vec2& to, RaycastHit& hit) const
+	{
+		PROFILE_FUNCTION();
+
+		if (from == to)
+			return false;
+
+		bool found = false;
+		RayCastTree(*m_Tree, from, to, [&](const b2RayCastInput& input, int32 proxyID)
+		{
+			entt::entity entity = GetProxyEntity(*m_Tree, proxyID);
+			float fraction;
+			if (!Raycast(*GetProxy(entity), from, to, fraction) || fraction > input.maxFraction)
+				return input.maxFraction;
+
+			hit = { entity, from + (to - from) * fraction, fraction };
+			found = true;
+			return fraction; // clip the ray, only closer hits are reported from now on
+		});
+		return found;
+	}
+
+}
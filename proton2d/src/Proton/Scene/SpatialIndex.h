@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+class b2DynamicTree;
+
+namespace proton {
+
+	// Forward declaration
+	class Scene;
+	class Entity;
+
+	struct RaycastHit
+	{
+		entt::entity Target = entt::null;
+		glm::vec2 Point = { 0.0f, 0.0f };
+		float Fraction = 0.0f; // along the ray, 0 at its start and 1 at its end
+	};
+
+	//
+	// Spatial index of scene entities for gameplay queries, independent of physics.
+	// Bounds of an entity are its transform rectangle (world position, rotation and scale) stored in a
+	// dynamic AABB tree (Box2D b2DynamicTree). Only entities whose world transform changed are reinserted,
+	// from the list reported by the TransformHierarchy, so queries see transforms of the last hierarchy update.
+	// Results are appended to caller buffers, reusing them between calls keeps queries allocation free.
+	//
+	class SpatialIndex
+	{
+	public:
+		SpatialIndex(Scene* context);
+		virtual ~SpatialIndex();
+
+		// Entities whose bounding box overlaps the rectangle
+		uint32_t QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<Entity>& out) const;
+		// Entities whose rectangle intersects the circle
+		uint32_t QueryRadius(const glm::vec2& center, float radius, std::vector<Entity>& out) const;
+		// Entities whose rectangle contains the point
+		uint32_t QueryPoint(const glm::vec2& point, std::vector<Entity>& out) const;
+		// Entities hit by the segment from -> to, in no particular order
+		uint32_t QueryRay(const glm::vec2& from, const glm::vec2& to, std::vector<RaycastHit>& out) const;
+		// Closest entity hit by the segment from -> to
+		bool RaycastClosest(const glm::vec2& from, const glm::vec2& to, RaycastHit& hit) const;
+
+		bool Contains(entt::entity entity, const glm::vec2& point) const;
+
+		uint32_t GetProxiesCount() const { return m_ProxiesCount; }
+
+	private:
+		struct Proxy
+		{
+			int32_t ID = -1; // b2DynamicTree proxy
+			glm::vec2 Center = { 0.0f, 0.0f };
+			glm::vec2 HalfSize = { 0.0f, 0.0f };
+			glm::vec2 Axis = { 1.0f, 0.0f }; // cos, sin of the world rotation
+		};
+
+		// Reinsert entities whose transform changed, called after every transform hierarchy update
+		void Update(const std::vector<entt::entity>& changedEntities);
+		void Clear();
+
+		const Proxy* GetProxy(entt::entity entity) const;
+		static bool Contains(const Proxy& proxy, const glm::vec2& point);
+		static bool Raycast(const Proxy& proxy, const glm::vec2& from, const glm::vec2& to, float& fraction);
+
+		void OnTransformDestroyed(entt::registry& registry, entt::entity entity);
+
+	private:
+		Scene* m_Scene = nullptr;
+		Unique<b2DynamicTree> m_Tree;
+		std::vector<Proxy> m_Proxies; // by entity index
+		uint32_t m_ProxiesCount = 0;
+
+		friend class Scene;
+	};
+
+}
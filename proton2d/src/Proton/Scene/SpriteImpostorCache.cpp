@@ -0,0 +1,251 @@
+#include "ptpch.h"
+#include "Proton/Scene/SpriteImpostorCache.h"
+#include "Proton/Scene/Scene.h"
+#include "Proton/Scene/Components.h"
+#include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Graphics/Renderer/Texture.h"
+#include "Proton/Utils/Utils.h"
+
+namespace proton {
+
+	static const TextureCoords s_ImpostorTextureCoords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+
+	static glm::ivec2 GetChunkCoords(const glm::vec2& position)
+	{
+		return glm::ivec2(glm::floor(position / SpriteImpostorCache::ChunkSize));
+	}
+
+	template<typename T>
+	static void HashCombine(size_t& seed, const T& value)
+	{
+		seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+	size_t SpriteImpostorCache::ChunkKeyHash::operator()(const ChunkKey& key) const
+	{
+		size_t hash = 0;
+		HashCombine(hash, key.Coords.x);
+		HashCombine(hash, key.Coords.y);
+		HashCombine(hash, key.Depth);
+		return hash;
+	}
+
+	SpriteImpostorCache::ChunkKey SpriteImpostorCache::GetChunkKey(const glm::vec3& position)
+	{
+		return { GetChunkCoords(glm::vec2(position)), position.z };
+	}
+
+	SpriteImpostorCache::SpriteImpostorCache(Scene* context)
+		: m_Scene(context)
+	{
+		// Changes in these components can make chunk membership stale
+		entt::registry& registry = m_Scene->m_Registry;
+		registry.on_construct<SpriteComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_destroy<SpriteComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_construct<ScriptComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_destroy<ScriptComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_construct<RigidbodyComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_destroy<RigidbodyComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_construct<SpriteAnimationComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+		registry.on_destroy<SpriteAnimationComponent>().connect<&SpriteImpostorCache::OnSpritesChanged>(this);
+
+		// Edited sprites invalidate only their chunk
+		registry.on_update<SpriteComponent>().connect<&SpriteImpostorCache::OnSpriteUpdated>(this);
+	}
+
+	SpriteImpostorCache::~SpriteImpostorCache()
+	{
+		entt::registry& registry = m_Scene->m_Registry;
+		registry.on_construct<SpriteComponent>().disconnect(this);
+		registry.on_destroy<SpriteComponent>().disconnect(this);
+		registry.on_construct<ScriptComponent>().disconnect(this);
+		registry.on_destroy<ScriptComponent>().disconnect(this);
+		registry.on_construct<RigidbodyComponent>().disconnect(this);
+		registry.on_destroy<RigidbodyComponent>().disconnect(this);
+		registry.on_construct<SpriteAnimationComponent>().disconnect(this);
+		registry.on_destroy<SpriteAnimationComponent>().disconnect(this);
+		registry.on_update<SpriteComponent>().disconnect(this);
+	}
+
+	void SpriteImpostorCache::OnSpriteUpdated(entt::registry& registry, entt::entity entity)
+	{
+		// Also called by parallel scripts, chunks are only looked up
+		auto it = m_SpriteChunks.find(entity);
+		if (it == m_SpriteChunks.end())
+			return;
+
+		auto chunk = m_Chunks.find(it->second);
+		if (chunk != m_Chunks.end())
+			chunk->second.Valid = false;
+	}
+
+	void SpriteImpostorCache::OnTransformsChanged(const std::vector<entt::entity>& entities)
+	{
+		if (m_ChunksDirty || m_SpriteChunks.empty())
+			return;
+
+		const entt::registry& registry = m_Scene->m_Registry;
+		for (entt::entity entity : entities)
+		{
+			auto it = m_SpriteChunks.find(entity);
+			if (it == m_SpriteChunks.end())
+				continue;
+
+			const ChunkKey& key = it->second;
+			if (GetChunkKey(registry.get<TransformComponent>(entity).WorldPosition) != key)
+			{
+				m_ChunksDirty = true;
+				return;
+			}
+			m_Chunks[key].Valid = false;
+		}
+	}
+
+	bool SpriteImpostorCache::IsStatic(entt::entity entity) const
+	{
+		const entt::registry& registry = m_Scene->m_Registry;
+		while (entity != entt::null)
+		{
+			if (registry.any_of<ScriptComponent, SpriteAnimationComponent>(entity))
+				return false;
+
+			auto rigidbody = registry.try_get<RigidbodyComponent>(entity);
+			if (rigidbody && rigidbody->Type != b2_staticBody)
+				return false;
+
+			auto relationship = registry.try_get<RelationshipComponent>(entity);
+			entity = relationship ? relationship->Parent : entt::null;
+		}
+		return true;
+	}
+
+	void SpriteImpostorCache::RebuildChunks()
+	{
+		PROFILE_FUNCTION();
+		for (auto& [key, chunk] : m_Chunks)
+		{
+			chunk.PreviousSprites.swap(chunk.Sprites);
+			chunk.Sprites.clear();
+		}
+		m_SpriteChunks.clear();
+		m_DynamicSprites.clear();
+
+		auto group = m_Scene->m_Registry.group<TransformComponent, SpriteComponent>();
+		for (auto entity : group)
+		{
+			if (!IsStatic(entity))
+			{
+				m_DynamicSprites.push_back(entity);
+				continue;
+			}
+
+			auto& transform = group.get<TransformComponent>(entity);
+			ChunkKey key = GetChunkKey(transform.WorldPosition);
+			m_Chunks[key].Sprites.push_back(entity);
+			m_SpriteChunks.emplace(entity, key);
+		}
+
+		// Chunks keep their impostor, those with unchanged sprites (same entities in the same order) are not regenerated
+		for (auto it = m_Chunks.begin(); it != m_Chunks.end();)
+		{
+			Chunk& chunk = it->second;
+			if (chunk.Sprites.empty())
+			{
+				it = m_Chunks.erase(it);
+				continue;
+			}
+
+			if (chunk.Sprites != chunk.PreviousSprites)
+				chunk.Valid = false;
+			chunk.PreviousSprites.clear();
+			++it;
+		}
+
+		m_ChunksDirty = false;
+	}
+
+	void SpriteImpostorCache::Update(const glm::vec2& viewMin, const glm::vec2& viewMax)
+	{
+		PROFILE_FUNCTION();
+		if (m_ChunksDirty)
+			RebuildChunks();
+
+		// Sprites crossing chunk borders by up to the padding are visible from the neighbouring cells
+		m_ViewMinCoords = GetChunkCoords(viewMin - ChunkPadding);
+		m_ViewMaxCoords = GetChunkCoords(viewMax + ChunkPadding);
+		uint32_t impostorUpdates = 0;
+
+		// Regeneration is spread over frames, stale chunks draw their sprites meanwhile
+		for (auto& [key, chunk] : m_Chunks)
+		{
+			if (impostorUpdates == MaxImpostorUpdatesPerFrame)
+				break;
+
+			if (!chunk.Valid && IsChunkVisible(key))
+			{
+				RenderImpostor(key, chunk);
+				impostorUpdates++;
+			}
+		}
+	}
+
+	bool SpriteImpostorCache::IsChunkVisible(const ChunkKey& key) const
+	{
+		const glm::ivec2& coords = key.Coords;
+		return coords.x >= m_ViewMinCoords.x && coords.y >= m_ViewMinCoords.y && coords.x <= m_ViewMaxCoords.x && coords.y <= m_ViewMaxCoords.y;
+	}
+
+	void SpriteImpostorCache::RenderImpostor(const ChunkKey& key, Chunk& chunk)
+	{
+		PROFILE_FUNCTION();
+		if (!chunk.Impostor)
+		{
+			chunk.Impostor = MakeShared<Texture>(ChunkResolution, ChunkResolution);
+			chunk.Impostor->SetFilterMode(TextureFilterMode::Linear);
+			chunk.Impostor->SetWrapMode(TextureWrapMode::ClampToEdge);
+		}
+
+		glm::vec2 chunkMin = glm::vec2(key.Coords) * ChunkSize - ChunkPadding;
+		glm::vec2 chunkMax = chunkMin + ChunkSize + 2.0f * ChunkPadding;
+
+		Renderer::BeginRenderToTexture(chunk.Impostor, chunkMin, chunkMax);
+		entt::registry& registry = m_Scene->m_Registry;
+		for (entt::entity entity : chunk.Sprites)
+		{
+			auto [transform, sprite] = registry.get<TransformComponent, SpriteComponent>(entity);
+			Scene::DrawSprite(transform, sprite);
+		}
+		Renderer::EndRenderToTexture();
+
+		chunk.Valid = true;
+	}
+
+	void SpriteImpostorCache::Draw(std::vector<entt::entity>& outSprites)
+	{
+		PROFILE_FUNCTION();
+		m_DrawnImpostors = 0;
+		for (auto& [key, chunk] : m_Chunks)
+		{
+			if (!IsChunkVisible(key))
+				continue;
+
+			if (!chunk.Valid)
+			{
+				outSprites.insert(outSprites.end(), chunk.Sprites.begin(), chunk.Sprites.end());
+				continue;
+			}
+
+			// Render target color is already multiplied by alpha
+			Renderer::SetBlendMode(RendererBlendMode::Premultiplied);
+
+			glm::vec2 center = (glm::vec2(key.Coords) + 0.5f) * ChunkSize;
+			glm::mat4 transform = Math::GetTransform({ center, key.Depth }, glm::vec2(ChunkSize + 2.0f * ChunkPadding), 0.0f);
+			Renderer::DrawQuad(transform, chunk.Impostor, s_ImpostorTextureCoords, glm::vec4(1.0f));
+			m_DrawnImpostors++;
+		}
+		Renderer::SetBlendMode(RendererBlendMode::Alpha);
+
+		outSprites.insert(outSprites.end(), m_DynamicSprites.begin(), m_DynamicSprites.end());
+	}
+
+}
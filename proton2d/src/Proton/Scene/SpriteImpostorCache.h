@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	// Forward declaration
+	class Scene;
+	class Texture;
+
+	//
+	// Zoom dependent level of detail for sprites.
+	// Static sprites (no script, sprite animation or non-static rigidbody in their hierarchy) are grouped
+	// into world space chunks, each rendered into a low resolution impostor texture. When the camera is
+	// zoomed out far enough, a single quad per chunk is drawn instead of all of its sprites.
+	// Sprites at different depths never share a chunk, so dynamic sprites sort against impostors exactly
+	// like against the sprites they replace.
+	// Impostors are regenerated lazily, only when the content of a chunk changes: chunks are invalidated by
+	// world transform changes (TransformHierarchy), SpriteComponent updates (registry patch, Entity::MarkSpriteDirty)
+	// and membership changes (sprites, scripts, animations or rigidbodies added or removed, reparenting).
+	// Direct writes to the SpriteComponent of a static sprite are not visible in its impostor without a patch.
+	//
+	class SpriteImpostorCache
+	{
+	public:
+		static constexpr float ChunkSize = 16.0f;        // world units
+		static constexpr float ChunkPadding = 2.0f;      // world units, sprites crossing chunk borders are not clipped
+		static constexpr uint32_t ChunkResolution = 128; // pixels
+		static constexpr uint32_t MaxImpostorUpdatesPerFrame = 8;
+
+		// Impostors replace sprites once a world unit covers fewer screen pixels than impostor texels
+		static constexpr float PixelsPerUnitThreshold = ChunkResolution / (ChunkSize + 2.0f * ChunkPadding);
+
+		SpriteImpostorCache(Scene* context);
+		virtual ~SpriteImpostorCache();
+
+		uint32_t GetChunksCount() const { return (uint32_t)m_Chunks.size(); }
+		uint32_t GetDrawnImpostorsCount() const { return m_DrawnImpostors; }
+
+		// Entity reparented, static state of its subtree may have changed
+		void Invalidate() { m_ChunksDirty = true; }
+
+	private:
+		// World space cell and depth (z) of the sprites in a chunk
+		struct ChunkKey
+		{
+			glm::ivec2 Coords;
+			float Depth;
+
+			bool operator==(const ChunkKey& other) const { return Coords == other.Coords && Depth == other.Depth; }
+			bool operator!=(const ChunkKey& other) const { return !(*this == other); }
+		};
+
+		struct ChunkKeyHash
+		{
+			size_t operator()(const ChunkKey& key) const;
+		};
+
+		struct Chunk
+		{
+			std::vector<entt::entity> Sprites;
+			std::vector<entt::entity> PreviousSprites; // membership before the last rebuild
+			Shared<Texture> Impostor;
+			bool Valid = false;
+		};
+
+		// Validate chunks inside the view and regenerate stale impostors.
+		// Must be called before frame batch recording (see Renderer::BeginFrameBatch).
+		void Update(const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+		// Draw impostors of up-to-date chunks inside the view of the last update. Sprites of visible chunks
+		// without a valid impostor and dynamic sprites have to be drawn individually and are appended to outSprites.
+		void Draw(std::vector<entt::entity>& outSprites);
+
+		// Chunks of moved sprites are invalidated, sprites moved to another cell or depth rebuild the chunks
+		void OnTransformsChanged(const std::vector<entt::entity>& entities);
+
+		void RebuildChunks();
+		bool IsStatic(entt::entity entity) const;
+		void RenderImpostor(const ChunkKey& key, Chunk& chunk);
+		bool IsChunkVisible(const ChunkKey& key) const;
+
+		static ChunkKey GetChunkKey(const glm::vec3& position);
+
+		void OnSpritesChanged(entt::registry& registry, entt::entity entity) { m_ChunksDirty = true; }
+		void OnSpriteUpdated(entt::registry& registry, entt::entity entity);
+
+	private:
+		Scene* m_Scene = nullptr;
+
+		std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> m_Chunks;
+		std::unordered_map<entt::entity, ChunkKey> m_SpriteChunks; // chunk of every static sprite
+		std::vector<entt::entity> m_DynamicSprites;
+		glm::ivec2 m_ViewMinCoords = { 0, 0 };
+		glm::ivec2 m_ViewMaxCoords = { -1, -1 };
+		bool m_ChunksDirty = true;
+		uint32_t m_DrawnImpostors = 0;
+
+		friend class Scene;
+	};
+
+}
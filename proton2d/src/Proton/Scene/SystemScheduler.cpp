@@ -0,0 +1,157 @@
+#include "ptpch.h"
+#include "Proton/Scene/SystemScheduler.h"
+#include "Proton/Core/Application.h"
+#include "Proton/Core/JobSystem.h"
+
+namespace proton {
+
+	static bool HasCommonType(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b)
+	{
+		for (entt::id_type type : a)
+		{
+			if (std::find(b.begin(), b.end(), type) != b.end())
+				return true;
+		}
+		return false;
+	}
+
+	bool SystemScheduler::System::ConflictsWith(const System& other) const
+	{
+		if (m_Exclusive || other.m_Exclusive)
+			return true;
+
+		// Both would run on the main thread anyway, registration order is kept
+		if (m_MainThread && other.m_MainThread)
+			return true;
+
+		return HasCommonType(m_Writes, other.m_Writes)
+			|| HasCommonType(m_Writes, other.m_Reads)
+			|| HasCommonType(m_Reads, other.m_Writes);
+	}
+
+	SystemScheduler::SystemScheduler(entt::registry& registry)
+		: m_Registry(registry)
+	{
+	}
+
+	SystemScheduler::System& SystemScheduler::AddSystem(const std::string& name, SystemFunction function, const std::string& insertBefore)
+	{
+		PT_CORE_ASSERT(!GetSystem(name), "System already registered!");
+
+		auto system = MakeUnique<System>();
+		system->m_Registry = &m_Registry;
+		system->m_Name = name;
+		system->m_Function = std::move(function);
+		System& result = *system;
+
+		auto it = m_Systems.end();
+		if (insertBefore.size())
+		{
+			it = std::find_if(m_Systems.begin(), m_Systems.end(), [&](const Unique<System>& other) { return other->m_Name == insertBefore; });
+			if (it == m_Systems.end())
+				PT_CORE_WARN("System '{}' not found, '{}' is added after all systems", insertBefore, name);
+		}
+		m_Systems.insert(it, std::move(system));
+		return result;
+	}
+
+	void SystemScheduler::RemoveSystem(const std::string& name)
+	{
+		auto it = std::find_if(m_Systems.begin(), m_Systems.end(), [&](const Unique<System>& system) { return system->m_Name == name; });
+		if (it != m_Systems.end())
+			m_Systems.erase(it);
+	}
+
+	SystemScheduler::System* SystemScheduler::GetSystem(const std::string& name)
+	{
+		for (auto& system : m_Systems)
+		{
+			if (system->m_Name == name)
+				return system.get();
+		}
+		return nullptr;
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		PROFILE_FUNCTION();
+
+		m_NodesCount = 0;
+		for (auto& system : m_Systems)
+		{
+			if (system->m_Condition && !system->m_Condition())
+				continue;
+
+			if (m_NodesCount == m_Nodes.size())
+				m_Nodes.push_back(MakeUnique<Node>());
+
+			Node& node = *m_Nodes[m_NodesCount++];
+			node.Target = system.get();
+			node.Successors.clear();
+			node.PredecessorsCount = 0;
+		}
+
+		// Edges only point to later systems, conflicting systems keep their registration order
+		for (uint32_t i = 0; i < m_NodesCount; i++)
+		{
+			Node& node = *m_Nodes[i];
+			for (uint32_t j = i + 1; j < m_NodesCount; j++)
+			{
+				Node& later = *m_Nodes[j];
+				if (!node.Target->ConflictsWith(*later.Target))
+					continue;
+
+				node.Successors.push_back(j);
+				later.PredecessorsCount++;
+			}
+		}
+
+		for (uint32_t i = 0; i < m_NodesCount; i++)
+			m_Nodes[i]->PendingPredecessors.store(m_Nodes[i]->PredecessorsCount, std::memory_order_relaxed);
+	}
+
+	void SystemScheduler::Schedule(JobSystem& jobSystem, JobCounter& counter, uint32_t nodeIndex)
+	{
+		Node& node = *m_Nodes[nodeIndex];
+		auto job = [this, &jobSystem, &counter, &node]()
+		{
+			node.Target->m_Function(m_Timestep);
+
+			// Successors are counted before this job finishes, the frame counter cannot reach 0 in between
+			for (uint32_t successor : node.Successors)
+			{
+				if (m_Nodes[successor]->PendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					Schedule(jobSystem, counter, successor);
+			}
+		};
+
+		if (node.Target->m_MainThread)
+			jobSystem.RunOnMainThread(node.Target->m_Name.c_str(), std::move(job), &counter);
+		else
+			jobSystem.Run(node.Target->m_Name.c_str(), std::move(job), &counter);
+	}
+
+	void SystemScheduler::Run(float ts)
+	{
+		PROFILE_FUNCTION();
+
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		PT_CORE_ASSERT(jobSystem.IsMainThread(), "Systems have to be run from the main thread!");
+
+		BuildGraph();
+		if (!m_NodesCount)
+			return;
+
+		m_Timestep = ts;
+		JobCounter counter;
+		for (uint32_t i = 0; i < m_NodesCount; i++)
+		{
+			if (m_Nodes[i]->PredecessorsCount == 0)
+				Schedule(jobSystem, counter, i);
+		}
+
+		// Main thread systems are executed here
+		jobSystem.Wait(counter);
+	}
+
+}
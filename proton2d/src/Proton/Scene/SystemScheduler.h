@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <atomic>
+#include <functional>
+
+#include <entt/entt.hpp>
+
+namespace proton {
+
+	// Forward declaration
+	class JobSystem;
+	struct JobCounter;
+
+	//
+	// Scheduler of scene systems.
+	// Every system declares the component types it reads and writes. Each frame the enabled systems are
+	// ordered into a dependency graph: a system depends on every system registered before it that accesses
+	// one of its components with at least one write. Systems without a path between them run concurrently
+	// on the JobSystem, every system is a job named after it in the profiler trace.
+	// Exclusive systems (structural changes, unknown access) depend on all systems before and after them.
+	// Main thread systems (GL calls) run on the main thread while it waits for the frame schedule.
+	// Storage of every declared component is created on declaration, so concurrent systems never insert
+	// pools into the registry (view/get on a non-const registry creates missing pools).
+	//
+	class SystemScheduler
+	{
+	public:
+		using SystemFunction = std::function<void(float)>;
+
+		SystemScheduler(entt::registry& registry);
+
+		class System
+		{
+		public:
+			template<typename... TComponents>
+			System& Read()
+			{
+				(m_Registry->storage<TComponents>(), ...);
+				(m_Reads.push_back(entt::type_hash<TComponents>::value()), ...);
+				return *this;
+			}
+
+			template<typename... TComponents>
+			System& Write()
+			{
+				(m_Registry->storage<TComponents>(), ...);
+				(m_Writes.push_back(entt::type_hash<TComponents>::value()), ...);
+				return *this;
+			}
+
+			System& Exclusive() { m_Exclusive = true; return *this; }
+			System& MainThread() { m_MainThread = true; return *this; }
+
+			// Evaluated once per frame on the main thread, a skipped system does not order the others
+			System& RunIf(std::function<bool()> condition) { m_Condition = std::move(condition); return *this; }
+
+			const std::string& GetName() const { return m_Name; }
+
+		private:
+			bool ConflictsWith(const System& other) const;
+
+		private:
+			entt::registry* m_Registry = nullptr;
+			std::string m_Name;
+			SystemFunction m_Function;
+			std::function<bool()> m_Condition;
+			std::vector<entt::id_type> m_Reads;
+			std::vector<entt::id_type> m_Writes;
+			bool m_Exclusive = false;
+			bool m_MainThread = false;
+
+			friend class SystemScheduler;
+		};
+
+		// Systems are ordered by registration, insertBefore places the system before an already registered one
+		System& AddSystem(const std::string& name, SystemFunction function, const std::string& insertBefore = "");
+		void RemoveSystem(const std::string& name);
+		System* GetSystem(const std::string& name);
+
+		// Main thread only, returns when all systems of the frame are done
+		void Run(float ts);
+
+		uint32_t GetSystemsCount() const { return (uint32_t)m_Systems.size(); }
+
+	private:
+		struct Node
+		{
+			System* Target = nullptr;
+			std::vector<uint32_t> Successors;
+			uint32_t PredecessorsCount = 0;
+			std::atomic<uint32_t> PendingPredecessors = 0; // scheduled when it reaches 0
+		};
+
+		void BuildGraph();
+		void Schedule(JobSystem& jobSystem, JobCounter& counter, uint32_t nodeIndex);
+
+	private:
+		entt::registry& m_Registry;
+		std::vector<Unique<System>> m_Systems;
+
+		// Graph of the current frame, nodes are kept between frames to reuse their storage
+		std::vector<Unique<Node>> m_Nodes;
+		uint32_t m_NodesCount = 0;
+		float m_Timestep = 0.0f;
+	};
+
+}
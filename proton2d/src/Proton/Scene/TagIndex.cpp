@@ -0,0 +1,123 @@
+#include "ptpch.h"
+#include "Proton/Scene/TagIndex.h"
+#include "Proton/Scene/Components.h"
+
+namespace proton {
+
+	static const std::vector<entt::entity> s_NoEntities;
+
+	TagSymbol TagIndex::Intern(const std::string& tag)
+	{
+		TagSymbol symbol = Find(tag);
+		if (symbol != InvalidSymbol)
+			return symbol;
+
+		// Another thread may have interned the tag in between
+		std::unique_lock<std::shared_mutex> lock(s_SymbolsMutex);
+		auto it = s_Symbols.find(tag);
+		if (it != s_Symbols.end())
+			return it->second;
+
+		symbol = (TagSymbol)s_Symbols.size() + 1;
+		s_Symbols.emplace(tag, symbol);
+
+		// Symbols are never released, a steadily growing table means tags are generated
+		if (symbol >= 4096 && (symbol & (symbol - 1)) == 0)
+			PT_CORE_WARN("{} distinct tags interned, symbols are never released (generated tags?)", symbol);
+		return symbol;
+	}
+
+	TagSymbol TagIndex::Find(const std::string& tag)
+	{
+		std::shared_lock<std::shared_mutex> lock(s_SymbolsMutex);
+		auto it = s_Symbols.find(tag);
+		return it != s_Symbols.end() ? it->second : InvalidSymbol;
+	}
+
+	TagIndex::TagIndex(entt::registry& registry)
+		: m_Registry(registry)
+	{
+		registry.on_construct<TagComponent>().connect<&TagIndex::OnConstruct>(this);
+		registry.on_update<TagComponent>().connect<&TagIndex::OnUpdate>(this);
+		registry.on_destroy<TagComponent>().connect<&TagIndex::OnDestroy>(this);
+	}
+
+	TagIndex::~TagIndex()
+	{
+		m_Registry.on_construct<TagComponent>().disconnect(this);
+		m_Registry.on_update<TagComponent>().disconnect(this);
+		m_Registry.on_destroy<TagComponent>().disconnect(this);
+	}
+
+	const std::vector<entt::entity>& TagIndex::GetEntities(TagSymbol symbol) const
+	{
+		return symbol < m_Entities.size() ? m_Entities[symbol] : s_NoEntities;
+	}
+
+	TagSymbol TagIndex::GetSymbol(entt::entity entity) const
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		return index < m_Slots.size() ? m_Slots[index].Symbol : InvalidSymbol;
+	}
+
+	void TagIndex::Clear()
+	{
+		m_Entities.clear();
+		m_Slots.clear();
+		m_Version++;
+	}
+
+	void TagIndex::OnConstruct(entt::registry& registry, entt::entity entity)
+	{
+		Insert(entity, Intern(registry.get<TagComponent>(entity).Tag));
+	}
+
+	void TagIndex::OnUpdate(entt::registry& registry, entt::entity entity)
+	{
+		TagSymbol symbol = Intern(registry.get<TagComponent>(entity).Tag);
+		if (symbol == GetSymbol(entity))
+			return;
+
+		Remove(entity);
+		Insert(entity, symbol);
+	}
+
+	void TagIndex::OnDestroy(entt::registry& registry, entt::entity entity)
+	{
+		Remove(entity);
+	}
+
+	void TagIndex::Insert(entt::entity entity, TagSymbol symbol)
+	{
+		if (symbol >= m_Entities.size())
+			m_Entities.resize(symbol + 1);
+
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Slots.size())
+			m_Slots.resize(index + 1);
+
+		auto& entities = m_Entities[symbol];
+		m_Slots[index] = { symbol, (uint32_t)entities.size() };
+		entities.push_back(entity);
+		m_Version++;
+	}
+
+	void TagIndex::Remove(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Slots.size() || m_Slots[index].Symbol == InvalidSymbol)
+			return;
+
+		// Swap with the last entity of the list
+		Slot& slot = m_Slots[index];
+		auto& entities = m_Entities[slot.Symbol];
+		entt::entity last = entities.back();
+		entities[slot.Index] = last;
+		m_Slots[(uint32_t)entt::to_entity(last)].Index = slot.Index;
+		entities.pop_back();
+
+		slot = Slot();
+		m_Version++;
+	}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <entt/entt.hpp>
+#include <shared_mutex>
+
+namespace proton {
+
+	// Interned tag, equal symbols are equal tags
+	using TagSymbol = uint32_t;
+
+	//
+	// Index of scene entities by tag.
+	// Tags are interned into 32-bit symbols shared by all scenes (thread-safe, scenes are also built on
+	// workers by SceneManager::LoadAsync), every scene keeps a list of entities
+	// per symbol, maintained through registry signals of the TagComponent. Tags have to be changed with
+	// Entity::SetTag (or patched through the registry), in-place writes to TagComponent::Tag are not seen.
+	// Symbols are never released, not even when scenes are unloaded: the table grows with every distinct tag
+	// ever used. Tags should come from a bounded set, unique generated tags (e.g. "Bullet_1234") belong in
+	// a script field or component instead.
+	//
+	class TagIndex
+	{
+	public:
+		static constexpr TagSymbol InvalidSymbol = 0;
+
+		// Symbol of the tag, created on first use
+		static TagSymbol Intern(const std::string& tag);
+		// Symbol of the tag or InvalidSymbol if the tag was never used, does not create symbols
+		static TagSymbol Find(const std::string& tag);
+
+		TagIndex(entt::registry& registry);
+		virtual ~TagIndex();
+
+		// Entities with the tag, in no particular order
+		const std::vector<entt::entity>& GetEntities(TagSymbol symbol) const;
+		TagSymbol GetSymbol(entt::entity entity) const;
+		// Incremented on every change of the entity lists, see EntityRange
+		uint32_t GetVersion() const { return m_Version; }
+
+		void Clear();
+
+	private:
+		void OnConstruct(entt::registry& registry, entt::entity entity);
+		void OnUpdate(entt::registry& registry, entt::entity entity);
+		void OnDestroy(entt::registry& registry, entt::entity entity);
+
+		void Insert(entt::entity entity, TagSymbol symbol);
+		void Remove(entt::entity entity);
+
+	private:
+		struct Slot
+		{
+			TagSymbol Symbol = InvalidSymbol;
+			uint32_t Index = 0; // into the entity list of the symbol
+		};
+
+		entt::registry& m_Registry;
+		std::vector<std::vector<entt::entity>> m_Entities; // by symbol
+		std::vector<Slot> m_Slots;                         // by entity index
+		uint32_t m_Version = 0;
+
+		static inline std::unordered_map<std::string, TagSymbol> s_Symbols;
+		static inline std::shared_mutex s_SymbolsMutex;
+	};
+
+}
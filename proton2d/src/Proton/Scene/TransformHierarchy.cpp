@@ -0,0 +1,230 @@
+#include "ptpch.h"
+#include "Proton/Scene/TransformHierarchy.h"
+#include "Proton/Scene/Components.h"
+#include "Proton/Utils/Utils.h"
+
+#include <algorithm>
+
+namespace proton {
+
+	TransformHierarchy::TransformHierarchy(entt::registry& registry)
+		: m_Registry(registry)
+	{
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		m_Nodes.clear();
+		m_NodeIndices.clear();
+		m_ChangedEntities.clear();
+		m_DirtyNodes.clear();
+		m_StructureDirty = true;
+	}
+
+	void TransformHierarchy::AddRoot(entt::entity entity)
+	{
+		// Picked up by the rebuild
+		if (m_StructureDirty)
+			return;
+
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_NodeIndices.size())
+			m_NodeIndices.resize(index + 1, NoParent);
+		m_NodeIndices[index] = (uint32_t)m_Nodes.size();
+
+		Node& node = m_Nodes.emplace_back();
+		node.Entity = entity;
+		node.Dirty = true;
+		m_DirtyNodes.push_back(m_NodeIndices[index]);
+	}
+
+	void TransformHierarchy::MarkDirty(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_NodeIndices.size() || m_NodeIndices[index] >= m_Nodes.size())
+			return;
+
+		// Nodes not in the array yet are added dirty
+		Node& node = m_Nodes[m_NodeIndices[index]];
+		if (node.Entity != entity || node.Dirty)
+			return;
+
+		node.Dirty = true;
+		std::lock_guard<std::mutex> lock(m_DirtyNodesMutex);
+		m_DirtyNodes.push_back(m_NodeIndices[index]);
+	}
+
+	void TransformHierarchy::Rebuild()
+	{
+		PROFILE_FUNCTION();
+
+		std::vector<Node> nodes;
+		nodes.reserve(m_Registry.view<RelationshipComponent>().size());
+
+		// Depth first from every root, a node is appended before its children are pushed
+		auto view = m_Registry.view<RelationshipComponent>();
+		for (entt::entity root : view)
+		{
+			if (view.get<RelationshipComponent>(root).Parent != entt::null)
+				continue;
+
+			m_Stack.push_back(root);
+			while (m_Stack.size())
+			{
+				entt::entity entity = m_Stack.back();
+				m_Stack.pop_back();
+				auto& rc = view.get<RelationshipComponent>(entity);
+
+				// Cached transforms of nodes from the previous array are kept, they are not recomputed
+				Node& node = nodes.emplace_back();
+				uint32_t index = (uint32_t)entt::to_entity(entity);
+				if (index < m_NodeIndices.size() && m_NodeIndices[index] < m_Nodes.size() && m_Nodes[m_NodeIndices[index]].Entity == entity)
+				{
+					node = m_Nodes[m_NodeIndices[index]];
+
+					// Reparented, the world transform has to follow the new parent
+					entt::entity previousParent = node.Parent != NoParent ? m_Nodes[node.Parent].Entity : entt::null;
+					if (previousParent != rc.Parent)
+						node.Initialized = false;
+				}
+				node.Entity = entity;
+				node.SubtreeSize = 1;
+				node.Dirty = node.Dirty || !node.Initialized;
+				node.Parent = NoParent;
+				if (rc.Parent != entt::null)
+				{
+					uint32_t parentIndex = (uint32_t)entt::to_entity(rc.Parent);
+					node.Parent = m_NodeIndices[parentIndex];
+				}
+
+				// Parent index of the children, only valid for nodes of the new array from now on
+				if (index >= m_NodeIndices.size())
+					m_NodeIndices.resize(index + 1, NoParent);
+				m_NodeIndices[index] = (uint32_t)nodes.size() - 1;
+
+				for (entt::entity child = rc.First; child != entt::null; child = view.get<RelationshipComponent>(child).Next)
+					m_Stack.push_back(child);
+			}
+		}
+
+		// Children follow their parent, sizes are accumulated bottom up
+		for (uint32_t i = (uint32_t)nodes.size(); i-- > 0;)
+		{
+			if (nodes[i].Parent != NoParent)
+				nodes[nodes[i].Parent].SubtreeSize += nodes[i].SubtreeSize;
+		}
+
+		// Indices of the previous array are stale
+		m_DirtyNodes.clear();
+		for (uint32_t i = 0; i < (uint32_t)nodes.size(); i++)
+		{
+			if (nodes[i].Dirty)
+				m_DirtyNodes.push_back(i);
+		}
+
+		m_Nodes = std::move(nodes);
+		m_StructureDirty = false;
+	}
+
+	void TransformHierarchy::Update(bool isPhysicsSimulated)
+	{
+		PROFILE_FUNCTION();
+
+		if (m_StructureDirty)
+			Rebuild();
+
+		m_UpdatedNodesCount = 0;
+		if (m_DirtyNodes.empty())
+			return;
+
+		// Parents come first, dirty nodes inside an already visited subtree are skipped
+		std::sort(m_DirtyNodes.begin(), m_DirtyNodes.end());
+		uint32_t visitedEnd = 0;
+		for (uint32_t first : m_DirtyNodes)
+		{
+			if (first < visitedEnd)
+				continue;
+
+			visitedEnd = first + m_Nodes[first].SubtreeSize;
+			for (uint32_t i = first; i < visitedEnd; i++)
+				UpdateNode(m_Nodes[i], i != first, isPhysicsSimulated);
+		}
+		m_DirtyNodes.clear();
+	}
+
+	void TransformHierarchy::UpdateNode(Node& node, bool parentVisited, bool isPhysicsSimulated)
+	{
+		// Parent of the subtree root was not visited in this pass, its Moved flag is stale
+		const Node* parent = node.Parent != NoParent ? &m_Nodes[node.Parent] : nullptr;
+		bool parentMoved = parentVisited && parent->Moved;
+		node.Moved = false;
+		if (!node.Dirty && !parentMoved)
+			return;
+
+		node.Dirty = false;
+		auto& transform = m_Registry.get<TransformComponent>(node.Entity);
+		bool initialize = !node.Initialized;
+
+		bool localPositionChanged = initialize || transform.LocalPosition != node.LocalPosition;
+		bool worldPositionChanged = initialize || transform.WorldPosition != node.WorldPosition;
+		bool localRotationChanged = initialize || transform.Rotation != node.LocalRotation;
+		bool worldRotationChanged = initialize || transform.WorldRotation != node.WorldRotation;
+		bool scaleChanged = initialize || transform.Scale != node.Scale;
+
+		if (!parentMoved && !localPositionChanged && !worldPositionChanged && !localRotationChanged && !worldRotationChanged && !scaleChanged)
+			return;
+
+		glm::vec3 parentPosition = parent ? parent->WorldPosition : glm::vec3(0.0f);
+		float parentRotation = parent ? parent->WorldRotation : 0.0f;
+		glm::vec2 parentAxis = parent ? parent->WorldAxis : glm::vec2(1.0f, 0.0f);
+
+		// Transforms written by physics win, local ones are derived from them
+		bool worldDriven = isPhysicsSimulated && (!parent || m_Registry.any_of<RigidbodyComponent>(node.Entity));
+
+		if (worldDriven && (worldPositionChanged || parentMoved))
+		{
+			glm::vec2 offset = glm::vec2(transform.WorldPosition) - glm::vec2(parentPosition);
+			transform.LocalPosition = {
+				offset.x * parentAxis.x + offset.y * parentAxis.y,
+				offset.y * parentAxis.x - offset.x * parentAxis.y,
+				transform.WorldPosition.z - parentPosition.z
+			};
+		}
+		else if (localPositionChanged || worldPositionChanged || parentMoved)
+		{
+			const glm::vec3& local = transform.LocalPosition;
+			transform.WorldPosition = {
+				parentPosition.x + local.x * parentAxis.x - local.y * parentAxis.y,
+				parentPosition.y + local.x * parentAxis.y + local.y * parentAxis.x,
+				parentPosition.z + local.z
+			};
+		}
+
+		if (worldDriven && (worldRotationChanged || parentMoved))
+			transform.Rotation = transform.WorldRotation - parentRotation;
+		else if (localRotationChanged || worldRotationChanged || parentMoved)
+			transform.WorldRotation = parentRotation + transform.Rotation;
+
+		node.Moved = initialize || transform.WorldPosition != node.WorldPosition || transform.WorldRotation != node.WorldRotation;
+		if (node.Moved || scaleChanged)
+		{
+			transform.WorldMatrix = Math::GetTransform(transform.WorldPosition, transform.Scale, transform.WorldRotation);
+			m_ChangedEntities.push_back(node.Entity);
+		}
+
+		if (initialize || transform.WorldRotation != node.WorldRotation)
+		{
+			float radians = glm::radians(transform.WorldRotation);
+			node.WorldAxis = { glm::cos(radians), glm::sin(radians) };
+		}
+
+		node.LocalPosition = transform.LocalPosition;
+		node.WorldPosition = transform.WorldPosition;
+		node.LocalRotation = transform.Rotation;
+		node.WorldRotation = transform.WorldRotation;
+		node.Scale = transform.Scale;
+		node.Initialized = true;
+		m_UpdatedNodesCount++;
+	}
+
+}
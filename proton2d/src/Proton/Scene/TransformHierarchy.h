@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <mutex>
+
+namespace proton {
+
+	//
+	// Flattened scene transform hierarchy.
+	// Entities are kept in a depth first array (parents before their children, every subtree is a contiguous
+	// range), so world transforms are propagated linearly without walking RelationshipComponent lists.
+	// Writers of a transform mark its node dirty (Entity transform modifiers, physics readback, editor),
+	// an update visits only the subtrees of dirty nodes and recomputes dirty nodes and children of moved
+	// ones. Results are cached in TransformComponent (WorldPosition, WorldRotation, WorldMatrix).
+	// Children inherit position and rotation of their parent. Scale is the size of an entity, it is not inherited.
+	//
+	class TransformHierarchy
+	{
+	public:
+		TransformHierarchy(entt::registry& registry);
+
+		// Entity destroyed or reparented, the array is rebuilt on the next update
+		void Invalidate() { m_StructureDirty = true; }
+		// Entity created without a parent, appended to the array as a new root
+		void AddRoot(entt::entity entity);
+		// Transform of the entity was written, thread-safe for distinct entities (parallel scripts)
+		void MarkDirty(entt::entity entity);
+		// All entities removed, cached nodes are dropped so recreated identifiers are not taken for unchanged nodes
+		void Clear();
+
+		// When physics is simulated, roots and rigidbodies follow their world transform (written by physics)
+		// and their local transform is derived from it. Otherwise world transforms follow local ones.
+		void Update(bool isPhysicsSimulated);
+
+		// Entities whose WorldMatrix was recomputed since the list was last cleared (may repeat)
+		const std::vector<entt::entity>& GetChangedEntities() const { return m_ChangedEntities; }
+		void ClearChangedEntities() { m_ChangedEntities.clear(); }
+
+		// Stats of the last update
+		uint32_t GetNodesCount() const { return (uint32_t)m_Nodes.size(); }
+		uint32_t GetUpdatedNodesCount() const { return m_UpdatedNodesCount; }
+
+	private:
+		void Rebuild();
+
+	private:
+		static constexpr uint32_t NoParent = (uint32_t)-1;
+
+		struct Node
+		{
+			entt::entity Entity = entt::null;
+			uint32_t Parent = NoParent;
+
+			// Transform at the end of the last pass, compared to detect changes
+			glm::vec3 LocalPosition = glm::vec3(0.0f);
+			glm::vec3 WorldPosition = glm::vec3(0.0f);
+			float LocalRotation = 0.0f;
+			float WorldRotation = 0.0f;
+			glm::vec2 Scale = glm::vec2(0.0f);
+			glm::vec2 WorldAxis = { 1.0f, 0.0f }; // cos, sin of the world rotation
+
+			uint32_t SubtreeSize = 1; // the node and all of its descendants
+			bool Dirty = false;       // in the dirty list
+			bool Moved = false;       // world position or rotation changed in this pass
+			bool Initialized = false;
+		};
+
+		void UpdateNode(Node& node, bool parentVisited, bool isPhysicsSimulated);
+
+	private:
+		entt::registry& m_Registry;
+		std::vector<Node> m_Nodes;
+		std::vector<uint32_t> m_NodeIndices; // by entity index, valid only for nodes of the current array
+		std::vector<entt::entity> m_Stack;
+		std::vector<entt::entity> m_ChangedEntities;
+		std::vector<uint32_t> m_DirtyNodes;
+		std::mutex m_DirtyNodesMutex;
+		bool m_StructureDirty = true;
+		uint32_t m_UpdatedNodesCount = 0;
+	};
+
+}
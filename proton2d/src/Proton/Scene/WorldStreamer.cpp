@@ -0,0 +1,288 @@
+#include "ptpch.h"
+#include "Proton/Scene/WorldStreamer.h"
+#include "Proton/Assets/SceneSerializer.h"
+#include "Proton/Core/Application.h"
+#include "Proton/Core/Timer.h"
+#include "Proton/Utils/Utils.h"
+
+#include <limits>
+
+namespace proton {
+
+	WorldStreamer::WorldStreamer(Scene* scene, float cellSize)
+		: m_Scene(scene), m_CellSize(cellSize)
+	{
+		PT_CORE_ASSERT(cellSize > 0.0f, "Invalid streaming cell size!");
+	}
+
+	WorldStreamer::~WorldStreamer()
+	{
+		// Workers write into the cells
+		for (auto& cell : m_Cells)
+		{
+			if (!cell->Loading.IsDone())
+				Application::Get().GetJobSystem().Wait(cell->Loading);
+		}
+	}
+
+	void WorldStreamer::AddCell(const glm::ivec2& coord)
+	{
+		if (FindCell(coord))
+			return;
+
+		auto cell = MakeUnique<Cell>();
+		cell->Coord = coord;
+		m_Cells.push_back(std::move(cell));
+	}
+
+	WorldStreamer::Cell* WorldStreamer::FindCell(const glm::ivec2& coord)
+	{
+		for (auto& cell : m_Cells)
+		{
+			if (cell->Coord == coord)
+				return cell.get();
+		}
+		return nullptr;
+	}
+
+	glm::ivec2 WorldStreamer::GetCell(const glm::vec2& position) const
+	{
+		return { (int)glm::floor(position.x / m_CellSize), (int)glm::floor(position.y / m_CellSize) };
+	}
+
+	float WorldStreamer::GetDistance(const Cell& cell, const glm::vec2& position) const
+	{
+		glm::vec2 min = glm::vec2(cell.Coord) * m_CellSize;
+		glm::vec2 closest = glm::clamp(position, min, min + m_CellSize);
+		return glm::length(position - closest);
+	}
+
+	uint32_t WorldStreamer::GetActiveCellsCount() const
+	{
+		uint32_t count = 0;
+		for (auto& cell : m_Cells)
+		{
+			if (cell->State == CellState::Active)
+				count++;
+		}
+		return count;
+	}
+
+	void WorldStreamer::Update(const glm::vec2& position)
+	{
+		PROFILE_FUNCTION();
+
+		for (auto& cellPtr : m_Cells)
+		{
+			Cell& cell = *cellPtr;
+			float distance = GetDistance(cell, position);
+			switch (cell.State)
+			{
+			case CellState::Unloaded:
+				if (distance <= m_LoadRadius)
+					BeginLoading(cell);
+				break;
+
+			case CellState::Loading:
+				if (!cell.Loading.IsDone())
+					break;
+
+				if (distance > m_UnloadRadius)
+				{
+					cell.Data = json();
+					cell.State = CellState::Unloaded;
+					break;
+				}
+				cell.State = CellState::Activating;
+				cell.ActivatedCount = 0;
+				m_ActivationQueue.push_back(&cell);
+				break;
+
+			case CellState::Activating:
+			case CellState::Active:
+				if (distance <= m_UnloadRadius)
+					break;
+
+				if (cell.State == CellState::Activating)
+				{
+					m_ActivationQueue.erase(std::find(m_ActivationQueue.begin(), m_ActivationQueue.end(), &cell));
+					cell.Data = json();
+				}
+				cell.State = CellState::Unloading;
+				m_UnloadQueue.push_back(&cell);
+				break;
+
+			case CellState::Unloading:
+				break;
+			}
+		}
+
+		ActivateCells();
+		UnloadCells();
+	}
+
+	void WorldStreamer::BeginLoading(Cell& cell)
+	{
+		cell.State = CellState::Loading;
+		std::string filepath = m_CellsDirectory + GetCellFilename(cell.Coord);
+		Cell* target = &cell;
+
+		// File reading and parsing only, the registry is touched on the main thread
+		Application::Get().GetJobSystem().Run("WorldStreamer::LoadCell", [target, filepath]()
+		{
+			std::string data = Utils::ReadFile(filepath);
+			if (!data.size())
+			{
+				PT_CORE_ERROR("Streaming cell '{}' not found!", filepath);
+				return;
+			}
+
+			// Malformed cells are activated empty
+			target->Data = json::parse(data, nullptr, false);
+			if (target->Data.is_discarded())
+			{
+				PT_CORE_ERROR("Streaming cell '{}' is not valid JSON!", filepath);
+				target->Data = json();
+			}
+		}, &cell.Loading);
+	}
+
+	void WorldStreamer::ActivateCells()
+	{
+		if (m_ActivationQueue.empty())
+			return;
+
+		PROFILE_FUNCTION();
+
+		// At least one entity per frame, so activation always progresses
+		Timer timer;
+		SceneSerializer serializer(m_Scene);
+		while (m_ActivationQueue.size() && timer.ElapsedMillis() < m_FrameBudget)
+		{
+			Cell& cell = *m_ActivationQueue.front();
+			uint32_t count = cell.Data.contains("Entities") ? (uint32_t)cell.Data["Entities"].size() : 0;
+			while (cell.ActivatedCount < count && timer.ElapsedMillis() < m_FrameBudget)
+			{
+				Entity entity = serializer.DeserializeEntity(std::move(cell.Data["Entities"][cell.ActivatedCount++]));
+				entity.AddComponent<StreamingCellComponent>().Cell = cell.Coord;
+				cell.Entities.push_back(entity);
+			}
+
+			if (cell.ActivatedCount < count)
+				break;
+
+			cell.Data = json();
+			cell.State = CellState::Active;
+			m_ActivationQueue.erase(m_ActivationQueue.begin());
+		}
+	}
+
+	void WorldStreamer::UnloadCells()
+	{
+		if (m_UnloadQueue.empty())
+			return;
+
+		PROFILE_FUNCTION();
+
+		// Runtime bodies are destroyed with their entities, a batch limits the work of one frame
+		m_UnloadBatch.clear();
+		while (m_UnloadQueue.size() && m_UnloadBatch.size() < UnloadBatchSize)
+		{
+			Cell& cell = *m_UnloadQueue.front();
+			uint32_t count = std::min((uint32_t)cell.Entities.size(), UnloadBatchSize - (uint32_t)m_UnloadBatch.size());
+			m_UnloadBatch.insert(m_UnloadBatch.end(), cell.Entities.end() - count, cell.Entities.end());
+			cell.Entities.resize(cell.Entities.size() - count);
+
+			if (cell.Entities.empty())
+			{
+				cell.State = CellState::Unloaded;
+				m_UnloadQueue.erase(m_UnloadQueue.begin());
+			}
+		}
+		m_Scene->DestroyEntities(m_UnloadBatch);
+	}
+
+	void WorldStreamer::LoadAllCells()
+	{
+		PROFILE_FUNCTION();
+
+		for (auto& cell : m_Cells)
+		{
+			if (cell->State == CellState::Unloaded)
+				BeginLoading(*cell);
+		}
+
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		for (auto& cell : m_Cells)
+		{
+			if (cell->State != CellState::Loading)
+				continue;
+
+			jobSystem.Wait(cell->Loading);
+			cell->State = CellState::Activating;
+			cell->ActivatedCount = 0;
+			m_ActivationQueue.push_back(cell.get());
+		}
+
+		float frameBudget = m_FrameBudget;
+		m_FrameBudget = std::numeric_limits<float>::max();
+		ActivateCells();
+		m_FrameBudget = frameBudget;
+	}
+
+	void WorldStreamer::ResetCells()
+	{
+		JobSystem& jobSystem = Application::Get().GetJobSystem();
+		for (auto& cell : m_Cells)
+		{
+			jobSystem.Wait(cell->Loading);
+			cell->State = CellState::Unloaded;
+			cell->Data = json();
+			cell->ActivatedCount = 0;
+			cell->Entities.clear();
+		}
+		m_ActivationQueue.clear();
+		m_UnloadQueue.clear();
+
+		auto view = m_Scene->m_Registry.view<StreamingCellComponent>();
+		for (auto entity : view)
+		{
+			Cell* cell = FindCell(view.get<StreamingCellComponent>(entity).Cell);
+			if (!cell)
+				continue;
+
+			cell->Entities.emplace_back(entity, m_Scene);
+			cell->State = CellState::Active;
+		}
+	}
+
+	bool WorldStreamer::IsStreamable(Entity entity)
+	{
+		if (entity.HasComponent<ScriptComponent>() || entity.HasComponent<CameraComponent>())
+			return false;
+
+		for (entt::entity child = entity.GetComponent<RelationshipComponent>().First; child != entt::null;)
+		{
+			Entity childEntity{ child, entity.GetScene() };
+			if (!IsStreamable(childEntity))
+				return false;
+			child = childEntity.GetComponent<RelationshipComponent>().Next;
+		}
+		return true;
+	}
+
+	std::string WorldStreamer::GetCellsDirectory(const std::string& sceneFilepath)
+	{
+		static const std::string extension = ".scene.json";
+		std::string path = sceneFilepath;
+		if (path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0)
+			path.resize(path.size() - extension.size());
+		return path + ".cells/";
+	}
+
+	std::string WorldStreamer::GetCellFilename(const glm::ivec2& coord)
+	{
+		return std::to_string(coord.x) + "_" + std::to_string(coord.y) + ".cell.json";
+	}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Proton/Core/Base.h"
+#include "Proton/Core/JobSystem.h"
+#include "Proton/Scene/Entity.h"
+
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+
+namespace proton {
+
+	using json = nlohmann::ordered_json;
+
+	//
+	// Streaming of a scene partitioned into square cells.
+	// Root entities without scripts and cameras in their hierarchy are saved into cell files next to the
+	// scene file ("<scene>.cells/<x>_<y>.cell.json", see SceneSerializer), everything else stays in the scene.
+	// While playing, cells within the load radius of the camera are read and parsed by JobSystem workers,
+	// then their entities are created on the main thread within a per-frame time budget. Cells outside the
+	// unload radius are destroyed in batches of root entities, runtime bodies are removed with them.
+	// Changes made to streamed entities at runtime are not written back to their cell.
+	//
+	class WorldStreamer
+	{
+	public:
+		WorldStreamer(Scene* scene, float cellSize);
+		virtual ~WorldStreamer();
+
+		// Streams cells around the position, main thread only
+		void Update(const glm::vec2& position);
+
+		// Loads all remaining cells at once (editor, saving the scene needs all entities)
+		void LoadAllCells();
+
+		// Cell states are rebuilt from StreamingCellComponent of the scene entities (scene cleared or restored)
+		void ResetCells();
+
+		// Saved by SceneSerializer
+		void SetCellsDirectory(const std::string& directory) { m_CellsDirectory = directory; }
+		void AddCell(const glm::ivec2& coord);
+		void SetLoadRadius(float radius) { m_LoadRadius = radius; }
+		void SetUnloadRadius(float radius) { m_UnloadRadius = radius; }
+		void SetFrameBudget(float milliseconds) { m_FrameBudget = milliseconds; }
+
+		glm::ivec2 GetCell(const glm::vec2& position) const;
+		float GetCellSize() const { return m_CellSize; }
+		float GetLoadRadius() const { return m_LoadRadius; }
+		float GetUnloadRadius() const { return m_UnloadRadius; }
+		float GetFrameBudget() const { return m_FrameBudget; }
+		uint32_t GetActiveCellsCount() const;
+
+		// Root entity saved into a cell: no scripts and no cameras in its hierarchy
+		static bool IsStreamable(Entity entity);
+		static std::string GetCellsDirectory(const std::string& sceneFilepath);
+		static std::string GetCellFilename(const glm::ivec2& coord);
+
+	private:
+		enum class CellState
+		{
+			Unloaded, Loading, Activating, Active, Unloading
+		};
+
+		struct Cell
+		{
+			glm::ivec2 Coord = { 0, 0 };
+			CellState State = CellState::Unloaded;
+			JobCounter Loading;
+			json Data; // parsed by a worker
+			uint32_t ActivatedCount = 0;
+			std::vector<Entity> Entities; // root entities
+		};
+
+		Cell* FindCell(const glm::ivec2& coord);
+		float GetDistance(const Cell& cell, const glm::vec2& position) const;
+		void BeginLoading(Cell& cell);
+		void ActivateCells();
+		void UnloadCells();
+
+	private:
+		Scene* m_Scene = nullptr;
+		std::string m_CellsDirectory;
+		float m_CellSize = 64.0f;
+		float m_LoadRadius = 96.0f;
+		float m_UnloadRadius = 128.0f;
+		float m_FrameBudget = 2.0f; // milliseconds of entity creation per frame
+
+		std::vector<Unique<Cell>> m_Cells;
+		std::vector<Cell*> m_ActivationQueue;
+		std::vector<Cell*> m_UnloadQueue;
+		std::vector<Entity> m_UnloadBatch;
+
+		static constexpr uint32_t UnloadBatchSize = 256; // root entities destroyed per frame
+	};
+
+}
@@ -13,6 +13,14 @@ static inline const bool __RegisteredInFactory = \
 		return entity.AddScript<script_class>(); \
 	}, #script_class);
 
+// Same as ENTITY_SCRIPT_CLASS, OnUpdate of the script runs in parallel with other thread-safe scripts.
+// OnUpdate may only modify components of its own entity. Entities are created and components added
+// or removed through the scene command buffer (direct calls abort in every build configuration),
+// destroyed and reparented entities are deferred to the end of script updates.
+#define ENTITY_SCRIPT_CLASS_THREAD_SAFE(script_class) \
+ENTITY_SCRIPT_CLASS(script_class) \
+static constexpr bool __ThreadSafeUpdate = true;
+
 namespace proton {
 
 	// Supported script variable types for Serialization / Editor view.
@@ -29,9 +37,14 @@ namespace proton {
 	// - Use ENTITY_SCRIPT_CLASS in derived classes for registration.
 	// - Implement OnCreate, OnDestroy, OnUpdate for entity behavior.
 	// - Use OnRegisterFields to register fields (variables) for Serialization / Editor view.
+	// - Move, rotate and scale the entity with the Entity transform modifiers (SetWorldPosition, SetLocalPosition,
+	//   SetRotationCenter, RotateCenter, SetScale). Direct writes to GetTransform() are NOT propagated to
+	//   world transforms, children, culling and impostors until MarkTransformDirty() is called.
 	class EntityScript : public Entity
 	{
 	public:
+		static constexpr bool __ThreadSafeUpdate = false;
+
 		virtual ~EntityScript() = default;
 
 		virtual bool OnCreate() { return true; }
@@ -57,12 +70,15 @@ namespace proton {
 	private:
 		bool m_Stopped = false;
 		bool m_Initialized = false;
+		bool m_ThreadSafeUpdate = false;
 
 		std::map<std::string, ScriptField> m_ScriptFields;
 
 		friend class Entity;
 		friend class Scene;
 		friend class SceneSerializer;
+		friend class SceneSnapshot;
+		friend class PrefabManager;
 
 		friend class InspectorPanel;
 	};
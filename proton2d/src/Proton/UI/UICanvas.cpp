@@ -0,0 +1,130 @@
+#include "ptpch.h"
+#include "Proton/UI/UICanvas.h"
+#include "Proton/Graphics/Renderer/Renderer.h"
+#include "Proton/Utils/Utils.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace proton {
+
+	UICanvas::UICanvas()
+		: m_Root(MakeUnique<UIWidget>())
+	{
+		m_Root->m_Canvas = this;
+	}
+
+	UICanvas::~UICanvas() = default;
+
+	void UICanvas::AttachWidget(Unique<UIWidget> widget, UIWidget* parent)
+	{
+		if (!parent)
+			parent = m_Root.get();
+		PT_CORE_ASSERT(parent->m_Canvas == this, "Parent widget belongs to another canvas!");
+
+		widget->m_Canvas = this;
+		widget->m_Parent = parent;
+		parent->m_Children.push_back(std::move(widget));
+		m_Dirty = true;
+	}
+
+	void UICanvas::DestroyWidget(UIWidget* widget)
+	{
+		PT_CORE_ASSERT(widget && widget->m_Canvas == this && widget != m_Root.get(), "Invalid widget!");
+
+		auto& siblings = widget->m_Parent->m_Children;
+		auto it = std::find_if(siblings.begin(), siblings.end(), [widget](const Unique<UIWidget>& child) { return child.get() == widget; });
+		if (it != siblings.end())
+		{
+			siblings.erase(it);
+			m_Dirty = true;
+		}
+	}
+
+	void UICanvas::Clear()
+	{
+		m_Root->m_Children.clear();
+		m_Mesh.Clear();
+		m_Dirty = true;
+	}
+
+	void UICanvas::UpdateWidget(UIWidget& widget, const glm::vec2& parentMin, const glm::vec2& parentMax, bool parentChanged)
+	{
+		bool changed = false;
+		if (widget.m_LayoutDirty || parentChanged)
+		{
+			glm::vec2 anchorPoint = parentMin + (parentMax - parentMin) * widget.m_Anchor;
+			glm::vec2 rectMin = anchorPoint + widget.m_Position - widget.m_Size * widget.m_Pivot;
+			glm::vec2 rectMax = rectMin + widget.m_Size;
+
+			changed = rectMin != widget.m_RectMin || rectMax != widget.m_RectMax;
+			if (changed)
+			{
+				widget.m_RectMin = rectMin;
+				widget.m_RectMax = rectMax;
+				widget.m_GeometryDirty = true;
+			}
+			widget.m_LayoutDirty = false;
+		}
+
+		if (widget.m_GeometryDirty)
+		{
+			widget.m_Quads.clear();
+			widget.BuildGeometry(widget.m_Quads);
+			widget.m_GeometryDirty = false;
+		}
+
+		// Children of an unchanged widget are visited only to catch their own changes
+		for (auto& child : widget.m_Children)
+			UpdateWidget(*child, widget.m_RectMin, widget.m_RectMax, changed);
+	}
+
+	void UICanvas::AppendGeometry(const UIWidget& widget)
+	{
+		if (!widget.m_Visible)
+			return;
+
+		for (const UIQuad& quad : widget.m_Quads)
+		{
+			glm::vec2 center = (quad.Min + quad.Max) * 0.5f;
+			glm::mat4 transform = Math::GetTransform({ center, 0.0f }, quad.Max - quad.Min);
+			if (quad.Texture)
+				m_Mesh.AddQuad(transform, quad.Texture, quad.Coords, quad.Color);
+			else
+				m_Mesh.AddQuad(transform, quad.Color);
+		}
+
+		// Children are drawn over their parent
+		for (const auto& child : widget.m_Children)
+			AppendGeometry(*child);
+	}
+
+	void UICanvas::OnRender(const glm::uvec2& viewportSize)
+	{
+		PROFILE_FUNCTION();
+		if (IsEmpty() || viewportSize.x == 0 || viewportSize.y == 0)
+			return;
+
+		glm::vec2 size = glm::vec2(viewportSize);
+		if (size != m_Size)
+		{
+			m_Size = size;
+			m_Projection = glm::ortho(0.0f, size.x, 0.0f, size.y, -1.0f, 1.0f);
+			m_Root->m_Size = size;
+			m_Root->m_LayoutDirty = true;
+			m_Dirty = true;
+		}
+
+		if (m_Dirty)
+		{
+			PROFILE_SCOPE("ui_canvas_rebuild");
+			UpdateWidget(*m_Root, { 0.0f, 0.0f }, size, false);
+
+			m_Mesh.Clear();
+			AppendGeometry(*m_Root);
+			m_Dirty = false;
+		}
+
+		Renderer::DrawQuadMesh(m_Mesh, m_Projection);
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Proton/UI/UIWidget.h"
+#include "Proton/Graphics/Renderer/QuadMesh.h"
+
+namespace proton {
+
+	//
+	// Retained-mode screen space UI.
+	// Holds a tree of widgets laid out in pixels over the whole viewport, with its own orthographic projection.
+	// Each widget caches its layout and geometry; on a change only the dirty widgets are rebuilt and the canvas
+	// mesh is regenerated from the cached geometry. A canvas without changes is drawn straight from the GPU
+	// buffer, with a single vertex array bind and one draw call per texture batch.
+	//
+	class UICanvas
+	{
+	public:
+		UICanvas();
+		~UICanvas();
+
+		// Create widget of type TWidget as the last child of parent (canvas root if nullptr)
+		template<typename TWidget>
+		TWidget* CreateWidget(UIWidget* parent = nullptr)
+		{
+			static_assert(std::is_base_of<UIWidget, TWidget>::value, "TWidget must derive from UIWidget!");
+			Unique<TWidget> widget = MakeUnique<TWidget>();
+			TWidget* widgetPtr = widget.get();
+			AttachWidget(std::move(widget), parent);
+			return widgetPtr;
+		}
+
+		// Destroy widget with all of its children
+		void DestroyWidget(UIWidget* widget);
+		void Clear();
+
+		UIWidget* GetRoot() const { return m_Root.get(); }
+		const glm::vec2& GetSize() const { return m_Size; }
+		bool IsEmpty() const { return m_Root->m_Children.empty(); }
+
+		uint32_t GetQuadsCount() const { return m_Mesh.GetQuadsCount(); }
+		uint32_t GetDrawCallsCount() const { return m_Mesh.GetBatchesCount(); }
+
+		// Rebuild dirty widgets and draw the canvas over the currently bound framebuffer
+		void OnRender(const glm::uvec2& viewportSize);
+
+	private:
+		void AttachWidget(Unique<UIWidget> widget, UIWidget* parent);
+		void UpdateWidget(UIWidget& widget, const glm::vec2& parentMin, const glm::vec2& parentMax, bool parentChanged);
+		void AppendGeometry(const UIWidget& widget);
+
+	private:
+		Unique<UIWidget> m_Root;
+		QuadMesh m_Mesh;
+		glm::vec2 m_Size = { 0.0f, 0.0f };
+		glm::mat4 m_Projection = glm::mat4(1.0f);
+		bool m_Dirty = true;
+
+		friend class UIWidget;
+	};
+
+}
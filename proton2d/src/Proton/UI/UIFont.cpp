@@ -0,0 +1,37 @@
+#include "ptpch.h"
+#include "Proton/UI/UIFont.h"
+
+namespace proton {
+
+	UIFont::UIFont(const Shared<Texture>& atlas, uint32_t columns, uint32_t rows, uint8_t firstCharacter)
+		: m_Atlas(atlas), m_FirstCharacter(firstCharacter)
+	{
+		PT_CORE_ASSERT(atlas && columns && rows, "Invalid font atlas!");
+
+		m_GlyphAspectRatio = ((float)atlas->GetWidth() / columns) / ((float)atlas->GetHeight() / rows);
+		uint32_t glyphCount = glm::min(columns * rows, 256u - firstCharacter);
+		m_GlyphCoords.resize(glyphCount);
+
+		glm::vec2 cellSize = { 1.0f / columns, 1.0f / rows };
+		for (uint32_t i = 0; i < glyphCount; i++)
+		{
+			// First row is at the top of the atlas
+			glm::vec2 min = { (i % columns) * cellSize.x, 1.0f - (i / columns + 1) * cellSize.y };
+			glm::vec2 max = min + cellSize;
+			m_GlyphCoords[i] = { {{ min.x, min.y }, { max.x, min.y }, { max.x, max.y }, { min.x, max.y }} };
+		}
+	}
+
+	bool UIFont::HasGlyph(char character) const
+	{
+		uint8_t code = (uint8_t)character;
+		return code >= m_FirstCharacter && code - m_FirstCharacter < (uint32_t)m_GlyphCoords.size();
+	}
+
+	const TextureCoords& UIFont::GetGlyphCoords(char character) const
+	{
+		PT_CORE_ASSERT(HasGlyph(character), "Font has no glyph for this character!");
+		return m_GlyphCoords[(uint8_t)character - m_FirstCharacter];
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "Proton/Graphics/Spritesheet.h"
+
+namespace proton {
+
+	//
+	// Monospaced bitmap font.
+	// Atlas texture is a grid of equally sized glyph cells in character code order,
+	// starting at the top left cell with firstCharacter.
+	//
+	class UIFont
+	{
+	public:
+		UIFont(const Shared<Texture>& atlas, uint32_t columns = 16, uint32_t rows = 16, uint8_t firstCharacter = 0);
+
+		const Shared<Texture>& GetAtlas() const { return m_Atlas; }
+
+		// Glyph cell width / height
+		float GetGlyphAspectRatio() const { return m_GlyphAspectRatio; }
+		bool HasGlyph(char character) const;
+		const TextureCoords& GetGlyphCoords(char character) const;
+
+	private:
+		Shared<Texture> m_Atlas;
+		std::vector<TextureCoords> m_GlyphCoords;
+		uint8_t m_FirstCharacter = 0;
+		float m_GlyphAspectRatio = 1.0f;
+	};
+
+}
@@ -0,0 +1,253 @@
+#include "ptpch.h"
+#include "Proton/UI/UIWidget.h"
+#include "Proton/UI/UICanvas.h"
+#include "Proton/UI/UIFont.h"
+
+namespace proton {
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// UIWidget
+
+	void UIWidget::SetPosition(const glm::vec2& position)
+	{
+		if (position != m_Position)
+		{
+			m_Position = position;
+			MarkLayoutDirty();
+		}
+	}
+
+	void UIWidget::SetSize(const glm::vec2& size)
+	{
+		if (size != m_Size)
+		{
+			m_Size = size;
+			MarkLayoutDirty();
+		}
+	}
+
+	void UIWidget::SetAnchor(const glm::vec2& anchor)
+	{
+		if (anchor != m_Anchor)
+		{
+			m_Anchor = anchor;
+			MarkLayoutDirty();
+		}
+	}
+
+	void UIWidget::SetPivot(const glm::vec2& pivot)
+	{
+		if (pivot != m_Pivot)
+		{
+			m_Pivot = pivot;
+			MarkLayoutDirty();
+		}
+	}
+
+	void UIWidget::SetColor(const glm::vec4& color)
+	{
+		if (color != m_Color)
+		{
+			m_Color = color;
+			MarkGeometryDirty();
+		}
+	}
+
+	void UIWidget::SetVisible(bool visible)
+	{
+		if (visible != m_Visible)
+		{
+			m_Visible = visible;
+			if (m_Canvas)
+				m_Canvas->m_Dirty = true;
+		}
+	}
+
+	void UIWidget::MarkGeometryDirty()
+	{
+		m_GeometryDirty = true;
+		if (m_Canvas)
+			m_Canvas->m_Dirty = true;
+	}
+
+	void UIWidget::MarkLayoutDirty()
+	{
+		m_LayoutDirty = true;
+		if (m_Canvas)
+			m_Canvas->m_Dirty = true;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// UIRect
+
+	void UIRect::BuildGeometry(std::vector<UIQuad>& quads) const
+	{
+		UIQuad& quad = quads.emplace_back();
+		quad.Min = GetRectMin();
+		quad.Max = GetRectMax();
+		quad.Color = GetColor();
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// UIImage
+
+	void UIImage::SetTexture(const Shared<Texture>& texture)
+	{
+		SetTexture(texture, { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} });
+	}
+
+	void UIImage::SetTexture(const Shared<Texture>& texture, const TextureCoords& textureCoords)
+	{
+		m_Texture = texture;
+		m_TextureCoords = textureCoords;
+		MarkGeometryDirty();
+	}
+
+	void UIImage::BuildGeometry(std::vector<UIQuad>& quads) const
+	{
+		UIQuad& quad = quads.emplace_back();
+		quad.Min = GetRectMin();
+		quad.Max = GetRectMax();
+		quad.Color = GetColor();
+		quad.Texture = m_Texture;
+		quad.Coords = m_TextureCoords;
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// UINineSlice
+
+	void UINineSlice::SetTexture(const Shared<Texture>& texture)
+	{
+		m_Texture = texture;
+		MarkGeometryDirty();
+	}
+
+	void UINineSlice::SetBorder(const glm::vec4& border)
+	{
+		if (border != m_Border)
+		{
+			m_Border = glm::max(border, glm::vec4(0.0f));
+			MarkGeometryDirty();
+		}
+	}
+
+	void UINineSlice::SetBorderScale(float scale)
+	{
+		if (scale != m_BorderScale)
+		{
+			m_BorderScale = glm::max(scale, 0.0f);
+			MarkGeometryDirty();
+		}
+	}
+
+	void UINineSlice::BuildGeometry(std::vector<UIQuad>& quads) const
+	{
+		if (!m_Texture)
+			return;
+
+		const glm::vec2& rectMin = GetRectMin();
+		const glm::vec2& rectMax = GetRectMax();
+		glm::vec2 textureSize = { (float)m_Texture->GetWidth(), (float)m_Texture->GetHeight() };
+
+		// Borders shrink when the widget is smaller than both borders together
+		glm::vec2 size = rectMax - rectMin;
+		glm::vec2 minBorder = glm::vec2(m_Border.x, m_Border.z) * m_BorderScale;
+		glm::vec2 maxBorder = glm::vec2(m_Border.y, m_Border.w) * m_BorderScale;
+		glm::vec2 borderSum = minBorder + maxBorder;
+		for (int i = 0; i < 2; i++)
+		{
+			if (borderSum[i] > size[i] && borderSum[i] > 0.0f)
+			{
+				minBorder[i] *= size[i] / borderSum[i];
+				maxBorder[i] *= size[i] / borderSum[i];
+			}
+		}
+
+		// Slice edges on screen and in the texture
+		glm::vec2 positions[4] = { rectMin, rectMin + minBorder, rectMax - maxBorder, rectMax };
+		glm::vec2 coords[4] = {
+			{ 0.0f, 0.0f },
+			glm::vec2(m_Border.x, m_Border.z) / textureSize,
+			1.0f - glm::vec2(m_Border.y, m_Border.w) / textureSize,
+			{ 1.0f, 1.0f }
+		};
+
+		for (int y = 0; y < 3; y++)
+		{
+			for (int x = 0; x < 3; x++)
+			{
+				glm::vec2 min = { positions[x].x, positions[y].y };
+				glm::vec2 max = { positions[x + 1].x, positions[y + 1].y };
+				if (max.x <= min.x || max.y <= min.y)
+					continue;
+
+				glm::vec2 coordsMin = { coords[x].x, coords[y].y };
+				glm::vec2 coordsMax = { coords[x + 1].x, coords[y + 1].y };
+
+				UIQuad& quad = quads.emplace_back();
+				quad.Min = min;
+				quad.Max = max;
+				quad.Color = GetColor();
+				quad.Texture = m_Texture;
+				quad.Coords = { {{ coordsMin.x, coordsMin.y }, { coordsMax.x, coordsMin.y }, { coordsMax.x, coordsMax.y }, { coordsMin.x, coordsMax.y }} };
+			}
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////////////////////////
+	// UIText
+
+	void UIText::SetText(const std::string& text)
+	{
+		if (text != m_Text)
+		{
+			m_Text = text;
+			MarkGeometryDirty();
+		}
+	}
+
+	void UIText::SetFont(const Shared<UIFont>& font)
+	{
+		m_Font = font;
+		MarkGeometryDirty();
+	}
+
+	void UIText::SetFontSize(float size)
+	{
+		if (size != m_FontSize)
+		{
+			m_FontSize = glm::max(size, 0.0f);
+			MarkGeometryDirty();
+		}
+	}
+
+	void UIText::BuildGeometry(std::vector<UIQuad>& quads) const
+	{
+		if (!m_Font || m_Text.empty())
+			return;
+
+		glm::vec2 glyphSize = { m_FontSize * m_Font->GetGlyphAspectRatio(), m_FontSize };
+		glm::vec2 cursor = { GetRectMin().x, GetRectMax().y - glyphSize.y };
+
+		for (char character : m_Text)
+		{
+			if (character == '\n')
+			{
+				cursor = { GetRectMin().x, cursor.y - glyphSize.y };
+				continue;
+			}
+
+			if (character != ' ' && m_Font->HasGlyph(character))
+			{
+				UIQuad& quad = quads.emplace_back();
+				quad.Min = cursor;
+				quad.Max = cursor + glyphSize;
+				quad.Color = GetColor();
+				quad.Texture = m_Font->GetAtlas();
+				quad.Coords = m_Font->GetGlyphCoords(character);
+			}
+			cursor.x += glyphSize.x;
+		}
+	}
+
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "Proton/Graphics/Spritesheet.h"
+
+#include <glm/glm.hpp>
+
+namespace proton {
+
+	// Forward declaration
+	class UICanvas;
+	class UIFont;
+
+	// Widget geometry in canvas pixel space, (0, 0) is the bottom left corner of the canvas
+	struct UIQuad
+	{
+		glm::vec2 Min, Max;
+		glm::vec4 Color;
+		Shared<Texture> Texture; // nullptr - solid color
+		TextureCoords Coords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+	};
+
+	//
+	// Base class of all UICanvas widgets, without geometry it is a plain container.
+	// Widget rect is laid out in pixels relative to the parent rect: the pivot point of the widget
+	// is placed at the anchor point of the parent, moved by position. Setters only mark the widget
+	// dirty, layout and geometry are rebuilt by the canvas before it is drawn.
+	//
+	class UIWidget
+	{
+	public:
+		UIWidget() = default;
+		virtual ~UIWidget() = default;
+
+		void SetPosition(const glm::vec2& position);
+		void SetSize(const glm::vec2& size);
+		void SetAnchor(const glm::vec2& anchor); // (0, 0) bottom left, (1, 1) top right of the parent
+		void SetPivot(const glm::vec2& pivot);   // (0, 0) bottom left, (1, 1) top right of the widget
+		void SetColor(const glm::vec4& color);
+		void SetVisible(bool visible);
+
+		const glm::vec2& GetPosition() const { return m_Position; }
+		const glm::vec2& GetSize() const { return m_Size; }
+		const glm::vec2& GetAnchor() const { return m_Anchor; }
+		const glm::vec2& GetPivot() const { return m_Pivot; }
+		const glm::vec4& GetColor() const { return m_Color; }
+		bool IsVisible() const { return m_Visible; }
+
+		// Laid out rect in canvas pixel space, valid after the canvas was rendered
+		const glm::vec2& GetRectMin() const { return m_RectMin; }
+		const glm::vec2& GetRectMax() const { return m_RectMax; }
+
+		UICanvas* GetCanvas() const { return m_Canvas; }
+		UIWidget* GetParent() const { return m_Parent; }
+		const std::vector<Unique<UIWidget>>& GetChildren() const { return m_Children; }
+
+	protected:
+		// Build quads of this widget (without children) inside its laid out rect.
+		// Called only when the widget is dirty, the result is cached until the next change.
+		virtual void BuildGeometry(std::vector<UIQuad>& quads) const {}
+
+		// Mark own geometry for rebuild (properties of derived widgets)
+		void MarkGeometryDirty();
+
+	private:
+		void MarkLayoutDirty();
+
+	private:
+		UICanvas* m_Canvas = nullptr;
+		UIWidget* m_Parent = nullptr;
+		std::vector<Unique<UIWidget>> m_Children;
+
+		glm::vec2 m_Position = { 0.0f, 0.0f };
+		glm::vec2 m_Size = { 100.0f, 100.0f };
+		glm::vec2 m_Anchor = { 0.0f, 0.0f };
+		glm::vec2 m_Pivot = { 0.0f, 0.0f };
+		glm::vec4 m_Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		bool m_Visible = true;
+
+		// Cached layout and geometry
+		glm::vec2 m_RectMin = { 0.0f, 0.0f };
+		glm::vec2 m_RectMax = { 0.0f, 0.0f };
+		std::vector<UIQuad> m_Quads;
+		bool m_LayoutDirty = true;
+		bool m_GeometryDirty = true;
+
+		friend class UICanvas;
+	};
+
+	// Solid color rectangle
+	class UIRect : public UIWidget
+	{
+	protected:
+		void BuildGeometry(std::vector<UIQuad>& quads) const override;
+	};
+
+	// Texture (or its region) stretched over the widget rect, tinted by the widget color
+	class UIImage : public UIWidget
+	{
+	public:
+		void SetTexture(const Shared<Texture>& texture);
+		void SetTexture(const Shared<Texture>& texture, const TextureCoords& textureCoords);
+		const Shared<Texture>& GetTexture() const { return m_Texture; }
+
+	protected:
+		void BuildGeometry(std::vector<UIQuad>& quads) const override;
+
+	private:
+		Shared<Texture> m_Texture = nullptr;
+		TextureCoords m_TextureCoords = { {{ 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }} };
+	};
+
+	// Texture split into 3x3 regions by its borders, corners keep their size and the rest stretches
+	class UINineSlice : public UIWidget
+	{
+	public:
+		void SetTexture(const Shared<Texture>& texture);
+		const Shared<Texture>& GetTexture() const { return m_Texture; }
+
+		// Borders in texture pixels (left, right, bottom, top)
+		void SetBorder(const glm::vec4& border);
+		const glm::vec4& GetBorder() const { return m_Border; }
+
+		// Screen pixels per texture pixel of the borders
+		void SetBorderScale(float scale);
+		float GetBorderScale() const { return m_BorderScale; }
+
+	protected:
+		void BuildGeometry(std::vector<UIQuad>& quads) const override;
+
+	private:
+		Shared<Texture> m_Texture = nullptr;
+		glm::vec4 m_Border = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float m_BorderScale = 1.0f;
+	};
+
+	// Single style text drawn with a monospaced bitmap font, starting at the top left corner of the widget rect
+	class UIText : public UIWidget
+	{
+	public:
+		void SetText(const std::string& text);
+		void SetFont(const Shared<UIFont>& font);
+		void SetFontSize(float size); // line height in pixels
+
+		const std::string& GetText() const { return m_Text; }
+		const Shared<UIFont>& GetFont() const { return m_Font; }
+		float GetFontSize() const { return m_FontSize; }
+
+	protected:
+		void BuildGeometry(std::vector<UIQuad>& quads) const override;
+
+	private:
+		std::string m_Text;
+		Shared<UIFont> m_Font = nullptr;
+		float m_FontSize = 16.0f;
+	};
+
+}
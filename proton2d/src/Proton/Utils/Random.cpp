@@ -8,16 +8,17 @@ namespace proton {
 
 	uint32_t Random::Int(uint32_t min, uint32_t max)
 	{
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
+		// Generator per thread, scripts may be updated in parallel
+		static thread_local std::random_device rd;
+		static thread_local std::mt19937 gen(rd());
 		std::uniform_int_distribution<> dis(min, max);
 		return dis(gen);
 	}
 
 	float Random::Float(float min, float max)
 	{
-		static std::random_device rd;
-		static std::mt19937 gen(rd());
+		static thread_local std::random_device rd;
+		static thread_local std::mt19937 gen(rd());
 		std::uniform_real_distribution<> dis((float)min, (float)max);
 		return (float)dis(gen);
 	}
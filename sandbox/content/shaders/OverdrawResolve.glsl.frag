@@ -0,0 +1,29 @@
+// Fragment Shader
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+// Fragments per pixel, accumulated by the DEBUG_OVERDRAW variant of Quad2D
+layout (binding = 0) uniform sampler2D u_Overdraw;
+
+const vec3 c_Ramp[6] = vec3[](
+	vec3(0.0, 0.0, 0.0), // 0
+	vec3(0.0, 0.2, 0.8), // 1
+	vec3(0.0, 0.7, 0.3), // 2
+	vec3(0.9, 0.9, 0.0), // 3
+	vec3(1.0, 0.4, 0.0), // 4
+	vec3(1.0, 0.0, 0.0)  // 5
+);
+
+void main()
+{
+	float count = texelFetch(u_Overdraw, ivec2(gl_FragCoord.xy), 0).r;
+
+	// Past the ramp it fades to white at 10 layers
+	float ramp = clamp(count, 0.0, 5.0);
+	int index = min(int(ramp), 4);
+	vec3 color = mix(c_Ramp[index], c_Ramp[index + 1], ramp - float(index));
+	color = mix(color, vec3(1.0), clamp((count - 5.0) / 5.0, 0.0, 1.0));
+
+	o_Color = vec4(color, 1.0);
+}
@@ -0,0 +1,9 @@
+// Vertex Shader
+#version 450 core
+
+// Fullscreen triangle, drawn without vertex buffers
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
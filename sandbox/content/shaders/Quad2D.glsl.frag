@@ -8,13 +8,73 @@ struct VertexOutput
 	vec4 Color;
 	vec2 TextureCoords;
 	float TilingFactor;
+	vec2 WorldPosition;
 };
 
 layout (location = 0) in VertexOutput Input;
-layout (location = 3) in flat float v_TextureIndex;
+layout (location = 4) in flat float v_TextureIndex;
 
 layout (binding = 0) uniform sampler2D u_Textures[32];
 
+// Debug visualization variants (see RendererDebugMode), compiled with one of:
+// DEBUG_OVERDRAW     - every rasterized fragment adds 1, resolved to a color ramp (OverdrawResolve.glsl)
+// DEBUG_BATCH_ID     - color of the draw call the quad landed in
+// DEBUG_TEXTURE_SLOT - color of the texture slot of the quad
+#ifdef DEBUG_BATCH_ID
+uniform int u_BatchIndex;
+#endif
+
+#if defined(DEBUG_BATCH_ID) || defined(DEBUG_TEXTURE_SLOT)
+vec3 DebugColor(int index)
+{
+	// Golden ratio hue steps keep neighbouring indices apart
+	float hue = fract(float(index) * 0.618034);
+	vec3 rgb = clamp(abs(mod(hue * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+	return mix(vec3(0.2), rgb, 0.85);
+}
+#endif
+
+// Tiled point lights (see LightGrid.cpp)
+struct PointLight
+{
+	vec4 PositionRadius;
+	vec4 ColorIntensity;
+};
+
+layout(std430, binding = 1) readonly buffer PointLights
+{
+	PointLight u_PointLights[];
+};
+
+layout(std430, binding = 2) readonly buffer LightGrid
+{
+	ivec4 u_LightGridInfo; // tile count x, tile count y, tile size, enabled
+	ivec4 u_LightGridViewport; // x, y, width, height
+	vec4 u_AmbientColor;
+	uvec2 u_TileLightRanges[]; // offset, count
+};
+
+layout(std430, binding = 3) readonly buffer LightIndices
+{
+	uint u_LightIndices[];
+};
+
+vec3 CalculateLighting()
+{
+	vec3 lighting = u_AmbientColor.rgb * u_AmbientColor.a;
+
+	ivec2 tile = clamp((ivec2(gl_FragCoord.xy) - u_LightGridViewport.xy) / u_LightGridInfo.z, ivec2(0), u_LightGridInfo.xy - 1);
+	uvec2 range = u_TileLightRanges[tile.y * u_LightGridInfo.x + tile.x];
+
+	for (uint i = 0; i < range.y; i++)
+	{
+		PointLight light = u_PointLights[u_LightIndices[range.x + i]];
+		float attenuation = clamp(1.0 - length(Input.WorldPosition - light.PositionRadius.xy) / light.PositionRadius.z, 0.0, 1.0);
+		lighting += light.ColorIntensity.rgb * light.ColorIntensity.a * attenuation * attenuation;
+	}
+	return lighting;
+}
+
 void main()
 {
 	vec4 textureColor = Input.Color;
@@ -55,8 +115,23 @@ void main()
 		case 31: textureColor *= texture(u_Textures[31], Input.TextureCoords * Input.TilingFactor); break;
 	}
 
+#ifdef DEBUG_OVERDRAW
+	// Fragments discarded below cost fill rate too, they are counted
+	o_Color = vec4(1.0);
+	return;
+#endif
+
 	if (textureColor.a == 0.0)
 		discard;
 
+#if defined(DEBUG_BATCH_ID)
+	o_Color = vec4(DebugColor(u_BatchIndex), textureColor.a);
+#elif defined(DEBUG_TEXTURE_SLOT)
+	o_Color = vec4(DebugColor(int(v_TextureIndex)), textureColor.a);
+#else
+	if (u_LightGridInfo.w != 0)
+		textureColor.rgb *= CalculateLighting();
+
 	o_Color = textureColor;
+#endif
 }
\ No newline at end of file
@@ -17,16 +17,18 @@ struct VertexOutput
 	vec4 Color;
 	vec2 TextureCoords;
 	float TilingFactor;
+	vec2 WorldPosition;
 };
 
 layout (location = 0) out VertexOutput Output;
-layout (location = 3) out flat float v_TextureIndex;
+layout (location = 4) out flat float v_TextureIndex;
 
 void main()
 {
 	Output.Color = Color;
 	Output.TextureCoords = TextureCoords;
 	Output.TilingFactor = TilingFactor;
+	Output.WorldPosition = Position.xy;
 	v_TextureIndex = TextureIndex;
 
 	gl_Position = u_ViewProjection * vec4(Position, 1.0);
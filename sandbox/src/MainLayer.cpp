@@ -1,4 +1,5 @@
 #include <Proton.h>
+#include <Proton/Core/Timer.h>
 using namespace proton;
 
 #include "MainLayer.h"
@@ -16,6 +17,33 @@ void MainLayer::OnCreate()
 
 void MainLayer::OnUpdate(float ts)
 {
+	// Wall time of the whole previous frame, independent of the time scale
+	float frameTime = m_FrameTimer.ElapsedMillis();
+	m_FrameTimer.Reset();
+	if (m_SamplingName.empty())
+		return;
+
+	// First frame after starting includes the benchmark setup
+	if (m_SampledFrames++ == 0)
+		return;
+
+	m_SampledTime += frameTime;
+	m_WorstFrameTime = glm::max(m_WorstFrameTime, frameTime);
+	if (m_SampledFrames <= BenchmarkFrames)
+		return;
+
+	PT_INFO("Benchmark '{}': {:.3f} ms/frame average, {:.3f} ms worst, {} draw calls, {} visible lights ({} frames)",
+		m_SamplingName, m_SampledTime / BenchmarkFrames, m_WorstFrameTime, Renderer::GetDrawCallsCount(),
+		Renderer::GetVisibleLightsCount(), BenchmarkFrames);
+	m_SamplingName.clear();
+}
+
+void MainLayer::StartFrameSampling(const std::string& name)
+{
+	m_SamplingName = name;
+	m_SampledFrames = 0;
+	m_SampledTime = 0.0f;
+	m_WorstFrameTime = 0.0f;
 }
 
 void MainLayer::OnEvent(Event& e)
@@ -28,6 +56,18 @@ void MainLayer::OnEvent(Event& e)
 		if (event.GetKeyCode() == Key::E)
 			SpawnRandomBox(scene->GetCursorWorldPosition());
 
+		if (event.GetKeyCode() == Key::L)
+		{
+			uint32_t count = (uint32_t)m_BenchmarkLights.size();
+			SpawnBenchmarkLights(count == 0 ? 10 : count >= 1000 ? 0 : count * 10);
+		}
+
+		if (event.GetKeyCode() == Key::J)
+			RunJobSystemBenchmark();
+
+		if (event.GetKeyCode() == Key::G)
+			ToggleBenchmarkSprites();
+
 		return false;
 	});
 }
@@ -48,3 +88,129 @@ void MainLayer::SpawnRandomBox(const glm::vec2& position)
 	entity.AddComponent<RigidbodyComponent>().Type = b2_dynamicBody;
 	entity.AddComponent<BoxColliderComponent>();
 }
+
+void MainLayer::SpawnBenchmarkLights(uint32_t count)
+{
+	Scene* scene = SceneManager::GetActiveScene();
+	for (UUID id : m_BenchmarkLights)
+	{
+		Entity entity = scene->FindByID(id);
+		if (entity.IsValid())
+			entity.Destroy();
+	}
+	m_BenchmarkLights.clear();
+
+	scene->SetLighting(count > 0, { 0.15f, 0.15f, 0.25f, 1.0f });
+
+	// Scatter lights across the current view
+	const OrthoProjection& ortho = scene->GetPrimaryCamera().GetOrthoProjection();
+	const glm::vec3& camera = scene->GetPrimaryCameraPosition();
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Entity entity = scene->CreateEntity("Benchmark Light");
+		entity.SetWorldPosition({
+			camera.x + Random::Float(ortho.Left, ortho.Right),
+			camera.y + Random::Float(ortho.Bottom, ortho.Top), 0.0f
+		});
+
+		auto& light = entity.AddComponent<PointLight2DComponent>();
+		light.Color = { Random::Float(0.2f, 1.0f), Random::Float(0.2f, 1.0f), Random::Float(0.2f, 1.0f) };
+		light.Radius = Random::Float(1.0f, 4.0f);
+		m_BenchmarkLights.push_back(entity.GetUUID());
+	}
+	PT_INFO("Benchmark lights: {}", count);
+	StartFrameSampling(std::to_string(count) + " lights");
+}
+
+void MainLayer::ToggleBenchmarkSprites()
+{
+	Scene* scene = SceneManager::GetActiveScene();
+	if (m_BenchmarkSprites.size())
+	{
+		std::vector<Entity> entities;
+		for (UUID id : m_BenchmarkSprites)
+		{
+			Entity entity = scene->FindByID(id);
+			if (entity.IsValid())
+				entities.push_back(entity);
+		}
+		scene->DestroyEntities(entities);
+		m_BenchmarkSprites.clear();
+		StartFrameSampling("no benchmark sprites");
+		return;
+	}
+
+	// Sprite grid around the camera, the first boxes also get dynamic bodies
+	const uint32_t spritesCount = 10000, bodiesCount = 1000;
+	std::vector<Entity> entities(spritesCount);
+	scene->CreateEntities(spritesCount, entities.data(), "Benchmark Sprite");
+
+	const glm::vec3& camera = scene->GetPrimaryCameraPosition();
+	for (uint32_t i = 0; i < spritesCount; i++)
+	{
+		Entity entity = entities[i];
+		entity.SetWorldPosition({ camera.x + (float)(i % 100) - 50.0f, camera.y + (float)(i / 100) - 50.0f, 0.0f });
+		entity.AddComponent<SpriteComponent>("box.png");
+		if (i < bodiesCount)
+		{
+			entity.AddComponent<RigidbodyComponent>().Type = b2_dynamicBody;
+			entity.AddComponent<BoxColliderComponent>();
+		}
+		m_BenchmarkSprites.push_back(entity.GetUUID());
+	}
+	StartFrameSampling("10k sprites, 1k bodies");
+}
+
+void MainLayer::RunJobSystemBenchmark()
+{
+	// Spawn overhead: empty jobs on the application job system
+	JobSystem& jobSystem = Application::Get().GetJobSystem();
+	const uint32_t jobsCount = 100000;
+	{
+		Timer timer;
+		JobCounter counter;
+		for (uint32_t i = 0; i < jobsCount; i++)
+			jobSystem.Run("EmptyJob", []() {}, &counter);
+		jobSystem.Wait(counter);
+		PT_INFO("Job spawn overhead: {:.1f} ns/job ({} workers)", timer.Elapsed() * 1e9f / jobsCount, jobSystem.GetWorkersCount());
+	}
+
+	// Scaling: the same arithmetic workload split into chunks, on job systems of different sizes
+	const uint32_t itemsCount = 1 << 20;
+	std::vector<float> results(itemsCount);
+	auto workload = [&](uint32_t first, uint32_t last)
+	{
+		for (uint32_t i = first; i < last; i++)
+		{
+			float value = (float)i;
+			for (int j = 0; j < 64; j++)
+				value = glm::sin(value) * 0.5f + glm::cos(value * 0.25f);
+			results[i] = value;
+		}
+	};
+
+	float serialTime = 0.0f;
+	for (uint32_t threadsCount : { 1u, 4u, 8u, 16u })
+	{
+		float time = 0.0f;
+		if (threadsCount == 1)
+		{
+			Timer timer;
+			workload(0, itemsCount);
+			time = timer.ElapsedMillis();
+		}
+		else
+		{
+			// The calling thread works too
+			JobSystem benchmarkJobSystem(threadsCount - 1);
+			Timer timer;
+			benchmarkJobSystem.ParallelFor("BenchmarkWorkload", itemsCount, 4096, workload);
+			time = timer.ElapsedMillis();
+		}
+
+		if (threadsCount == 1)
+			serialTime = time;
+		PT_INFO("Job scaling: {} threads {:.2f} ms, speedup {:.2f}x (hardware threads: {})",
+			threadsCount, time, serialTime / time, std::thread::hardware_concurrency());
+	}
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <Proton/Core/Timer.h>
 
 class MainLayer : public proton::AppLayer
 {
@@ -10,4 +11,26 @@ public:
 
 private:
 	void SpawnRandomBox(const glm::vec2& position);
+
+	// Lighting benchmark: cycles 0 -> 10 -> 100 -> 1000 point lights (key L), frame times are logged
+	void SpawnBenchmarkLights(uint32_t count);
+
+	// Iteration benchmark: toggles 10k static sprites and 1k physics boxes (key G), frame times are logged
+	void ToggleBenchmarkSprites();
+
+	// Logs the average and worst frame time of the next BenchmarkFrames frames (VSync has to be off)
+	void StartFrameSampling(const std::string& name);
+
+	// Job system benchmark: spawn overhead and parallel_for scaling on 1, 4, 8 and 16 threads (key J)
+	void RunJobSystemBenchmark();
+
+private:
+	std::vector<proton::UUID> m_BenchmarkLights;
+	std::vector<proton::UUID> m_BenchmarkSprites;
+
+	static constexpr uint32_t BenchmarkFrames = 300;
+	proton::Timer m_FrameTimer;
+	std::string m_SamplingName;
+	uint32_t m_SampledFrames = 0;
+	float m_SampledTime = 0.0f, m_WorstFrameTime = 0.0f;
 };
@@ -2,10 +2,11 @@
 // Header-only script example
 
 // Script for ScriptsAndPhysics scene
+// Touches only its own entity, updated in parallel with other instances
 class TestScript : public EntityScript
 {
 public:
-	ENTITY_SCRIPT_CLASS(TestScript)
+	ENTITY_SCRIPT_CLASS_THREAD_SAFE(TestScript)
 
 	virtual bool OnCreate() override
 	{